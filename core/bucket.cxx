@@ -22,15 +22,21 @@
 #include "core/document_id.hxx"
 #include "core/error_context/key_value_error_map_info.hxx"
 #include "core/error_context/key_value_status_code.hxx"
+#include "core/io/io_context_pool.hxx"
 #include "core/io/mcbp_message.hxx"
+#include "core/io/timing_wheel.hxx"
 #include "core/logger/logger.hxx"
 #include "core/mcbp/codec.hxx"
+#include "core/metrics/kv_operation_recorders.hxx"
 #include "core/protocol/client_opcode.hxx"
 #include "core/protocol/client_request.hxx"
 #include "core/protocol/hello_feature.hxx"
+#include "core/protocol/value_compressor.hxx"
 #include "core/response_handler.hxx"
 #include "core/service_type.hxx"
+#include "core/topology/routing_table.hxx"
 #include "core/utils/movable_function.hxx"
+#include "core/utils/rcu_cell.hxx"
 #include "dispatcher.hxx"
 #include "impl/bootstrap_state_listener.hxx"
 #include "mcbp/operation_queue.hxx"
@@ -61,6 +67,7 @@
 #include <cstdint>
 
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -87,6 +94,7 @@ public:
               std::vector<protocol::hello_feature> known_features,
               std::shared_ptr<impl::bootstrap_state_listener> state_listener,
               asio::io_context& ctx,
+              std::shared_ptr<io::io_context_pool> io_pool,
               asio::ssl::context& tls)
     : client_id_{ std::move(client_id) }
     , name_{ std::move(name) }
@@ -94,10 +102,13 @@ public:
     , origin_{ std::move(origin) }
     , tracer_{ std::move(tracer) }
     , meter_{ std::move(meter) }
+    , kv_recorders_{ meter_ }
+    , compressor_{ origin_.options().compression_min_size, origin_.options().compression_min_ratio }
     , known_features_{ std::move(known_features) }
     , state_listener_{ std::move(state_listener) }
     , codec_{ { known_features_.begin(), known_features_.end() } }
     , ctx_{ ctx }
+    , io_pool_{ std::move(io_pool) }
     , tls_{ tls }
     , heartbeat_timer_(ctx_)
     , heartbeat_interval_{ origin_.options().config_poll_floor >
@@ -113,16 +124,10 @@ public:
                         retry_reason reason,
                         std::optional<key_value_error_map_info> error_info)
   {
-    // TODO(SA): copy from mcbp_command, subject to refactor later
-    static const std::string meter_name = "db.couchbase.operations";
-    static const std::map<std::string, std::string> tags = {
-      { "db.couchbase.service", "kv" },
-      { "db.operation", fmt::format("{}", req->command_) },
-    };
-    meter_->get_value_recorder(meter_name, tags)
-      ->record_value(std::chrono::duration_cast<std::chrono::microseconds>(
-                       std::chrono::steady_clock::now() - req->dispatched_time_)
-                       .count());
+    kv_recorders_.recorder_for(req->command_)
+      .record_value(std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - req->dispatched_time_)
+                      .count());
 
     if (ec == asio::error::operation_aborted) {
       // TODO(SA): fix tracing
@@ -188,6 +193,7 @@ public:
   {
     std::shared_ptr<mcbp::queue_response> resp{};
     auto header = msg.header_data();
+    msg.join_value();
     auto [packet, size, err] =
       codec_.decode_packet(gsl::span(header.data(), header.size()), msg.body);
     if (err) {
@@ -273,6 +279,7 @@ public:
         std::optional<key_value_error_map_info> error_info) {
         std::shared_ptr<mcbp::queue_response> resp{};
         auto header = msg.header_data();
+        msg.join_value();
         auto [packet, size, err] =
           self->codec_.decode_packet(gsl::span(header.data(), header.size()), msg.body);
         if (err) {
@@ -321,40 +328,44 @@ public:
   [[nodiscard]] auto server_by_vbucket(std::uint16_t vbucket,
                                        std::size_t node_index) -> std::optional<std::size_t>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->server_by_vbucket(vbucket, node_index);
-    }
-    return {};
+    return routing_.read([vbucket, node_index](const routing_table* table) {
+      if (table == nullptr) {
+        return std::optional<std::size_t>{};
+      }
+      return table->server_by_vbucket(vbucket, node_index);
+    });
   }
 
   [[nodiscard]] auto map_id(const document_id& id)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->map_key(id.key(), id.node_index());
-    }
-    return { 0, {} };
+    return routing_.read([&id](const routing_table* table) {
+      if (table == nullptr) {
+        return std::pair<std::uint16_t, std::optional<std::size_t>>{ 0, {} };
+      }
+      return table->map_key(id.key(), id.node_index());
+    });
   }
 
   auto config_rev() const -> std::string
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->rev_str();
-    }
-    return "<no-config>";
+    return routing_.read([](const routing_table* table) -> std::string {
+      if (table == nullptr) {
+        return "<no-config>";
+      }
+      return table->rev_str();
+    });
   }
 
   [[nodiscard]] auto map_id(const std::vector<std::byte>& key, std::size_t node_index)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->map_key(key, node_index);
-    }
-    return { 0, {} };
+    return routing_.read([&key, node_index](const routing_table* table) {
+      if (table == nullptr) {
+        return std::pair<std::uint16_t, std::optional<std::size_t>>{ 0, {} };
+      }
+      return table->map_key(key, node_index);
+    });
   }
 
   void restart_sessions()
@@ -419,11 +430,13 @@ public:
       }
       const couchbase::core::origin origin(
         origin_.credentials(), hostname, port, origin_.options());
+      auto& session_ctx = io_pool_->next();
       io::mcbp_session session =
         origin_.options().enable_tls
           ? io::mcbp_session(
-              client_id_, ctx_, tls_, origin, state_listener_, name_, known_features_)
-          : io::mcbp_session(client_id_, ctx_, origin, state_listener_, name_, known_features_);
+              client_id_, session_ctx, tls_, origin, state_listener_, name_, known_features_)
+          : io::mcbp_session(
+              client_id_, session_ctx, origin, state_listener_, name_, known_features_);
       CB_LOG_DEBUG(R"({} rev={}, restart idx={}, session="{}", address="{}:{}")",
                    log_prefix_,
                    config_->rev_str(),
@@ -443,36 +456,72 @@ public:
             self->remove_session(id);
           });
           self->drain_deferred_queue();
+          self->open_extra_sessions();
         },
         true);
       sessions_.insert_or_assign(index, std::move(session));
       ++kv_node_index;
     }
+    publish_routing_table();
   }
 
   void remove_session(const std::string& id)
   {
     bool found{ false };
-    const std::scoped_lock lock(sessions_mutex_);
-    for (auto ptr = sessions_.cbegin(); ptr != sessions_.cend();) {
-      if (ptr->second.id() == id) {
-        CB_LOG_DEBUG(R"({} removed session id="{}", address="{}", bootstrap_address="{}:{}")",
-                     log_prefix_,
-                     ptr->second.id(),
-                     ptr->second.remote_address(),
-                     ptr->second.bootstrap_hostname(),
-                     ptr->second.bootstrap_port());
-        ptr = sessions_.erase(ptr);
-        found = true;
-      } else {
-        ptr = std::next(ptr);
+    std::optional<std::chrono::steady_clock::time_point> reopen_extra_at{};
+    {
+      const std::scoped_lock lock(sessions_mutex_);
+      for (auto& [address, extra] : extra_sessions_) {
+        if (auto ptr = std::find_if(extra.begin(),
+                                    extra.end(),
+                                    [&id](const auto& session) {
+                                      return session.id() == id;
+                                    });
+            ptr != extra.end()) {
+          CB_LOG_DEBUG(R"({} removed extra session id="{}", address="{}")",
+                       log_prefix_,
+                       ptr->id(),
+                       address);
+          extra.erase(ptr);
+          reopen_extra_at = std::chrono::steady_clock::now();
+          if (auto backoff = extra_sessions_backoff_.find(address);
+              backoff != extra_sessions_backoff_.end()) {
+            reopen_extra_at = backoff->second.retry_after;
+          }
+          break;
+        }
+      }
+      for (auto ptr = sessions_.cbegin(); ptr != sessions_.cend();) {
+        if (ptr->second.id() == id) {
+          CB_LOG_DEBUG(R"({} removed session id="{}", address="{}", bootstrap_address="{}:{}")",
+                       log_prefix_,
+                       ptr->second.id(),
+                       ptr->second.remote_address(),
+                       ptr->second.bootstrap_hostname(),
+                       ptr->second.bootstrap_port());
+          ptr = sessions_.erase(ptr);
+          found = true;
+        } else {
+          ptr = std::next(ptr);
+        }
       }
     }
 
     if (found) {
+      refresh_routing_table();
       asio::post(asio::bind_executor(ctx_, [self = shared_from_this()]() {
         return self->restart_sessions();
       }));
+    } else if (reopen_extra_at) {
+      refresh_routing_table();
+      auto timer = std::make_shared<asio::steady_timer>(ctx_);
+      timer->expires_at(reopen_extra_at.value());
+      timer->async_wait([self = shared_from_this(), timer](auto error) {
+        if (error == asio::error::operation_aborted) {
+          return;
+        }
+        self->open_extra_sessions();
+      });
     }
   }
 
@@ -481,10 +530,13 @@ public:
     if (state_listener_) {
       state_listener_->register_config_listener(shared_from_this());
     }
+    auto& session_ctx = io_pool_->next();
     io::mcbp_session new_session =
       origin_.options().enable_tls
-        ? io::mcbp_session(client_id_, ctx_, tls_, origin_, state_listener_, name_, known_features_)
-        : io::mcbp_session(client_id_, ctx_, origin_, state_listener_, name_, known_features_);
+        ? io::mcbp_session(
+            client_id_, session_ctx, tls_, origin_, state_listener_, name_, known_features_)
+        : io::mcbp_session(
+            client_id_, session_ctx, origin_, state_listener_, name_, known_features_);
     new_session.bootstrap([self = shared_from_this(), new_session, h = std::move(handler)](
                             std::error_code ec, topology::configuration cfg) mutable {
       if (ec) {
@@ -504,9 +556,11 @@ public:
           const std::scoped_lock lock(self->sessions_mutex_);
           self->sessions_.insert_or_assign(this_index, std::move(new_session));
         }
+        self->refresh_routing_table();
         self->update_config(cfg);
         self->drain_deferred_queue();
         self->poll_config({});
+        self->open_extra_sessions();
       }
       asio::post(
         asio::bind_executor(self->ctx_, [h = std::move(h), ec, cfg = std::move(cfg)]() mutable {
@@ -644,13 +698,21 @@ public:
     }
 
     std::map<size_t, io::mcbp_session> old_sessions;
+    std::map<std::string, std::vector<io::mcbp_session>> old_extra_sessions;
     {
       const std::scoped_lock lock(sessions_mutex_);
       std::swap(old_sessions, sessions_);
+      std::swap(old_extra_sessions, extra_sessions_);
     }
+    refresh_routing_table();
     for (auto& [index, session] : old_sessions) {
       session.stop(retry_reason::do_not_retry);
     }
+    for (auto& [address, extra] : old_extra_sessions) {
+      for (auto& session : extra) {
+        session.stop(retry_reason::do_not_retry);
+      }
+    }
   }
 
   /**
@@ -794,11 +856,13 @@ public:
 
         const couchbase::core::origin origin(
           origin_.credentials(), hostname, port, origin_.options());
+        auto& session_ctx = io_pool_->next();
         io::mcbp_session session =
           origin_.options().enable_tls
             ? io::mcbp_session(
-                client_id_, ctx_, tls_, origin, state_listener_, name_, known_features_)
-            : io::mcbp_session(client_id_, ctx_, origin, state_listener_, name_, known_features_);
+                client_id_, session_ctx, tls_, origin, state_listener_, name_, known_features_)
+            : io::mcbp_session(
+                client_id_, session_ctx, origin, state_listener_, name_, known_features_);
         CB_LOG_DEBUG(R"({} rev={}, add session="{}", address="{}:{}", index={})",
                      log_prefix_,
                      config.rev_str(),
@@ -826,12 +890,14 @@ public:
               self->remove_session(id);
             });
             self->drain_deferred_queue();
+            self->open_extra_sessions();
           },
           true);
         new_sessions.insert_or_assign(next_index, std::move(session));
         ++next_index;
       }
       std::swap(sessions_, new_sessions);
+      drop_stale_extra_sessions();
 
       for (auto it = new_sessions.begin(); it != new_sessions.end(); ++it) {
         CB_LOG_DEBUG(R"({} rev={}, drop session="{}", address="{}:{}", index={})",
@@ -846,29 +912,179 @@ public:
         }));
       }
     }
+    refresh_routing_table();
   }
 
+  /**
+   * Returns the connection to the node, that has the least outstanding bytes. The connections,
+   * which are not ready yet, are used only when the node does not have any other.
+   */
   [[nodiscard]] auto find_session_by_index(std::size_t index) const
     -> std::optional<io::mcbp_session>
+  {
+    return routing_.read([index](const routing_table* table) -> std::optional<io::mcbp_session> {
+      if (table == nullptr) {
+        return {};
+      }
+      return table->select_session(index, [](const io::mcbp_session& session) {
+        if (!session.is_bootstrapped() || session.is_stopped()) {
+          return std::numeric_limits<std::size_t>::max();
+        }
+        return session.outstanding_bytes();
+      });
+    });
+  }
+
+  [[nodiscard]] auto find_sessions_by_index(std::size_t index) const
+    -> std::vector<io::mcbp_session>
+  {
+    return routing_.read([index](const routing_table* table) -> std::vector<io::mcbp_session> {
+      if (table == nullptr) {
+        return {};
+      }
+      return table->find_sessions(index);
+    });
+  }
+
+  /**
+   * Opens additional connections to every bootstrapped node, until each of them has
+   * num_kv_connections. Extra connections do not subscribe to configuration updates, the first
+   * connection of the node takes care of it.
+   */
+  void open_extra_sessions()
+  {
+    const auto number_of_connections = origin_.options().num_kv_connections;
+    if (closed_ || number_of_connections <= 1) {
+      return;
+    }
+    {
+      const std::scoped_lock lock(sessions_mutex_);
+      for (const auto& [index, primary] : sessions_) {
+        if (!primary.is_bootstrapped() || primary.is_stopped()) {
+          continue;
+        }
+        if (auto backoff = extra_sessions_backoff_.find(primary.bootstrap_address());
+            backoff != extra_sessions_backoff_.end() &&
+            backoff->second.retry_after > std::chrono::steady_clock::now()) {
+          continue;
+        }
+        auto& extra = extra_sessions_[primary.bootstrap_address()];
+        while (extra.size() + 1 < number_of_connections) {
+          const couchbase::core::origin origin(origin_.credentials(),
+                                               primary.bootstrap_hostname(),
+                                               primary.bootstrap_port_number(),
+                                               origin_.options());
+          auto& session_ctx = io_pool_->next();
+          io::mcbp_session session =
+            origin_.options().enable_tls
+              ? io::mcbp_session(
+                  client_id_, session_ctx, tls_, origin, state_listener_, name_, known_features_)
+              : io::mcbp_session(
+                  client_id_, session_ctx, origin, state_listener_, name_, known_features_);
+          CB_LOG_DEBUG(R"({} add extra session="{}", address="{}", index={}, connections={})",
+                       log_prefix_,
+                       session.id(),
+                       primary.bootstrap_address(),
+                       index,
+                       extra.size() + 2);
+          session.bootstrap(
+            [self = shared_from_this(), session, address = primary.bootstrap_address()](
+              std::error_code err, topology::configuration /* cfg */) mutable {
+              self->update_extra_sessions_backoff(address, !err);
+              if (err) {
+                return self->remove_session(session.id());
+              }
+              session.on_stop([id = session.id(), self]() {
+                self->remove_session(id);
+              });
+              self->refresh_routing_table();
+            },
+            true);
+          extra.emplace_back(std::move(session));
+        }
+      }
+    }
+    refresh_routing_table();
+  }
+
+  /**
+   * Every consecutive failure to bootstrap an extra connection to the node doubles the delay
+   * before the next one is opened, so that an unreachable node does not cause a reconnect loop.
+   */
+  void update_extra_sessions_backoff(const std::string& address, bool bootstrapped)
   {
     const std::scoped_lock lock(sessions_mutex_);
-    if (auto ptr = sessions_.find(index); ptr != sessions_.end()) {
-      return ptr->second;
+    if (bootstrapped) {
+      extra_sessions_backoff_.erase(address);
+      return;
+    }
+    auto& backoff = extra_sessions_backoff_[address];
+    const auto delay = std::min(extra_sessions_min_backoff * (1U << std::min(backoff.failures, 10U)),
+                                extra_sessions_max_backoff);
+    ++backoff.failures;
+    backoff.retry_after = std::chrono::steady_clock::now() + delay;
+    CB_LOG_DEBUG(R"({} failed to bootstrap extra session, address="{}", failures={}, retry in {})",
+                 log_prefix_,
+                 address,
+                 backoff.failures,
+                 delay);
+  }
+
+  /**
+   * Stops extra connections of the nodes, that are not in sessions_ anymore. sessions_mutex_ must
+   * be held.
+   */
+  void drop_stale_extra_sessions()
+  {
+    for (auto it = extra_sessions_.begin(); it != extra_sessions_.end();) {
+      const auto& address = it->first;
+      if (std::any_of(sessions_.begin(), sessions_.end(), [&address](const auto& entry) {
+            return entry.second.bootstrap_address() == address;
+          })) {
+        ++it;
+        continue;
+      }
+      for (auto& session : it->second) {
+        CB_LOG_DEBUG(R"({} drop extra session="{}", address="{}")",
+                     log_prefix_,
+                     session.id(),
+                     address);
+        asio::post(asio::bind_executor(ctx_, [session = std::move(session)]() mutable {
+          return session.stop(retry_reason::do_not_retry);
+        }));
+      }
+      extra_sessions_backoff_.erase(address);
+      it = extra_sessions_.erase(it);
     }
-    return {};
   }
 
   [[nodiscard]] auto next_session_index() -> std::size_t
   {
-    const std::scoped_lock lock(sessions_mutex_);
+    const auto number_of_sessions = routing_.read([](const routing_table* table) -> std::size_t {
+      return table == nullptr ? 0 : table->number_of_sessions();
+    });
 
-    if (auto index = round_robin_next_.fetch_add(1); index < sessions_.size()) {
+    if (auto index = round_robin_next_.fetch_add(1); index < number_of_sessions) {
       return index;
     }
     round_robin_next_ = 0;
     return 0;
   }
 
+  [[nodiscard]] auto next_command_id() -> std::uint64_t
+  {
+    return command_id_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * The commands are spread across the IO contexts of the pool, so that their completion does not
+   * run on a single thread.
+   */
+  [[nodiscard]] auto next_timing_wheel() -> io::timing_wheel&
+  {
+    return io_pool_->next_timing_wheel();
+  }
+
   [[nodiscard]] auto default_timeout() const -> std::chrono::milliseconds
   {
     return origin_.options().default_timeout_for(service_type::key_value);
@@ -904,15 +1120,36 @@ public:
     return meter_;
   }
 
+  [[nodiscard]] auto operation_recorder(protocol::client_opcode opcode)
+    -> couchbase::metrics::value_recorder&
+  {
+    return kv_recorders_.recorder_for(opcode);
+  }
+
+  [[nodiscard]] auto compressor() -> protocol::value_compressor&
+  {
+    return compressor_;
+  }
+
   void export_diag_info(diag::diagnostics_result& res) const
   {
-    std::map<size_t, io::mcbp_session> sessions;
+    std::vector<io::mcbp_session> sessions;
     {
       const std::scoped_lock lock(sessions_mutex_);
-      sessions = sessions_;
+      for (const auto& [index, session] : sessions_) {
+        sessions.emplace_back(session);
+      }
+      for (const auto& [address, extra] : extra_sessions_) {
+        sessions.insert(sessions.end(), extra.begin(), extra.end());
+      }
     }
-    for (const auto& [index, session] : sessions) {
-      res.services[service_type::key_value].emplace_back(session.diag_info());
+    // compression counters are collected per bucket, and reported with each of its KV endpoints
+    const auto compression = protocol::to_string(compressor_.stats());
+    for (const auto& session : sessions) {
+      auto info = session.diag_info();
+      info.details = info.details ? fmt::format("{}, {}", info.details.value(), compression)
+                                  : compression;
+      res.services[service_type::key_value].emplace_back(std::move(info));
     }
   }
 
@@ -948,17 +1185,46 @@ public:
   }
 
 private:
+  using routing_table = topology::routing_table<io::mcbp_session>;
+
+  /**
+   * Publishes new routing snapshot for the operations. Both config_mutex_ and sessions_mutex_ must
+   * be held, so that concurrent updates cannot publish their snapshots out of order.
+   */
+  void publish_routing_table()
+  {
+    std::map<std::size_t, std::vector<io::mcbp_session>> extra_sessions{};
+    if (!extra_sessions_.empty()) {
+      for (const auto& [index, session] : sessions_) {
+        if (auto extra = extra_sessions_.find(session.bootstrap_address());
+            extra != extra_sessions_.end()) {
+          extra_sessions.try_emplace(index, extra->second);
+        }
+      }
+    }
+    routing_.publish(std::make_unique<const routing_table>(config_, sessions_, extra_sessions));
+  }
+
+  void refresh_routing_table()
+  {
+    const std::scoped_lock lock(config_mutex_, sessions_mutex_);
+    publish_routing_table();
+  }
+
   const std::string client_id_;
   const std::string name_;
   const std::string log_prefix_;
   const origin origin_;
   const std::shared_ptr<couchbase::tracing::request_tracer> tracer_;
   const std::shared_ptr<couchbase::metrics::meter> meter_;
+  metrics::kv_operation_recorders kv_recorders_;
+  protocol::value_compressor compressor_;
   const std::vector<protocol::hello_feature> known_features_;
   const std::shared_ptr<impl::bootstrap_state_listener> state_listener_;
   mcbp::codec codec_;
 
   asio::io_context& ctx_;
+  std::shared_ptr<io::io_context_pool> io_pool_;
   asio::ssl::context& tls_;
 
   asio::steady_timer heartbeat_timer_;
@@ -978,12 +1244,26 @@ private:
   std::mutex deferred_commands_mutex_{};
 
   std::map<size_t, io::mcbp_session> sessions_{};
+  // additional connections to the nodes (num_kv_connections > 1), keyed by the node address
+  std::map<std::string, std::vector<io::mcbp_session>> extra_sessions_{};
+  struct extra_sessions_backoff {
+    unsigned int failures{ 0 };
+    std::chrono::steady_clock::time_point retry_after{};
+  };
+  static constexpr std::chrono::milliseconds extra_sessions_min_backoff{ 100 };
+  static constexpr std::chrono::milliseconds extra_sessions_max_backoff{ 30'000 };
+  // nodes, where the extra connections have failed to bootstrap, keyed by the node address
+  std::map<std::string, extra_sessions_backoff> extra_sessions_backoff_{};
   mutable std::mutex sessions_mutex_{};
+  // snapshot of config_, sessions_ and extra_sessions_ used to route operations without locking
+  utils::rcu_cell<routing_table> routing_{};
   std::atomic_size_t round_robin_next_{ 0 };
+  std::atomic_uint64_t command_id_{ 0 };
 };
 
 bucket::bucket(std::string client_id,
                asio::io_context& ctx,
+               std::shared_ptr<io::io_context_pool> io_pool,
                asio::ssl::context& tls,
                std::shared_ptr<couchbase::tracing::request_tracer> tracer,
                std::shared_ptr<couchbase::metrics::meter> meter,
@@ -1001,6 +1281,7 @@ bucket::bucket(std::string client_id,
                                          std::move(known_features),
                                          std::move(state_listener),
                                          ctx,
+                                         std::move(io_pool),
                                          tls) }
 {
 }
@@ -1065,6 +1346,19 @@ bucket::meter() const -> std::shared_ptr<couchbase::metrics::meter>
   return impl_->meter();
 }
 
+auto
+bucket::operation_recorder(protocol::client_opcode opcode) const
+  -> couchbase::metrics::value_recorder&
+{
+  return impl_->operation_recorder(opcode);
+}
+
+auto
+bucket::compressor() const -> protocol::value_compressor&
+{
+  return impl_->compressor();
+}
+
 auto
 bucket::default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>
 {
@@ -1114,18 +1408,36 @@ bucket::default_timeout() const -> std::chrono::milliseconds
   return impl_->default_timeout();
 }
 
+auto
+bucket::next_timing_wheel() -> io::timing_wheel&
+{
+  return impl_->next_timing_wheel();
+}
+
 auto
 bucket::find_session_by_index(std::size_t index) const -> std::optional<io::mcbp_session>
 {
   return impl_->find_session_by_index(index);
 }
 
+auto
+bucket::find_sessions_by_index(std::size_t index) const -> std::vector<io::mcbp_session>
+{
+  return impl_->find_sessions_by_index(index);
+}
+
 auto
 bucket::next_session_index() -> std::size_t
 {
   return impl_->next_session_index();
 }
 
+auto
+bucket::next_command_id() -> std::uint64_t
+{
+  return impl_->next_command_id();
+}
+
 auto
 bucket::map_id(const document_id& id) -> std::pair<std::uint16_t, std::optional<std::size_t>>
 {
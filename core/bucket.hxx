@@ -26,7 +26,10 @@
 #include <asio/post.hpp>
 #include <asio/ssl.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <limits>
+#include <map>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -56,6 +59,10 @@ namespace impl
 {
 class bootstrap_state_listener;
 } // namespace impl
+namespace io
+{
+class io_context_pool;
+} // namespace io
 
 class bucket_impl;
 struct origin;
@@ -67,6 +74,7 @@ class bucket
 public:
   bucket(std::string client_id,
          asio::io_context& ctx,
+         std::shared_ptr<io::io_context_pool> io_pool,
          asio::ssl::context& tls,
          std::shared_ptr<couchbase::tracing::request_tracer> tracer,
          std::shared_ptr<couchbase::metrics::meter> meter,
@@ -82,8 +90,101 @@ public:
     if (is_closed()) {
       return;
     }
+    auto cmd = make_command(std::move(request), std::forward<Handler>(handler));
+    if (is_configured()) {
+      return map_and_send(cmd);
+    }
+    return defer_command([self = shared_from_this(), cmd]() {
+      self->map_and_send(cmd);
+    });
+  }
+
+  /**
+   * Executes the requests as one batch, and invokes the handler once with the responses in the
+   * order of the requests.
+   *
+   * The requests are grouped by the node owning their vbuckets, and every group is written to its
+   * session at once, so that it leaves in a single write instead of one write per request.
+   */
+  template<typename Request, typename Handler>
+  void execute_batch(std::vector<Request> requests, Handler&& handler)
+  {
+    using response_type = typename Request::response_type;
+    using command_type = operations::mcbp_command<bucket, Request>;
+
+    if (is_closed()) {
+      return;
+    }
+    if (requests.empty()) {
+      return handler(std::vector<response_type>{});
+    }
+
+    struct batch_state {
+      batch_state(std::size_t size, std::decay_t<Handler> handler)
+        : responses(size)
+        , pending{ size }
+        , handler{ std::move(handler) }
+      {
+      }
+
+      std::vector<response_type> responses;
+      std::atomic_size_t pending;
+      std::decay_t<Handler> handler;
+    };
+    auto batch = std::make_shared<batch_state>(requests.size(), std::forward<Handler>(handler));
+
+    std::vector<std::shared_ptr<command_type>> commands{};
+    commands.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+      commands.emplace_back(
+        make_command(std::move(requests[i]), [batch, i](response_type&& resp) mutable {
+          batch->responses[i] = std::move(resp);
+          if (batch->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            batch->handler(std::move(batch->responses));
+          }
+        }));
+    }
+
+    if (!is_configured()) {
+      return defer_command([self = shared_from_this(), commands = std::move(commands)]() {
+        self->map_and_send_batch(commands);
+      });
+    }
+    map_and_send_batch(commands);
+  }
+
+  template<typename Request>
+  void map_and_send_batch(
+    const std::vector<std::shared_ptr<operations::mcbp_command<bucket, Request>>>& commands)
+  {
+    std::map<std::size_t, std::vector<std::shared_ptr<operations::mcbp_command<bucket, Request>>>>
+      groups{};
+    for (const auto& cmd : commands) {
+      auto server = map_id(cmd->request.id).second;
+      // commands that cannot be mapped yet are left to the retry logic of map_and_send()
+      groups[server.value_or(std::numeric_limits<std::size_t>::max())].push_back(cmd);
+    }
+    for (const auto& [index, group] : groups) {
+      // the commands are spread over all connections of the node
+      auto sessions = find_sessions_by_index(index);
+      for (auto& session : sessions) {
+        session.cork();
+      }
+      for (const auto& cmd : group) {
+        map_and_send(cmd);
+      }
+      for (auto& session : sessions) {
+        session.uncork();
+      }
+    }
+  }
+
+  template<typename Request, typename Handler>
+  auto make_command(Request request, Handler&& handler)
+    -> std::shared_ptr<operations::mcbp_command<bucket, Request>>
+  {
     auto cmd = std::make_shared<operations::mcbp_command<bucket, Request>>(
-      ctx_, shared_from_this(), request, default_timeout());
+      next_timing_wheel(), shared_from_this(), std::move(request), default_timeout());
     cmd->start([cmd, handler = std::forward<Handler>(handler)](
                  std::error_code ec, std::optional<io::mcbp_message>&& msg) mutable {
       using encoded_response_type = typename Request::encoded_response_type;
@@ -92,12 +193,7 @@ public:
       auto ctx = make_key_value_error_context(ec, status_code, cmd, resp);
       handler(cmd->request.make_response(std::move(ctx), std::move(resp)));
     });
-    if (is_configured()) {
-      return map_and_send(cmd);
-    }
-    return defer_command([self = shared_from_this(), cmd]() {
-      self->map_and_send(cmd);
-    });
+    return cmd;
   }
 
   template<typename Request>
@@ -115,7 +211,7 @@ public:
         CB_LOG_TRACE(R"([{}] unable to map key="{}" to the node, id={}, partition={}, rev={})",
                      log_prefix(),
                      cmd->request.id,
-                     cmd->id_,
+                     cmd->id(),
                      partition,
                      config_rev());
         return io::retry_orchestrator::maybe_retry(
@@ -129,7 +225,7 @@ public:
       CB_LOG_TRACE(
         R"([{}] defer operation id="{}", key="{}", partition={}, index={}, session={}, address="{}", has_config={}, rev={})",
         log_prefix(),
-        cmd->id_,
+        cmd->id(),
         cmd->request.id,
         cmd->request.partition,
         index,
@@ -146,7 +242,7 @@ public:
         R"([{}] the session has been found for idx={}, but it is stopped, retrying id={}, key="{}", partition={}, session={}, address="{}", rev={})",
         log_prefix(),
         index,
-        cmd->id_,
+        cmd->id(),
         cmd->request.id,
         cmd->request.partition,
         session->id(),
@@ -160,7 +256,7 @@ public:
     CB_LOG_TRACE(
       R"({} send operation id="{}", key="{}", partition={}, index={}, address="{}", rev={})",
       session->log_prefix(),
-      cmd->id_,
+      cmd->id(),
       cmd->request.id,
       cmd->request.partition,
       index,
@@ -176,13 +272,9 @@ public:
     if (is_closed()) {
       return cmd->cancel(retry_reason::do_not_retry);
     }
+    using command_type = operations::mcbp_command<bucket, Request>;
     cmd->retry_backoff.expires_after(duration);
-    cmd->retry_backoff.async_wait([self = shared_from_this(), cmd](std::error_code ec) mutable {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->map_and_send(cmd);
-    });
+    cmd->retry_backoff.template async_wait<&command_type::on_retry_backoff>(std::move(cmd));
   }
 
   void fetch_config();
@@ -202,9 +294,13 @@ public:
   [[nodiscard]] auto log_prefix() const -> const std::string&;
   [[nodiscard]] auto tracer() const -> std::shared_ptr<couchbase::tracing::request_tracer>;
   [[nodiscard]] auto meter() const -> std::shared_ptr<couchbase::metrics::meter>;
+  [[nodiscard]] auto operation_recorder(protocol::client_opcode opcode) const
+    -> couchbase::metrics::value_recorder&;
+  [[nodiscard]] auto compressor() const -> protocol::value_compressor&;
   [[nodiscard]] auto default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>;
   [[nodiscard]] auto is_closed() const -> bool;
   [[nodiscard]] auto is_configured() const -> bool;
+  [[nodiscard]] auto next_command_id() -> std::uint64_t;
 
   auto direct_dispatch(std::shared_ptr<mcbp::queue_request> req) -> std::error_code;
   auto direct_re_queue(const std::shared_ptr<mcbp::queue_request>& req,
@@ -212,9 +308,12 @@ public:
 
 private:
   [[nodiscard]] auto default_timeout() const -> std::chrono::milliseconds;
+  [[nodiscard]] auto next_timing_wheel() -> io::timing_wheel&;
   [[nodiscard]] auto next_session_index() -> std::size_t;
   [[nodiscard]] auto find_session_by_index(std::size_t index) const
     -> std::optional<io::mcbp_session>;
+  [[nodiscard]] auto find_sessions_by_index(std::size_t index) const
+    -> std::vector<io::mcbp_session>;
   [[nodiscard]] auto map_id(const document_id& id)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>;
   [[nodiscard]] auto config_rev() const -> std::string;
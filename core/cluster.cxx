@@ -32,7 +32,9 @@
 #include "core/io/http_command.hxx"
 #include "core/io/http_message.hxx"
 #include "core/io/http_session_manager.hxx"
+#include "core/io/io_context_pool.hxx"
 #include "core/io/mcbp_session.hxx"
+#include "core/io/tls_session_cache.hxx"
 #include "core/logger/logger.hxx"
 #include "core/management/analytics_link_azure_blob_external.hxx"
 #include "core/management/analytics_link_couchbase_remote.hxx"
@@ -148,6 +150,7 @@
 #include "core/tracing/threshold_logging_tracer.hxx"
 #include "core/utils/join_strings.hxx"
 #include "core/utils/movable_function.hxx"
+#include "core/utils/rcu_cell.hxx"
 #include "crud_component.hxx"
 #include "dispatcher.hxx"
 #include "impl/dns_srv_tracker.hxx"
@@ -278,6 +281,7 @@ public:
   explicit cluster_impl(asio::io_context& ctx)
     : ctx_(ctx)
     , work_(asio::make_work_guard(ctx_))
+    , io_pool_(std::make_shared<io::io_context_pool>(ctx_))
     , session_manager_(std::make_shared<io::http_session_manager>(id_, ctx_, tls_))
     , retry_backoff_(ctx_)
   {
@@ -286,6 +290,7 @@ public:
   explicit cluster_impl(asio::io_context& ctx)
     : ctx_(ctx)
     , work_(asio::make_work_guard(ctx_))
+    , io_pool_(std::make_shared<io::io_context_pool>(ctx_))
     , session_manager_(std::make_shared<io::http_session_manager>(id_, ctx_, tls_))
   {
   }
@@ -320,6 +325,9 @@ public:
         tls_.set_verify_mode(asio::ssl::verify_peer);
         break;
     }
+    if (origin_.options().tls_session_resumption) {
+      tls_sessions_.attach(tls_);
+    }
 
 #ifdef COUCHBASE_CXX_CLIENT_TLS_KEY_LOG_FILE
     SSL_CTX_set_keylog_callback(tls_.native_handle(), [](const SSL* /* ssl */, const char* line) {
@@ -348,6 +356,8 @@ public:
     }
 
     origin_ = std::move(origin);
+    io_pool_->start(origin_.options().io_threads);
+    session_manager_->set_io_context_pool(io_pool_);
     CB_LOG_DEBUG(R"(open cluster, id: "{}", core version: "{}", {})",
                  id_,
                  couchbase::core::meta::sdk_semver(),
@@ -376,6 +386,7 @@ public:
     }
     meter_->start();
     session_manager_->set_tracer(tracer_);
+    session_manager_->configure_query_cache(origin_.options().query_cache_capacity, meter_);
     if (origin_.options().enable_dns_srv) {
       std::string hostname;
       std::string port;
@@ -429,6 +440,8 @@ public:
     }
 
     origin_ = std::move(origin);
+    io_pool_->start(origin_.options().io_threads);
+    session_manager_->set_io_context_pool(io_pool_);
     CB_LOG_DEBUG(R"(open cluster in background, id: "{}", core version: "{}", {})",
                  id_,
                  couchbase::core::meta::sdk_semver(),
@@ -457,6 +470,7 @@ public:
     }
     meter_->start();
     session_manager_->set_tracer(tracer_);
+    session_manager_->configure_query_cache(origin_.options().query_cache_capacity, meter_);
     session_manager_->set_dispatch_timeout(origin_.options().dispatch_timeout);
     // at this point we will infinitely try to connect
     if (origin_.options().enable_dns_srv) {
@@ -490,9 +504,18 @@ public:
           }
         }
 
-        b = std::make_shared<bucket>(
-          id_, ctx_, tls_, tracer_, meter_, bucket_name, origin, known_features, dns_srv_tracker_);
+        b = std::make_shared<bucket>(id_,
+                                     ctx_,
+                                     io_pool_,
+                                     tls_,
+                                     tracer_,
+                                     meter_,
+                                     bucket_name,
+                                     origin,
+                                     known_features,
+                                     dns_srv_tracker_);
         buckets_.try_emplace(bucket_name, b);
+        publish_buckets();
       }
     }
     if (b == nullptr) {
@@ -505,6 +528,7 @@ public:
       if (ec) {
         const std::scoped_lock lock(self->buckets_mutex_);
         self->buckets_.erase(bucket_name);
+        self->publish_buckets();
       } else if (self->session_ && !self->session_->supports_gcccp()) {
         self->session_manager_->set_configuration(config, self->origin_.options());
       }
@@ -525,6 +549,7 @@ public:
       if (auto ptr = buckets_.find(bucket_name); ptr != buckets_.end()) {
         b = std::move(ptr->second);
         buckets_.erase(ptr);
+        publish_buckets();
       }
     }
     if (b != nullptr) {
@@ -573,6 +598,49 @@ public:
                        });
   }
 
+  template<class Request>
+  static auto make_batch_error_responses(std::vector<Request>& requests, std::error_code ec)
+    -> std::vector<typename Request::response_type>
+  {
+    std::vector<typename Request::response_type> responses{};
+    responses.reserve(requests.size());
+    for (auto& request : requests) {
+      responses.emplace_back(request.make_response(make_key_value_error_context(ec, request.id),
+                                                   typename Request::encoded_response_type{}));
+    }
+    return responses;
+  }
+
+  /**
+   * All requests of the batch must belong to the same bucket.
+   */
+  template<class Request, class Handler>
+  void execute_batch(std::vector<Request> requests, Handler&& handler)
+  {
+    if (requests.empty()) {
+      return handler(std::vector<typename Request::response_type>{});
+    }
+    if (stopped_) {
+      return handler(make_batch_error_responses(requests, errc::network::cluster_closed));
+    }
+    auto bucket_name = requests.front().id.bucket();
+    if (auto bucket = find_bucket_by_name(bucket_name); bucket != nullptr) {
+      return bucket->execute_batch(std::move(requests), std::forward<Handler>(handler));
+    }
+    if (bucket_name.empty()) {
+      return handler(make_batch_error_responses(requests, errc::common::bucket_not_found));
+    }
+    return open_bucket(bucket_name,
+                       [self = shared_from_this(),
+                        requests = std::move(requests),
+                        handler = std::forward<Handler>(handler)](std::error_code ec) mutable {
+                         if (ec) {
+                           return handler(make_batch_error_responses(requests, ec));
+                         }
+                         return self->execute_batch(std::move(requests), std::move(handler));
+                       });
+  }
+
   template<class Request,
            class Handler,
            typename std::enable_if_t<
@@ -636,24 +704,31 @@ public:
 
   auto find_bucket_by_name(const std::string& name) -> std::shared_ptr<bucket>
   {
-    const std::scoped_lock lock(buckets_mutex_);
-
-    auto bucket = buckets_.find(name);
-    if (bucket == buckets_.end()) {
-      return {};
-    }
-    return bucket->second;
+    return buckets_snapshot_.read([&name](const bucket_map* buckets) -> std::shared_ptr<bucket> {
+      if (buckets == nullptr) {
+        return {};
+      }
+      auto bucket = buckets->find(name);
+      if (bucket == buckets->end()) {
+        return {};
+      }
+      return bucket->second;
+    });
   }
 
   void for_each_bucket(utils::movable_function<void(std::shared_ptr<bucket>)> handler)
   {
     std::vector<std::shared_ptr<bucket>> buckets{};
     {
-      const std::scoped_lock lock(buckets_mutex_);
-      buckets.reserve(buckets_.size());
-      for (const auto& [name, bucket] : buckets_) {
-        buckets.push_back(bucket);
-      }
+      buckets_snapshot_.read([&buckets](const bucket_map* snapshot) {
+        if (snapshot == nullptr) {
+          return;
+        }
+        buckets.reserve(snapshot->size());
+        for (const auto& [name, bucket] : *snapshot) {
+          buckets.push_back(bucket);
+        }
+      });
     }
     for (const auto& bucket : buckets) {
       handler(bucket);
@@ -1121,6 +1196,18 @@ public:
           bucket->export_diag_info(res);
         });
         self->session_manager_->export_diag_info(res);
+        if (io::tls_session_cache::from(self->tls_) != nullptr) {
+          // the sessions are shared by all TLS connections, so the counters are reported with each
+          // of the endpoints
+          const auto tls_sessions = io::to_string(self->tls_sessions_.stats());
+          for (auto& [type, endpoints] : res.services) {
+            for (auto& info : endpoints) {
+              info.details = info.details
+                               ? fmt::format("{}, {}", info.details.value(), tls_sessions)
+                               : tls_sessions;
+            }
+          }
+        }
         handler(std::move(res));
       }));
   }
@@ -1149,6 +1236,7 @@ public:
           bucket->close();
         });
         self->session_manager_->close();
+        self->io_pool_->stop();
         self->work_.reset();
         if (self->tracer_) {
           self->tracer_->stop();
@@ -1221,15 +1309,30 @@ public:
   }
 
 private:
+  using bucket_map = std::map<std::string, std::shared_ptr<bucket>>;
+
+  /**
+   * Must be called with buckets_mutex_ held.
+   */
+  void publish_buckets()
+  {
+    buckets_snapshot_.publish(std::make_unique<const bucket_map>(buckets_));
+  }
+
   std::string id_{ uuid::to_string(uuid::random()) };
   asio::io_context& ctx_;
   asio::executor_work_guard<asio::io_context::executor_type> work_;
+  std::shared_ptr<io::io_context_pool> io_pool_;
   asio::ssl::context tls_{ asio::ssl::context::tls_client };
+  // declared after tls_, so that the cache detaches from the context before it is destroyed
+  io::tls_session_cache tls_sessions_{};
   std::shared_ptr<io::http_session_manager> session_manager_;
   std::optional<io::mcbp_session> session_{};
   std::shared_ptr<impl::dns_srv_tracker> dns_srv_tracker_{};
   std::mutex buckets_mutex_{};
-  std::map<std::string, std::shared_ptr<bucket>> buckets_{};
+  bucket_map buckets_{};
+  // copy of buckets_ for the lookups on the request path, republished under buckets_mutex_
+  utils::rcu_cell<bucket_map> buckets_snapshot_{};
   couchbase::core::origin origin_{};
   std::shared_ptr<couchbase::tracing::request_tracer> tracer_{ nullptr };
   std::shared_ptr<couchbase::metrics::meter> meter_{ nullptr };
@@ -1550,6 +1653,30 @@ cluster::execute(operations::upsert_request request,
   return impl_->execute(std::move(request), std::move(handler));
 }
 
+void
+cluster::execute(
+  std::vector<operations::get_request> requests,
+  utils::movable_function<void(std::vector<operations::get_response>)>&& handler) const
+{
+  return impl_->execute_batch(std::move(requests), std::move(handler));
+}
+
+void
+cluster::execute(
+  std::vector<operations::remove_request> requests,
+  utils::movable_function<void(std::vector<operations::remove_response>)>&& handler) const
+{
+  return impl_->execute_batch(std::move(requests), std::move(handler));
+}
+
+void
+cluster::execute(
+  std::vector<operations::upsert_request> requests,
+  utils::movable_function<void(std::vector<operations::upsert_response>)>&& handler) const
+{
+  return impl_->execute_batch(std::move(requests), std::move(handler));
+}
+
 void
 cluster::execute(operations::document_view_request request,
                  utils::movable_function<void(operations::document_view_response)>&& handler) const
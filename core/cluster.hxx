@@ -27,6 +27,7 @@
 #include <chrono>
 #include <optional>
 #include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -128,6 +129,14 @@ public:
   void execute(o::replace_request_with_legacy_durability request,
                mf<void(o::replace_response)>&& handler) const;
 
+  // batches of KV requests for a single bucket, responses are passed in the order of requests
+  void execute(std::vector<o::get_request> requests,
+               mf<void(std::vector<o::get_response>)>&& handler) const;
+  void execute(std::vector<o::remove_request> requests,
+               mf<void(std::vector<o::remove_response>)>&& handler) const;
+  void execute(std::vector<o::upsert_request> requests,
+               mf<void(std::vector<o::upsert_response>)>&& handler) const;
+
   void execute(o::document_view_request request,
                mf<void(o::document_view_response)>&& handler) const;
   void execute(o::http_noop_request request, mf<void(o::http_noop_response)>&& handler) const;
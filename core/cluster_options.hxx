@@ -20,7 +20,9 @@
 #include "core/columnar/security_options.hxx"
 #include "core/io/dns_config.hxx"
 #include "core/io/ip_protocol.hxx"
+#include "core/io/query_cache.hxx"
 #include "core/metrics/logging_meter_options.hxx"
+#include "core/protocol/value_compressor.hxx"
 #include "core/tracing/threshold_logging_options.hxx"
 #include "service_type.hxx"
 #include "timeout_defaults.hxx"
@@ -58,6 +60,7 @@ public:
   bool enable_tls{ false };
   bool tls_disable_deprecated_protocols{ true };
   bool tls_disable_v1_2{ false };
+  bool tls_session_resumption{ true };
   std::string trust_certificate{};
   std::string trust_certificate_value{};
   bool enable_mutation_tokens{ true };
@@ -66,9 +69,12 @@ public:
   bool enable_dns_srv{ true };
   io::dns::dns_config dns_config{ io::dns::dns_config::system_config() };
   bool show_queries{ false };
+  std::size_t query_cache_capacity{ query_cache::default_capacity };
   bool enable_unordered_execution{ true };
   bool enable_clustermap_notification{ true };
   bool enable_compression{ true };
+  std::size_t compression_min_size{ protocol::value_compressor::default_min_size };
+  double compression_min_ratio{ protocol::value_compressor::default_min_ratio };
   bool enable_tracing{ true };
   bool enable_metrics{ true };
   std::string network{ "auto" };
@@ -86,6 +92,11 @@ public:
     timeout_defaults::config_idle_redial_timeout;
 
   std::size_t max_http_connections{ 0 };
+  std::size_t max_key_value_read_buffer_size{ 256 * 1024 };
+  std::chrono::microseconds key_value_write_coalescing_delay{ 0 };
+  std::size_t key_value_write_coalescing_threshold{ 64 * 1024 };
+  std::size_t num_kv_connections{ 1 };
+  std::size_t io_threads{ 1 };
   std::chrono::milliseconds idle_http_connection_timeout =
     timeout_defaults::idle_http_connection_timeout;
   std::string user_agent_extra{};
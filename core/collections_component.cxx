@@ -20,6 +20,7 @@
 #include "collection_id_cache_entry.hxx"
 #include "collections_component_unit_test_api.hxx"
 #include "core/collections_options.hxx"
+#include "core/io/timing_wheel.hxx"
 #include "core/logger/logger.hxx"
 #include "core/mcbp/big_endian.hxx"
 #include "core/pending_operation.hxx"
@@ -160,6 +161,7 @@ public:
                              dispatcher dispatcher,
                              const collections_component_options& options)
     : io_{ io }
+    , timing_wheel_{ asio::use_service<io::timing_wheel>(io) }
     , dispatcher_(std::move(dispatcher))
     , max_queue_size_{ options.max_queue_size }
     , default_retry_strategy_{ options.default_retry_strategy }
@@ -284,15 +286,7 @@ public:
     }
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
-      timer->expires_after(options.timeout);
-      timer->async_wait([req](auto error) {
-        if (error == asio::error::operation_aborted) {
-          return;
-        }
-        req->cancel(errc::common::unambiguous_timeout);
-      });
-      req->set_deadline(timer);
+      req->set_deadline(timing_wheel_, options.timeout);
     }
 
     return req;
@@ -333,6 +327,7 @@ public:
 
 private:
   asio::io_context& io_;
+  io::timing_wheel& timing_wheel_;
   const dispatcher dispatcher_;
   const std::size_t max_queue_size_;
   std::shared_ptr<retry_strategy> default_retry_strategy_;
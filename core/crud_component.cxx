@@ -19,6 +19,7 @@
 
 #include "collections_component.hxx"
 #include "core/error_context/key_value_status_code.hxx"
+#include "core/io/timing_wheel.hxx"
 #include "core/mcbp/buffer_writer.hxx"
 #include "core/pending_operation.hxx"
 #include "core/protocol/client_opcode.hxx"
@@ -38,7 +39,6 @@
 
 #include <asio/error.hpp>
 #include <asio/io_context.hpp>
-#include <asio/steady_timer.hpp>
 #include <fmt/format.h>
 #include <gsl/span>
 #include <gsl/span_ext>
@@ -238,11 +238,10 @@ public:
   crud_component_impl(asio::io_context& io,
                       collections_component collections,
                       std::shared_ptr<retry_strategy> default_retry_strategy)
-    : io_{ io }
+    : timing_wheel_{ asio::use_service<io::timing_wheel>(io) }
     , collections_{ std::move(collections) }
     , default_retry_strategy_{ std::move(default_retry_strategy) }
   {
-    (void)io_;
   }
 
   auto range_scan_create(std::uint16_t vbucket_id,
@@ -282,15 +281,7 @@ public:
     }
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
-      timer->expires_after(options.timeout);
-      timer->async_wait([req](auto error) {
-        if (error == asio::error::operation_aborted) {
-          return;
-        }
-        req->cancel(couchbase::errc::common::unambiguous_timeout);
-      });
-      req->set_deadline(timer);
+      req->set_deadline(timing_wheel_, options.timeout);
     }
 
     return op;
@@ -349,15 +340,7 @@ public:
     req->vbucket_ = vbucket_id;
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
-      timer->expires_after(options.timeout);
-      timer->async_wait([req](auto error) {
-        if (error == asio::error::operation_aborted) {
-          return;
-        }
-        req->cancel(couchbase::errc::common::unambiguous_timeout);
-      });
-      req->set_deadline(timer);
+      req->set_deadline(timing_wheel_, options.timeout);
     }
 
     mcbp::buffer_writer buf{ scan_uuid.size() + (sizeof(std::uint32_t) * 3) };
@@ -399,22 +382,14 @@ public:
     }
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
-      timer->expires_after(options.timeout);
-      timer->async_wait([req](auto error) {
-        if (error == asio::error::operation_aborted) {
-          return;
-        }
-        req->cancel(couchbase::errc::common::unambiguous_timeout);
-      });
-      req->set_deadline(timer);
+      req->set_deadline(timing_wheel_, options.timeout);
     }
 
     return op;
   }
 
 private:
-  asio::io_context& io_;
+  io::timing_wheel& timing_wheel_;
   collections_component collections_;
   std::shared_ptr<retry_strategy> default_retry_strategy_;
 };
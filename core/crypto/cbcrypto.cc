@@ -991,6 +991,17 @@ couchbase::core::crypto::digest(const Algorithm algorithm, std::string_view data
                               std::to_string(int(algorithm)));
 }
 
+void
+couchbase::core::crypto::cleanse(std::string& secret)
+{
+  // writes through volatile pointer cannot be removed as dead stores
+  volatile char* data = secret.data();
+  for (std::size_t i = 0; i < secret.size(); ++i) {
+    data[i] = 0;
+  }
+  secret.clear();
+}
+
 std::string
 couchbase::core::crypto::encrypt(const Cipher cipher,
                                  std::string_view key,
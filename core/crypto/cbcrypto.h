@@ -63,6 +63,13 @@ PBKDF2_HMAC(Algorithm algorithm,
 std::string
 digest(Algorithm algorithm, std::string_view data);
 
+/**
+ * Overwrite the secret with zeros in a way, that cannot be optimized away, and leave the string
+ * empty.
+ */
+void
+cleanse(std::string& secret);
+
 enum class Cipher {
   AES_256_cbc
 };
@@ -32,6 +32,7 @@
 #include "error.hxx"
 #include "internal_search_result.hxx"
 #include "query.hxx"
+#include "row_streaming.hxx"
 #include "search.hxx"
 
 #include <couchbase/analytics_index_manager.hxx>
@@ -126,6 +127,7 @@ options_to_origin(const std::string& connection_string,
     user_options.disable_mozilla_ca_certificates = opts.security.disable_mozilla_ca_certificates;
     user_options.tls_disable_deprecated_protocols = opts.security.disable_deprecated_protocols;
     user_options.tls_disable_v1_2 = opts.security.disable_tls_v1_2;
+    user_options.tls_session_resumption = opts.security.session_resumption;
   }
 
   if (opts.dns.nameserver) {
@@ -150,6 +152,20 @@ options_to_origin(const std::string& connection_string,
   if (opts.network.max_http_connections) {
     user_options.max_http_connections = opts.network.max_http_connections.value();
   }
+  user_options.io_threads = opts.network.io_threads;
+  user_options.num_kv_connections = opts.network.num_kv_connections;
+  if (opts.network.max_key_value_read_buffer_size) {
+    user_options.max_key_value_read_buffer_size =
+      opts.network.max_key_value_read_buffer_size.value();
+  }
+  if (opts.network.key_value_write_coalescing_delay) {
+    user_options.key_value_write_coalescing_delay =
+      opts.network.key_value_write_coalescing_delay.value();
+  }
+  if (opts.network.key_value_write_coalescing_threshold) {
+    user_options.key_value_write_coalescing_threshold =
+      opts.network.key_value_write_coalescing_threshold.value();
+  }
   if (!opts.network.network.empty()) {
     user_options.network = opts.network.network;
   }
@@ -167,6 +183,8 @@ options_to_origin(const std::string& connection_string,
   user_options.server_group = opts.network.server_group;
 
   user_options.enable_compression = opts.compression.enabled;
+  user_options.compression_min_size = opts.compression.min_size;
+  user_options.compression_min_ratio = opts.compression.min_ratio;
 
   user_options.enable_metrics = opts.metrics.enabled;
   if (opts.metrics.enabled) {
@@ -296,24 +314,33 @@ public:
       });
   }
 
-  void query(std::string statement, query_options::built options, query_handler&& handler) const
+  void query(std::string statement,
+             query_options::built options,
+             query_row_handler&& row_handler,
+             query_handler&& handler) const
   {
-    return core_.execute(
-      core::impl::build_query_request(std::move(statement), {}, std::move(options)),
-      [handler = std::move(handler)](auto resp) {
-        return handler(core::impl::make_error(resp.ctx), core::impl::build_result(resp));
-      });
+    auto request = core::impl::build_query_request(std::move(statement), {}, std::move(options));
+    if (row_handler) {
+      request.row_callback = core::impl::build_row_callback(std::move(row_handler));
+    }
+    return core_.execute(std::move(request), [handler = std::move(handler)](auto resp) {
+      return handler(core::impl::make_error(resp.ctx), core::impl::build_result(resp));
+    });
   }
 
   void analytics_query(std::string statement,
                        analytics_options::built options,
+                       analytics_row_handler&& row_handler,
                        analytics_handler&& handler) const
   {
-    return core_.execute(
-      core::impl::build_analytics_request(std::move(statement), std::move(options), {}, {}),
-      [handler = std::move(handler)](auto resp) {
-        return handler(core::impl::make_error(resp.ctx), core::impl::build_result(resp));
-      });
+    auto request =
+      core::impl::build_analytics_request(std::move(statement), std::move(options), {}, {});
+    if (row_handler) {
+      request.row_callback = core::impl::build_row_callback(std::move(row_handler));
+    }
+    return core_.execute(std::move(request), [handler = std::move(handler)](auto resp) {
+      return handler(core::impl::make_error(resp.ctx), core::impl::build_result(resp));
+    });
   }
 
   void ping(const ping_options::built& options, ping_handler&& handler) const
@@ -337,10 +364,16 @@ public:
   void search(std::string index_name,
               couchbase::search_request request,
               const search_options::built& options,
+              search_row_handler&& row_handler,
               search_handler&& handler) const
   {
+    auto core_request =
+      core::impl::build_search_request(std::move(index_name), std::move(request), options, {}, {});
+    if (row_handler) {
+      core_request.row_callback = core::impl::build_search_row_callback(std::move(row_handler));
+    }
     return core_.execute(
-      core::impl::build_search_request(std::move(index_name), std::move(request), options, {}, {}),
+      std::move(core_request),
       [handler = std::move(handler)](auto resp) mutable {
         return handler(core::impl::make_error(resp.ctx),
                        search_result{ internal_search_result{ resp } });
@@ -425,7 +458,17 @@ extract_core_cluster(const couchbase::cluster& cluster) -> const core::cluster&
 void
 cluster::query(std::string statement, const query_options& options, query_handler&& handler) const
 {
-  return impl_->query(std::move(statement), options.build(), std::move(handler));
+  return impl_->query(std::move(statement), options.build(), {}, std::move(handler));
+}
+
+void
+cluster::query(std::string statement,
+               const query_options& options,
+               query_row_handler&& row_handler,
+               query_handler&& handler) const
+{
+  return impl_->query(
+    std::move(statement), options.build(), std::move(row_handler), std::move(handler));
 }
 
 auto
@@ -445,7 +488,17 @@ cluster::analytics_query(std::string statement,
                          const analytics_options& options,
                          analytics_handler&& handler) const
 {
-  impl_->analytics_query(std::move(statement), options.build(), std::move(handler));
+  impl_->analytics_query(std::move(statement), options.build(), {}, std::move(handler));
+}
+
+void
+cluster::analytics_query(std::string statement,
+                         const analytics_options& options,
+                         analytics_row_handler&& row_handler,
+                         analytics_handler&& handler) const
+{
+  impl_->analytics_query(
+    std::move(statement), options.build(), std::move(row_handler), std::move(handler));
 }
 
 auto
@@ -502,7 +555,21 @@ cluster::search(std::string index_name,
                 search_handler&& handler) const
 {
   return impl_->search(
-    std::move(index_name), std::move(request), options.build(), std::move(handler));
+    std::move(index_name), std::move(request), options.build(), {}, std::move(handler));
+}
+
+void
+cluster::search(std::string index_name,
+                search_request request,
+                const search_options& options,
+                search_row_handler&& row_handler,
+                search_handler&& handler) const
+{
+  return impl_->search(std::move(index_name),
+                       std::move(request),
+                       options.build(),
+                       std::move(row_handler),
+                       std::move(handler));
 }
 
 auto
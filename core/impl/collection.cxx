@@ -92,8 +92,10 @@
 
 #include <fmt/format.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <memory>
 #include <optional>
@@ -105,6 +107,42 @@
 
 namespace couchbase
 {
+namespace
+{
+/**
+ * Gathers the results of the documents executed one by one, and passes them to the handler in the
+ * original order once the last one has completed.
+ */
+template<typename Result>
+class multi_result_collector : public std::enable_shared_from_this<multi_result_collector<Result>>
+{
+public:
+  using handler_type = std::function<void(std::vector<std::pair<error, Result>>)>;
+
+  multi_result_collector(std::size_t size, handler_type&& handler)
+    : results_(size)
+    , pending_{ size }
+    , handler_{ std::move(handler) }
+  {
+  }
+
+  auto handler_for(std::size_t index) -> std::function<void(error, Result)>
+  {
+    return [self = this->shared_from_this(), index](error err, Result result) {
+      self->results_[index] = { std::move(err), std::move(result) };
+      if (self->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        self->handler_(std::move(self->results_));
+      }
+    };
+  }
+
+private:
+  std::vector<std::pair<error, Result>> results_;
+  std::atomic_size_t pending_;
+  handler_type handler_;
+};
+} // namespace
+
 class collection_impl : public std::enable_shared_from_this<collection_impl>
 {
 public:
@@ -177,6 +215,46 @@ public:
       });
   }
 
+  void get_multi(std::vector<std::string> document_keys,
+                 const get_options::built& options,
+                 get_multi_handler&& handler) const
+  {
+    if (document_keys.empty()) {
+      return handler({});
+    }
+    if (options.with_expiry || !options.projections.empty()) {
+      auto collector = std::make_shared<multi_result_collector<get_result>>(document_keys.size(),
+                                                                            std::move(handler));
+      for (std::size_t i = 0; i < document_keys.size(); ++i) {
+        get(std::move(document_keys[i]), options, collector->handler_for(i));
+      }
+      return;
+    }
+    std::vector<core::operations::get_request> requests{};
+    requests.reserve(document_keys.size());
+    for (auto& document_key : document_keys) {
+      requests.emplace_back(core::operations::get_request{
+        core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+        {},
+        {},
+        options.timeout,
+        { options.retry_strategy },
+      });
+    }
+    return core_.execute(
+      std::move(requests),
+      [handler = std::move(handler)](
+        std::vector<core::operations::get_response> responses) mutable {
+        std::vector<std::pair<error, get_result>> results{};
+        results.reserve(responses.size());
+        for (auto& resp : responses) {
+          results.emplace_back(core::impl::make_error(std::move(resp.ctx)),
+                               get_result{ resp.cas, { std::move(resp.value), resp.flags }, {} });
+        }
+        return handler(std::move(results));
+      });
+  }
+
   void get_and_touch(std::string document_key,
                      std::uint32_t expiry,
                      get_and_touch_options::built options,
@@ -319,6 +397,52 @@ public:
                          });
   }
 
+  void remove_multi(std::vector<std::string> document_keys,
+                    const remove_options::built& options,
+                    remove_multi_handler&& handler) const
+  {
+    if (document_keys.empty()) {
+      return handler({});
+    }
+    if (options.persist_to != persist_to::none || options.replicate_to != replicate_to::none) {
+      auto collector = std::make_shared<multi_result_collector<mutation_result>>(
+        document_keys.size(), std::move(handler));
+      for (std::size_t i = 0; i < document_keys.size(); ++i) {
+        remove(std::move(document_keys[i]), options, collector->handler_for(i));
+      }
+      return;
+    }
+    std::vector<core::operations::remove_request> requests{};
+    requests.reserve(document_keys.size());
+    for (auto& document_key : document_keys) {
+      requests.emplace_back(core::operations::remove_request{
+        core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+        {},
+        {},
+        options.cas,
+        options.durability_level,
+        options.timeout,
+        { options.retry_strategy },
+      });
+    }
+    return core_.execute(
+      std::move(requests),
+      [handler = std::move(handler)](
+        std::vector<core::operations::remove_response> responses) mutable {
+        std::vector<std::pair<error, mutation_result>> results{};
+        results.reserve(responses.size());
+        for (auto& resp : responses) {
+          if (resp.ctx.ec()) {
+            results.emplace_back(core::impl::make_error(std::move(resp.ctx)), mutation_result{});
+          } else {
+            results.emplace_back(core::impl::make_error(std::move(resp.ctx)),
+                                 mutation_result{ resp.cas, std::move(resp.token) });
+          }
+        }
+        return handler(std::move(results));
+      });
+  }
+
   void get_and_lock(std::string document_key,
                     std::chrono::seconds lock_duration,
                     get_and_lock_options::built options,
@@ -657,6 +781,52 @@ public:
       });
   }
 
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options::built& options,
+                    upsert_multi_handler&& handler) const
+  {
+    if (documents.empty()) {
+      return handler({});
+    }
+    if (options.persist_to != persist_to::none || options.replicate_to != replicate_to::none) {
+      auto collector = std::make_shared<multi_result_collector<mutation_result>>(
+        documents.size(), std::move(handler));
+      for (std::size_t i = 0; i < documents.size(); ++i) {
+        auto& [document_key, encoded] = documents[i];
+        upsert(std::move(document_key), std::move(encoded), options, collector->handler_for(i));
+      }
+      return;
+    }
+    std::vector<core::operations::upsert_request> requests{};
+    requests.reserve(documents.size());
+    for (auto& [document_key, encoded] : documents) {
+      requests.emplace_back(core::operations::upsert_request{
+        core::document_id{ bucket_name_, scope_name_, name_, std::move(document_key) },
+        std::move(encoded.data),
+        {},
+        {},
+        encoded.flags,
+        options.expiry,
+        options.durability_level,
+        options.timeout,
+        { options.retry_strategy },
+        options.preserve_expiry,
+      });
+    }
+    return core_.execute(
+      std::move(requests),
+      [handler = std::move(handler)](
+        std::vector<core::operations::upsert_response> responses) mutable {
+        std::vector<std::pair<error, mutation_result>> results{};
+        results.reserve(responses.size());
+        for (auto& resp : responses) {
+          results.emplace_back(core::impl::make_error(std::move(resp.ctx)),
+                               mutation_result{ resp.cas, std::move(resp.token) });
+        }
+        return handler(std::move(results));
+      });
+  }
+
   void insert(std::string document_key,
               codec::encoded_value encoded,
               insert_options::built options,
@@ -980,6 +1150,26 @@ collection::get(std::string document_id,
   return future;
 }
 
+void
+collection::get_multi(std::vector<std::string> document_ids,
+                      const get_options& options,
+                      get_multi_handler&& handler) const
+{
+  return impl_->get_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::get_multi(std::vector<std::string> document_ids, const get_options& options) const
+  -> std::future<std::vector<std::pair<error, get_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, get_result>>>>();
+  auto future = barrier->get_future();
+  get_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::get_and_touch(std::string document_id,
                           std::chrono::seconds duration,
@@ -1142,6 +1332,27 @@ collection::remove(std::string document_id, const remove_options& options) const
   return future;
 }
 
+void
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options,
+                         remove_multi_handler&& handler) const
+{
+  return impl_->remove_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options) const
+  -> std::future<std::vector<std::pair<error, mutation_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, mutation_result>>>>();
+  auto future = barrier->get_future();
+  remove_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::mutate_in(std::string document_id,
                       const mutate_in_specs& specs,
@@ -1328,6 +1539,27 @@ collection::upsert(std::string document_id,
   return future;
 }
 
+void
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options,
+                         upsert_multi_handler&& handler) const
+{
+  return impl_->upsert_multi(std::move(documents), options.build(), std::move(handler));
+}
+
+auto
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options) const
+  -> std::future<std::vector<std::pair<error, mutation_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, mutation_result>>>>();
+  auto future = barrier->get_future();
+  upsert_multi(std::move(documents), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::insert(std::string document_id,
                    codec::encoded_value document,
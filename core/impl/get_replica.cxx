@@ -37,12 +37,12 @@ get_replica_request::encode_to(get_replica_request::encoded_request_type& encode
 
 auto
 get_replica_request::make_response(key_value_error_context&& ctx,
-                                   const encoded_response_type& encoded) const
+                                   encoded_response_type&& encoded) const
   -> get_replica_response
 {
   get_replica_response response{ std::move(ctx) };
   if (!response.ctx.ec()) {
-    response.value = encoded.body().value();
+    response.value = std::move(encoded.body()).value();
     response.cas = encoded.cas();
     response.flags = encoded.body().flags();
   }
@@ -51,7 +51,7 @@ struct get_replica_request {
                                core::mcbp_context&& context) const -> std::error_code;
 
   [[nodiscard]] auto make_response(key_value_error_context&& ctx,
-                                   const encoded_response_type& encoded) const
+                                   encoded_response_type&& encoded) const
     -> get_replica_response;
 };
 } // namespace couchbase::core::impl
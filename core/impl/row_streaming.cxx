@@ -0,0 +1,71 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "row_streaming.hxx"
+
+#include "core/logger/logger.hxx"
+#include "core/operations/document_search.hxx"
+#include "core/utils/binary.hxx"
+#include "internal_search_row.hxx"
+
+#include <couchbase/search_row.hxx>
+
+#include <stdexcept>
+#include <utility>
+
+namespace couchbase::core::impl
+{
+namespace
+{
+auto
+to_core_stream_control(stream_control control) -> utils::json::stream_control
+{
+  switch (control) {
+    case stream_control::next_row:
+      return utils::json::stream_control::next_row;
+    case stream_control::stop:
+      break;
+  }
+  return utils::json::stream_control::stop;
+}
+} // namespace
+
+auto
+build_row_callback(std::function<stream_control(codec::binary)> row_handler) -> row_callback_type
+{
+  return [row_handler = std::move(row_handler)](std::string row) {
+    return to_core_stream_control(row_handler(utils::to_binary(row)));
+  };
+}
+
+auto
+build_search_row_callback(search_row_handler row_handler) -> row_callback_type
+{
+  return [row_handler = std::move(row_handler)](std::string row) {
+    core::operations::search_response::search_row parsed{};
+    try {
+      parsed = core::operations::parse_search_row(row);
+    } catch (const std::exception& e) {
+      CB_LOG_ERROR("Error parsing streamed search row, skipping the rest of the rows. Error: {}.",
+                   e.what());
+      return utils::json::stream_control::stop;
+    }
+    return to_core_stream_control(
+      row_handler(search_row{ internal_search_row{ std::move(parsed) } }));
+  };
+}
+} // namespace couchbase::core::impl
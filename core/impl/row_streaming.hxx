@@ -0,0 +1,45 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/json_stream_control.hxx"
+
+#include <couchbase/codec/encoded_value.hxx>
+#include <couchbase/search_options.hxx>
+#include <couchbase/stream_control.hxx>
+
+#include <functional>
+#include <string>
+
+namespace couchbase::core::impl
+{
+using row_callback_type = std::function<utils::json::stream_control(std::string)>;
+
+/**
+ * Adapts row handler of the query or analytics to the row callback of the core request.
+ */
+auto
+build_row_callback(std::function<stream_control(codec::binary)> row_handler) -> row_callback_type;
+
+/**
+ * Adapts row handler of the search to the row callback of the core request, parsing each hit into
+ * the search_row.
+ */
+auto
+build_search_row_callback(search_row_handler row_handler) -> row_callback_type;
+} // namespace couchbase::core::impl
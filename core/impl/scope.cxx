@@ -25,6 +25,7 @@
 #include "internal_search_row_location.hxx"
 #include "internal_search_row_locations.hxx"
 #include "query.hxx"
+#include "row_streaming.hxx"
 #include "search.hxx"
 
 #include <couchbase/bucket.hxx>
@@ -64,35 +65,49 @@ public:
     return core_;
   }
 
-  void query(std::string statement, query_options::built options, query_handler&& handler) const
+  void query(std::string statement,
+             query_options::built options,
+             query_row_handler&& row_handler,
+             query_handler&& handler) const
   {
-    return core_.execute(
-      core::impl::build_query_request(std::move(statement), query_context_, std::move(options)),
-      [handler = std::move(handler)](auto resp) {
-        return handler(core::impl::make_error(resp.ctx), core::impl::build_result(resp));
-      });
+    auto request =
+      core::impl::build_query_request(std::move(statement), query_context_, std::move(options));
+    if (row_handler) {
+      request.row_callback = core::impl::build_row_callback(std::move(row_handler));
+    }
+    return core_.execute(std::move(request), [handler = std::move(handler)](auto resp) {
+      return handler(core::impl::make_error(resp.ctx), core::impl::build_result(resp));
+    });
   }
 
   void analytics_query(std::string statement,
                        analytics_options::built options,
+                       analytics_row_handler&& row_handler,
                        analytics_handler&& handler) const
   {
-    return core_.execute(core::impl::build_analytics_request(
-                           std::move(statement), std::move(options), bucket_name_, name_),
-                         [handler = std::move(handler)](auto resp) mutable {
-                           return handler(core::impl::make_error(resp.ctx),
-                                          core::impl::build_result(resp));
-                         });
+    auto request = core::impl::build_analytics_request(
+      std::move(statement), std::move(options), bucket_name_, name_);
+    if (row_handler) {
+      request.row_callback = core::impl::build_row_callback(std::move(row_handler));
+    }
+    return core_.execute(std::move(request), [handler = std::move(handler)](auto resp) mutable {
+      return handler(core::impl::make_error(resp.ctx), core::impl::build_result(resp));
+    });
   }
 
   void search(std::string index_name,
               couchbase::search_request request,
               search_options::built options,
+              search_row_handler&& row_handler,
               search_handler&& handler) const
   {
+    auto core_request = core::impl::build_search_request(
+      std::move(index_name), std::move(request), std::move(options), bucket_name_, name_);
+    if (row_handler) {
+      core_request.row_callback = core::impl::build_search_row_callback(std::move(row_handler));
+    }
     return core_.execute(
-      core::impl::build_search_request(
-        std::move(index_name), std::move(request), std::move(options), bucket_name_, name_),
+      std::move(core_request),
       [handler = std::move(handler)](auto&& resp) mutable {
         return handler(core::impl::make_error(resp.ctx),
                        search_result{ internal_search_result{ resp } });
@@ -132,7 +147,17 @@ scope::collection(std::string_view collection_name) const -> couchbase::collecti
 void
 scope::query(std::string statement, const query_options& options, query_handler&& handler) const
 {
-  return impl_->query(std::move(statement), options.build(), std::move(handler));
+  return impl_->query(std::move(statement), options.build(), {}, std::move(handler));
+}
+
+void
+scope::query(std::string statement,
+             const query_options& options,
+             query_row_handler&& row_handler,
+             query_handler&& handler) const
+{
+  return impl_->query(
+    std::move(statement), options.build(), std::move(row_handler), std::move(handler));
 }
 
 auto
@@ -152,7 +177,17 @@ scope::analytics_query(std::string statement,
                        const analytics_options& options,
                        analytics_handler&& handler) const
 {
-  return impl_->analytics_query(std::move(statement), options.build(), std::move(handler));
+  return impl_->analytics_query(std::move(statement), options.build(), {}, std::move(handler));
+}
+
+void
+scope::analytics_query(std::string statement,
+                       const analytics_options& options,
+                       analytics_row_handler&& row_handler,
+                       analytics_handler&& handler) const
+{
+  return impl_->analytics_query(
+    std::move(statement), options.build(), std::move(row_handler), std::move(handler));
 }
 
 auto
@@ -174,7 +209,21 @@ scope::search(std::string index_name,
               search_handler&& handler) const
 {
   return impl_->search(
-    std::move(index_name), std::move(request), options.build(), std::move(handler));
+    std::move(index_name), std::move(request), options.build(), {}, std::move(handler));
+}
+
+void
+scope::search(std::string index_name,
+              search_request request,
+              const search_options& options,
+              search_row_handler&& row_handler,
+              search_handler&& handler) const
+{
+  return impl_->search(std::move(index_name),
+                       std::move(request),
+                       options.build(),
+                       std::move(row_handler),
+                       std::move(handler));
 }
 
 auto
@@ -0,0 +1,142 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Socket read buffer of the KV session.
+ *
+ * The buffer doubles whenever a read fills it completely, up to the configured maximum, and is
+ * halved after a series of reads that used only a small fraction of it. Once the connection
+ * becomes idle (nothing is in flight and nothing is buffered by the parser), the reads switch to
+ * the minimal buffer, which is always kept, so that the grown one can be released later if the
+ * connection stays idle. The next read switches back to the grown buffer.
+ */
+class adaptive_read_buffer
+{
+public:
+  static constexpr std::size_t min_size{ 16 * 1024 };
+  static constexpr std::size_t shrink_threshold{ 64 };
+
+  adaptive_read_buffer()
+    : minimal_(min_size)
+  {
+  }
+
+  /**
+   * @return the buffer for the next read
+   */
+  [[nodiscard]] auto data() -> std::byte*
+  {
+    return use_minimal() ? minimal_.data() : grown_.data();
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return use_minimal() ? minimal_.size() : grown_.size();
+  }
+
+  /**
+   * @return the size of the largest buffer held
+   */
+  [[nodiscard]] auto capacity() const -> std::size_t
+  {
+    return grown_.empty() ? minimal_.size() : grown_.size();
+  }
+
+  /**
+   * Adjusts the buffer after the read. The content must be consumed before the call.
+   *
+   * @return true if the buffer has been resized
+   */
+  auto on_read(std::size_t bytes_transferred, std::size_t max_size) -> bool
+  {
+    if (std::exchange(idle_, false) && !grown_.empty()) {
+      // the read has used the minimal buffer, the traffic continues with the grown one
+      return false;
+    }
+    const std::size_t current_size = size();
+    std::size_t new_size = current_size;
+    if (bytes_transferred == current_size) {
+      small_reads_ = 0;
+      new_size = std::min(current_size * 2, std::max(min_size, max_size));
+    } else if (bytes_transferred < current_size / 4) {
+      if (++small_reads_ >= shrink_threshold) {
+        small_reads_ = 0;
+        new_size = std::max(current_size / 2, min_size);
+      }
+    } else {
+      small_reads_ = 0;
+    }
+    return resize(new_size);
+  }
+
+  /**
+   * Switches the reads to the minimal buffer, must be called only while no read is in progress.
+   *
+   * @return true if the grown buffer is held, and might be released
+   */
+  auto on_idle() -> bool
+  {
+    small_reads_ = 0;
+    idle_ = true;
+    return !grown_.empty();
+  }
+
+  /**
+   * Releases the grown buffer, if no read has completed since on_idle().
+   *
+   * @return true if the buffer has been released
+   */
+  auto release() -> bool
+  {
+    if (!idle_ || grown_.empty()) {
+      return false;
+    }
+    grown_ = std::vector<std::byte>{};
+    return true;
+  }
+
+private:
+  [[nodiscard]] auto use_minimal() const -> bool
+  {
+    return idle_ || grown_.empty();
+  }
+
+  auto resize(std::size_t new_size) -> bool
+  {
+    if (new_size == size()) {
+      return false;
+    }
+    // allocate new buffer, so that the memory of the large one is returned
+    grown_ = new_size > min_size ? std::vector<std::byte>(new_size) : std::vector<std::byte>{};
+    return true;
+  }
+
+  std::vector<std::byte> minimal_;
+  std::vector<std::byte> grown_{};
+  std::size_t small_reads_{ 0 };
+  bool idle_{ false };
+};
+} // namespace couchbase::core::io
@@ -24,10 +24,13 @@
 #include "core/utils/movable_function.hxx"
 #include "http_session.hxx"
 #include "http_traits.hxx"
+#include "timing_wheel.hxx"
 
 #include <couchbase/metrics/meter.hxx>
 #include <couchbase/tracing/request_tracer.hxx>
 
+#include <asio/dispatch.hpp>
+
 #include <utility>
 
 namespace couchbase::core::operations
@@ -40,7 +43,7 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
   using encoded_request_type = typename Request::encoded_request_type;
   using encoded_response_type = typename Request::encoded_response_type;
   using error_context_type = typename Request::error_context_type;
-  asio::steady_timer deadline;
+  io::wheel_timer deadline;
   Request request;
   encoded_request_type encoded;
   std::shared_ptr<couchbase::tracing::request_tracer> tracer_;
@@ -53,34 +56,34 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   std::chrono::milliseconds dispatch_timeout_{};
-  asio::steady_timer dispatch_deadline_;
+  io::wheel_timer dispatch_deadline_;
 
-  http_command(asio::io_context& ctx,
+  http_command(io::timing_wheel& wheel,
                Request req,
                std::shared_ptr<couchbase::tracing::request_tracer> tracer,
                std::shared_ptr<couchbase::metrics::meter> meter,
                std::chrono::milliseconds default_timeout,
                std::chrono::milliseconds dispatch_timeout)
-    : deadline(ctx)
+    : deadline(wheel)
     , request(req)
     , tracer_(std::move(tracer))
     , meter_(std::move(meter))
     , timeout_(request.timeout.value_or(default_timeout))
     , client_context_id_(request.client_context_id.value_or(uuid::to_string(uuid::random())))
     , dispatch_timeout_(dispatch_timeout)
-    , dispatch_deadline_(ctx)
+    , dispatch_deadline_(wheel)
   {
     if constexpr (io::http_traits::supports_parent_span_v<Request>) {
       parent_span = request.parent_span;
     }
   }
 #else
-  http_command(asio::io_context& ctx,
+  http_command(io::timing_wheel& wheel,
                Request req,
                std::shared_ptr<couchbase::tracing::request_tracer> tracer,
                std::shared_ptr<couchbase::metrics::meter> meter,
                std::chrono::milliseconds default_timeout)
-    : deadline(ctx)
+    : deadline(wheel)
     , request(req)
     , tracer_(std::move(tracer))
     , meter_(std::move(meter))
@@ -117,60 +120,83 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
     handler_ = std::move(handler);
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
     dispatch_deadline_.expires_after(dispatch_timeout_);
-    dispatch_deadline_.async_wait([self = this->shared_from_this()](std::error_code ec) {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      CB_LOG_DEBUG(
-        R"(HTTP request timed out before dispatch: {}, method={}, path="{}", client_context_id="{}")",
-        self->encoded.type,
-        self->encoded.method,
-        self->encoded.path,
-        self->client_context_id_);
-      self->cancel(errc::common::unambiguous_timeout);
-    });
+    dispatch_deadline_.async_wait<&http_command::on_dispatch_deadline>(this->shared_from_this());
 #endif
     deadline.expires_after(timeout_);
-    deadline.async_wait([self = this->shared_from_this()](std::error_code ec) {
-      if (ec == asio::error::operation_aborted) {
+    deadline.async_wait<&http_command::on_deadline>(this->shared_from_this());
+  }
+
+#ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
+  void on_dispatch_deadline()
+  {
+    CB_LOG_DEBUG(
+      R"(HTTP request timed out before dispatch: {}, method={}, path="{}", client_context_id="{}")",
+      encoded.type,
+      encoded.method,
+      encoded.path,
+      client_context_id_);
+    cancel(errc::common::unambiguous_timeout);
+  }
+#endif
+
+  void on_deadline()
+  {
+    CB_LOG_DEBUG(R"(HTTP request timed out: {}, method={}, path="{}", client_context_id="{}")",
+                 encoded.type,
+                 encoded.method,
+                 encoded.path,
+                 client_context_id_);
+    if constexpr (io::http_traits::supports_readonly_v<Request>) {
+      if (request.readonly) {
+        cancel(errc::common::unambiguous_timeout);
         return;
       }
-      CB_LOG_DEBUG(R"(HTTP request timed out: {}, method={}, path="{}", client_context_id="{}")",
-                   self->encoded.type,
-                   self->encoded.method,
-                   self->encoded.path,
-                   self->client_context_id_);
-      if constexpr (io::http_traits::supports_readonly_v<Request>) {
-        if (self->request.readonly) {
-          self->cancel(errc::common::unambiguous_timeout);
-          return;
-        }
-      }
-      self->cancel(errc::common::ambiguous_timeout);
-    });
+    }
+    cancel(errc::common::ambiguous_timeout);
   }
 
   void cancel(std::error_code ec)
   {
-    invoke_handler(ec, {});
-    if (session_) {
+    // the session might already serve another request, if the response has completed the command
+    if (invoke_handler(ec, {}) && session_) {
       session_->stop();
     }
   }
 
-  void invoke_handler(std::error_code ec, io::http_response&& msg)
+  /**
+   * The command is owned by the IO context of its timing wheel. The deadlines fire there, and the
+   * responses are moved there from the thread of the session, so that only one of them completes
+   * the command, even when the session runs on another IO thread.
+   */
+  [[nodiscard]] auto context() const -> asio::io_context&
+  {
+    return deadline.wheel().get_io_context();
+  }
+
+  /**
+   * @return true if this call has completed the command
+   */
+  auto invoke_handler(std::error_code ec, io::http_response&& msg) -> bool
   {
     if (span_ != nullptr) {
       span_->end();
       span_ = nullptr;
     }
-    if (auto handler = std::move(handler_); handler) {
-      handler(ec, std::move(msg));
+    auto handler = std::move(handler_);
+    if (handler) {
+      try {
+        handler(ec, std::move(msg));
+      } catch (const priv::retry_http_request&) {
+        // keep the handler for the retried request, the deadline stays armed for it
+        handler_ = std::move(handler);
+        throw;
+      }
     }
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
     dispatch_deadline_.cancel();
 #endif
     deadline.cancel();
+    return static_cast<bool>(handler);
   }
 
   void send_to()
@@ -212,7 +238,8 @@ private:
     encoded.client_context_id = client_context_id_;
     encoded.timeout = timeout_;
     if (auto ec = request.encode_to(encoded, session_->http_context()); ec) {
-      return invoke_handler(ec, {});
+      invoke_handler(ec, {});
+      return;
     }
     encoded.headers["client-context-id"] = client_context_id_;
     CB_LOG_TRACE(
@@ -227,10 +254,7 @@ private:
       encoded,
       [self = this->shared_from_this(),
        start = std::chrono::steady_clock::now()](std::error_code ec, io::http_response&& msg) {
-        if (ec == asio::error::operation_aborted) {
-          return self->invoke_handler(errc::common::ambiguous_timeout, std::move(msg));
-        }
-        if (self->meter_) {
+        if (ec != asio::error::operation_aborted && self->meter_) {
           static std::string meter_name = "db.couchbase.operations";
           static std::map<std::string, std::string> tags = {
             { "db.couchbase.service", fmt::format("{}", self->request.type) },
@@ -241,25 +265,40 @@ private:
                              std::chrono::steady_clock::now() - start)
                              .count());
         }
-        self->deadline.cancel();
-        self->finish_dispatch(self->session_->remote_address(), self->session_->local_address());
-        CB_LOG_TRACE(R"({} HTTP response: {}, client_context_id="{}", ec={}, status={}, body={})",
-                     self->session_->log_prefix(),
-                     self->request.type,
-                     self->client_context_id_,
-                     ec.message(),
-                     msg.status_code,
-                     msg.status_code == 200 ? "[hidden]" : msg.body.data());
-        if (auto parser_ec = msg.body.ec(); !ec && parser_ec) {
-          ec = parser_ec;
-        }
-        try {
-          self->invoke_handler(ec, std::move(msg));
-        } catch (const priv::retry_http_request&) {
-          self->send();
-        }
+        auto& ctx = self->context();
+        asio::dispatch(ctx, [self = std::move(self), ec, msg = std::move(msg)]() mutable {
+          self->on_response(ec, std::move(msg));
+        });
       });
   }
+
+  void on_response(std::error_code ec, io::http_response&& msg)
+  {
+    if (!handler_) {
+      // the deadline has completed the command before the response reached its IO context
+      return;
+    }
+    if (ec == asio::error::operation_aborted) {
+      invoke_handler(errc::common::ambiguous_timeout, std::move(msg));
+      return;
+    }
+    finish_dispatch(session_->remote_address(), session_->local_address());
+    CB_LOG_TRACE(R"({} HTTP response: {}, client_context_id="{}", ec={}, status={}, body={})",
+                 session_->log_prefix(),
+                 request.type,
+                 client_context_id_,
+                 ec.message(),
+                 msg.status_code,
+                 msg.status_code == 200 ? "[hidden]" : msg.body.data());
+    if (auto parser_ec = msg.body.ec(); !ec && parser_ec) {
+      ec = parser_ec;
+    }
+    try {
+      invoke_handler(ec, std::move(msg));
+    } catch (const priv::retry_http_request&) {
+      send();
+    }
+  }
 };
 
 } // namespace couchbase::core::operations
@@ -32,6 +32,8 @@
 #include "http_context.hxx"
 #include "http_session.hxx"
 #include "http_traits.hxx"
+#include "io_context_pool.hxx"
+#include "timing_wheel.hxx"
 
 #include <gsl/narrow>
 
@@ -73,6 +75,18 @@ public:
     meter_ = std::move(meter);
   }
 
+  void configure_query_cache(std::size_t capacity,
+                             const std::shared_ptr<couchbase::metrics::meter>& meter)
+  {
+    query_cache_.set_capacity(capacity);
+    query_cache_.set_meter(meter);
+  }
+
+  void set_io_context_pool(std::shared_ptr<io_context_pool> io_pool)
+  {
+    io_pool_ = std::move(io_pool);
+  }
+
   auto configuration_capabilities() const -> configuration_capabilities
   {
     std::scoped_lock config_lock(config_mutex_);
@@ -211,7 +225,7 @@ public:
           request.timeout = timeout;
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
           auto cmd = std::make_shared<operations::http_command<operations::http_noop_request>>(
-            ctx_,
+            next_timing_wheel(),
             request,
             tracer_,
             meter_,
@@ -219,7 +233,11 @@ public:
             dispatch_timeout_);
 #else
           auto cmd = std::make_shared<operations::http_command<operations::http_noop_request>>(
-            ctx_, request, tracer_, meter_, options_.default_timeout_for(request.type));
+            next_timing_wheel(),
+            request,
+            tracer_,
+            meter_,
+            options_.default_timeout_for(request.type));
 #endif
 
           cmd->start(
@@ -413,7 +431,7 @@ public:
 
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
     auto cmd = std::make_shared<operations::http_command<Request>>(
-      ctx_,
+      next_timing_wheel(),
       request,
       tracer_,
       meter_,
@@ -421,7 +439,11 @@ public:
       dispatch_timeout_);
 #else
     auto cmd = std::make_shared<operations::http_command<Request>>(
-      ctx_, request, tracer_, meter_, options_.default_timeout_for(request.type));
+      next_timing_wheel(),
+      request,
+      tracer_,
+      meter_,
+      options_.default_timeout_for(request.type));
 #endif
     cmd->start([self = shared_from_this(), cmd, handler = std::forward<Handler>(handler)](
                  std::error_code ec, io::http_response&& msg) mutable {
@@ -613,17 +635,27 @@ private:
     });
   }
 
+  /**
+   * The commands are spread across the IO contexts of the pool, so that their completion does not
+   * run on a single thread.
+   */
+  auto next_timing_wheel() -> timing_wheel&
+  {
+    return asio::use_service<timing_wheel>(io_pool_ ? io_pool_->next() : ctx_);
+  }
+
   auto create_session(service_type type,
                       const couchbase::core::cluster_credentials& credentials,
                       const std::string& hostname,
                       std::uint16_t port) -> std::shared_ptr<http_session>
   {
     std::shared_ptr<http_session> session;
+    auto& session_ctx = io_pool_ ? io_pool_->next() : ctx_;
     if (options_.enable_tls) {
       session = std::make_shared<http_session>(
         type,
         client_id_,
-        ctx_,
+        session_ctx,
         tls_,
         credentials,
         hostname,
@@ -633,7 +665,7 @@ private:
       session = std::make_shared<http_session>(
         type,
         client_id_,
-        ctx_,
+        session_ctx,
         credentials,
         hostname,
         std::to_string(port),
@@ -668,7 +700,7 @@ private:
       }
     }
     auto cmd = std::make_shared<operations::http_command<Request>>(
-      ctx_,
+      next_timing_wheel(),
       request,
       tracer_,
       meter_,
@@ -722,7 +754,8 @@ private:
       auto [error, session] = self->check_out(request.type, credentials, preferred_node);
       if (error) {
         using response_type = typename Request::encoded_response_type;
-        return cmd->invoke_handler(error, response_type{});
+        cmd->invoke_handler(error, response_type{});
+        return;
       }
       cmd->set_command_session(session);
       if (!session->is_connected()) {
@@ -826,6 +859,7 @@ private:
 
   std::string client_id_;
   asio::io_context& ctx_;
+  std::shared_ptr<io_context_pool> io_pool_{};
   asio::ssl::context& tls_;
   std::shared_ptr<couchbase::tracing::request_tracer> tracer_{ nullptr };
   std::shared_ptr<couchbase::metrics::meter> meter_{ nullptr };
@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "io_context_pool.hxx"
+
+#include "core/logger/logger.hxx"
+#include "timing_wheel.hxx"
+
+namespace couchbase::core::io
+{
+io_context_pool::io_context_pool(asio::io_context& primary)
+  : primary_{ primary }
+{
+}
+
+io_context_pool::~io_context_pool()
+{
+  stop();
+}
+
+void
+io_context_pool::start(std::size_t number_of_threads)
+{
+  const std::scoped_lock lock(workers_mutex_);
+  if (stopped_ || !workers_.empty() || number_of_threads <= 1) {
+    return;
+  }
+  CB_LOG_DEBUG("start IO context pool with {} threads", number_of_threads);
+  for (std::size_t i = 1; i < number_of_threads; ++i) {
+    auto w = std::make_unique<worker>();
+    w->thread = std::thread{ [&ctx = w->ctx]() {
+      ctx.run();
+    } };
+    workers_.emplace_back(std::move(w));
+  }
+}
+
+void
+io_context_pool::stop()
+{
+  {
+    const std::scoped_lock lock(workers_mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  // the contexts are kept until the pool is destroyed, as the sessions might still refer to them
+  for (auto& w : workers_) {
+    w->work.reset();
+  }
+  for (auto& w : workers_) {
+    if (w->thread.joinable()) {
+      w->thread.join();
+    }
+  }
+}
+
+auto
+io_context_pool::size() const -> std::size_t
+{
+  const std::scoped_lock lock(workers_mutex_);
+  return workers_.size() + 1;
+}
+
+auto
+io_context_pool::primary() -> asio::io_context&
+{
+  return primary_;
+}
+
+auto
+io_context_pool::next() -> asio::io_context&
+{
+  const std::scoped_lock lock(workers_mutex_);
+  if (stopped_ || workers_.empty()) {
+    return primary_;
+  }
+  const auto index = next_++ % (workers_.size() + 1);
+  if (index == 0) {
+    return primary_;
+  }
+  return workers_[index - 1]->ctx;
+}
+
+auto
+io_context_pool::next_timing_wheel() -> timing_wheel&
+{
+  return asio::use_service<timing_wheel>(next());
+}
+} // namespace couchbase::core::io
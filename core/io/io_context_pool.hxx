@@ -0,0 +1,83 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <asio/executor_work_guard.hpp>
+#include <asio/io_context.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace couchbase::core::io
+{
+class timing_wheel;
+
+/**
+ * Set of IO contexts used to spread network sessions across multiple threads.
+ *
+ * The primary context is owned and run by the application. Additional contexts are created by
+ * start() and each of them is run by its own thread until stop() is called. Sessions pick their
+ * context with next(), which hands them out in round-robin order, so the connections to different
+ * nodes are served by different threads. The commands pick the timing wheel of one of the contexts
+ * with next_timing_wheel(), and their deadlines, response decoding and completion run there.
+ */
+class io_context_pool
+{
+public:
+  explicit io_context_pool(asio::io_context& primary);
+  io_context_pool(const io_context_pool&) = delete;
+  io_context_pool(io_context_pool&&) = delete;
+  auto operator=(const io_context_pool&) -> io_context_pool& = delete;
+  auto operator=(io_context_pool&&) -> io_context_pool& = delete;
+  ~io_context_pool();
+
+  /**
+   * Spawns threads for the pool, so that together with the primary context there will be
+   * number_of_threads contexts. Does nothing if the pool has been started already.
+   */
+  void start(std::size_t number_of_threads);
+
+  /**
+   * Lets additional contexts run out of work and joins their threads, so that the handlers still
+   * queued on them are invoked with their cancellation errors. The sessions running on the
+   * contexts must be stopped first. Must not be called from the thread that belongs to the pool.
+   */
+  void stop();
+
+  [[nodiscard]] auto size() const -> std::size_t;
+  [[nodiscard]] auto primary() -> asio::io_context&;
+  [[nodiscard]] auto next() -> asio::io_context&;
+  [[nodiscard]] auto next_timing_wheel() -> timing_wheel&;
+
+private:
+  struct worker {
+    asio::io_context ctx{ ASIO_CONCURRENCY_HINT_1 };
+    asio::executor_work_guard<asio::io_context::executor_type> work{ asio::make_work_guard(ctx) };
+    std::thread thread{};
+  };
+
+  asio::io_context& primary_;
+  mutable std::mutex workers_mutex_{};
+  std::vector<std::unique_ptr<worker>> workers_{};
+  std::size_t next_{ 0 };
+  bool stopped_{ false };
+};
+} // namespace couchbase::core::io
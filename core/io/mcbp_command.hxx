@@ -18,7 +18,6 @@
 #pragma once
 
 #include "core/document_id_fmt.hxx"
-#include "core/platform/uuid.h"
 #include "core/protocol/client_request.hxx"
 #include "core/protocol/client_response.hxx"
 #include "core/protocol/cmd_get_collection_id.hxx"
@@ -29,12 +28,13 @@
 #include "mcbp_session.hxx"
 #include "mcbp_traits.hxx"
 #include "retry_orchestrator.hxx"
+#include "timing_wheel.hxx"
 
 #include "core/error_context/key_value_error_map_info.hxx"
 #include <couchbase/durability_level.hxx>
 #include <couchbase/error_codes.hxx>
 
-#include <asio/steady_timer.hpp>
+#include <asio/dispatch.hpp>
 #include <fmt/chrono.h>
 
 #include <functional>
@@ -52,8 +52,8 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
   using encoded_request_type = typename Request::encoded_request_type;
   using encoded_response_type = typename Request::encoded_response_type;
-  asio::steady_timer deadline;
-  asio::steady_timer retry_backoff;
+  io::wheel_timer deadline;
+  io::wheel_timer retry_backoff;
   Request request;
   encoded_request_type encoded;
   std::optional<std::uint32_t> opaque_{};
@@ -61,23 +61,22 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
   mcbp_command_handler handler_{};
   std::shared_ptr<Manager> manager_{};
   std::chrono::milliseconds timeout_{};
-  std::string id_{ fmt::format("{:02x}/{}",
-                               static_cast<std::uint8_t>(encoded_request_type::body_type::opcode),
-                               uuid::to_string(uuid::random())) };
+  std::uint64_t command_id_{};
   std::shared_ptr<couchbase::tracing::request_span> span_{ nullptr };
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
   std::optional<std::string> last_dispatched_from_{};
   std::optional<std::string> last_dispatched_to_{};
 
-  mcbp_command(asio::io_context& ctx,
+  mcbp_command(io::timing_wheel& wheel,
                std::shared_ptr<Manager> manager,
                Request req,
                std::chrono::milliseconds default_timeout)
-    : deadline(ctx)
-    , retry_backoff(ctx)
+    : deadline(wheel)
+    , retry_backoff(wheel)
     , request(req)
     , manager_(manager)
     , timeout_(request.timeout.value_or(default_timeout))
+    , command_id_(manager_->next_command_id())
   {
     if constexpr (io::mcbp_traits::supports_durability_v<Request>) {
       if (request.durability_level != durability_level::none &&
@@ -87,7 +86,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
           request.id,
           timeout_.count(),
           durability_timeout_floor.count(),
-          id_);
+          id());
         timeout_ = durability_timeout_floor;
       }
     }
@@ -107,12 +106,28 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
     handler_ = std::move(handler);
     deadline.expires_after(timeout_);
-    deadline.async_wait([self = this->shared_from_this()](std::error_code ec) {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->cancel(retry_reason::do_not_retry);
-    });
+    deadline.async_wait<&mcbp_command::on_deadline>(this->shared_from_this());
+  }
+
+  /**
+   * The identifier is only rendered when it is needed for logs or error contexts, and always fits
+   * into the small string buffer.
+   */
+  [[nodiscard]] auto id() const -> std::string
+  {
+    return fmt::format("{:02x}/{:x}",
+                       static_cast<std::uint8_t>(encoded_request_type::body_type::opcode),
+                       command_id_);
+  }
+
+  void on_deadline()
+  {
+    cancel(retry_reason::do_not_retry);
+  }
+
+  void on_retry_backoff()
+  {
+    manager_->map_and_send(this->shared_from_this());
   }
 
   void cancel(retry_reason reason)
@@ -129,6 +144,16 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     );
   }
 
+  /**
+   * The command is owned by the IO context of its timing wheel. The deadline and the retries fire
+   * there, and the responses are moved there from the thread of the session, so that the state of
+   * the command is never touched concurrently, even when the session runs on another IO thread.
+   */
+  [[nodiscard]] auto context() const -> asio::io_context&
+  {
+    return deadline.wheel().get_io_context();
+  }
+
   void invoke_handler(std::error_code ec, std::optional<io::mcbp_message>&& msg = {})
   {
     retry_backoff.cancel();
@@ -149,7 +174,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         auto time_left = deadline.expiry() - std::chrono::steady_clock::now();
         CB_LOG_TRACE(R"([{}] timeout operation id="{}", {}, key="{}", partition={}, time_left={})",
                      session_ ? session_->log_prefix() : manager_->log_prefix(),
-                     id_,
+                     id(),
                      encoded_request_type::body_type::opcode,
                      request.id,
                      request.partition,
@@ -175,26 +200,37 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         retry_reason /* reason */,
         io::mcbp_message&& msg,
         std::optional<key_value_error_map_info> /* error_info */) mutable {
-        if (ec == asio::error::operation_aborted) {
-          return self->invoke_handler(errc::common::ambiguous_timeout);
-        }
-        if (ec == errc::common::collection_not_found) {
-          if (self->request.id.is_collection_resolved()) {
-            return self->invoke_handler(ec);
-          }
-          return self->handle_unknown_collection();
-        }
-        if (ec) {
-          return self->invoke_handler(ec);
-        }
-        protocol::client_response<protocol::get_collection_id_response_body> resp(std::move(msg));
-        self->session_->update_collection_uid(self->request.id.collection_path(),
-                                              resp.body().collection_uid());
-        self->request.id.collection_uid(resp.body().collection_uid());
-        return self->send();
+        auto& ctx = self->context();
+        asio::dispatch(ctx, [self = std::move(self), ec, msg = std::move(msg)]() mutable {
+          self->on_collection_id_response(ec, std::move(msg));
+        });
       });
   }
 
+  void on_collection_id_response(std::error_code ec, io::mcbp_message&& msg)
+  {
+    if (!handler_) {
+      // the deadline has completed the command before the response reached its IO context
+      return;
+    }
+    if (ec == asio::error::operation_aborted) {
+      return invoke_handler(errc::common::ambiguous_timeout);
+    }
+    if (ec == errc::common::collection_not_found) {
+      if (request.id.is_collection_resolved()) {
+        return invoke_handler(ec);
+      }
+      return handle_unknown_collection();
+    }
+    if (ec) {
+      return invoke_handler(ec);
+    }
+    protocol::client_response<protocol::get_collection_id_response_body> resp(std::move(msg));
+    session_->update_collection_uid(request.id.collection_path(), resp.body().collection_uid());
+    request.id.collection_uid(resp.body().collection_uid());
+    return send();
+  }
+
   void handle_unknown_collection()
   {
     auto backoff = std::chrono::milliseconds(500);
@@ -203,7 +239,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
                  session_->log_prefix(),
                  request.id,
                  std::chrono::duration_cast<std::chrono::milliseconds>(time_left).count(),
-                 id_);
+                 id());
     request.retries.add_reason(retry_reason::key_value_collection_outdated);
     if (time_left < backoff) {
       return invoke_handler(make_error_code(request.retries.idempotent()
@@ -211,12 +247,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
                                               : errc::common::ambiguous_timeout));
     }
     retry_backoff.expires_after(backoff);
-    retry_backoff.async_wait([self = this->shared_from_this()](std::error_code ec) mutable {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->request_collection_id();
-    });
+    retry_backoff.async_wait<&mcbp_command::request_collection_id>(this->shared_from_this());
   }
 
   void send()
@@ -236,7 +267,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
             session_->log_prefix(),
             request.id,
             timeout_.count(),
-            id_);
+            id());
           return request_collection_id();
         }
       } else {
@@ -259,98 +290,104 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
     session_->write_and_subscribe(
       request.opaque,
-      encoded.data(session_->supports_feature(protocol::hello_feature::snappy)),
+      session_->supports_feature(protocol::hello_feature::snappy)
+        ? encoded.data(manager_->compressor())
+        : encoded.data(),
       [self = this->shared_from_this(), start = std::chrono::steady_clock::now()](
         std::error_code ec,
         retry_reason reason,
         io::mcbp_message&& msg,
         std::optional<key_value_error_map_info> /* error_info */) mutable {
-        static std::string meter_name = "db.couchbase.operations";
-        static std::map<std::string, std::string> tags = {
-          { "db.couchbase.service", "kv" },
-          { "db.operation", fmt::format("{}", encoded_request_type::body_type::opcode) },
-        };
-        self->manager_->meter()
-          ->get_value_recorder(meter_name, tags)
-          ->record_value(std::chrono::duration_cast<std::chrono::microseconds>(
-                           std::chrono::steady_clock::now() - start)
-                           .count());
+        self->manager_->operation_recorder(encoded_request_type::body_type::opcode)
+          .record_value(std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count());
+        auto& ctx = self->context();
+        asio::dispatch(ctx, [self = std::move(self), ec, reason, msg = std::move(msg)]() mutable {
+          self->on_response(ec, reason, std::move(msg));
+        });
+      });
+  }
 
-        self->retry_backoff.cancel();
-        if (ec == asio::error::operation_aborted) {
-          if (self->span_->uses_tags())
-            self->span_->add_tag(tracing::attributes::orphan, "aborted");
-          return self->invoke_handler(make_error_code(self->request.retries.idempotent()
-                                                        ? errc::common::unambiguous_timeout
-                                                        : errc::common::ambiguous_timeout));
-        }
-        if (ec == errc::common::request_canceled) {
-          if (!self->request.retries.idempotent() && !allows_non_idempotent_retry(reason)) {
-            if (self->span_->uses_tags())
-              self->span_->add_tag(tracing::attributes::orphan, "canceled");
-            return self->invoke_handler(ec);
-          }
-          return io::retry_orchestrator::maybe_retry(self->manager_, self, reason, ec);
-        }
-        key_value_status_code status = key_value_status_code::invalid;
-        std::optional<key_value_error_map_info> error_code{};
-        if (protocol::is_valid_status(msg.header.status())) {
-          status = static_cast<key_value_status_code>(msg.header.status());
-        } else {
-          error_code = self->session_->decode_error_code(msg.header.status());
-        }
-        if (status == key_value_status_code::not_my_vbucket) {
-          return io::retry_orchestrator::maybe_retry(
-            self->manager_, self, retry_reason::key_value_not_my_vbucket, ec);
-        }
-        if (status == key_value_status_code::unknown_collection) {
-          return self->handle_unknown_collection();
-        }
-        if (status == key_value_status_code::config_only) {
-          CB_LOG_DEBUG("{} server returned status 0x{:02x} ({}) meaning that the node does not "
-                       "serve data operations, "
-                       "requesting new "
-                       "configuration and retrying",
-                       self->session_->log_prefix(),
-                       msg.header.status(),
-                       status);
-          self->manager_->fetch_config();
-          return io::retry_orchestrator::maybe_retry(
-            self->manager_, self, retry_reason::service_response_code_indicated, ec);
-        }
-        if (error_code && error_code.value().has_retry_attribute()) {
-          reason = retry_reason::key_value_error_map_retry_indicated;
-        } else {
-          switch (status) {
-            case key_value_status_code::locked:
-              if constexpr (encoded_request_type::body_type::opcode !=
-                            protocol::client_opcode::unlock) {
-                /**
-                 * special case for unlock command, when it should not be retried, because it does
-                 * not make sense (someone else unlocked the document)
-                 */
-                reason = retry_reason::key_value_locked;
-              }
-              break;
-            case key_value_status_code::temporary_failure:
-              reason = retry_reason::key_value_temporary_failure;
-              break;
-            case key_value_status_code::sync_write_in_progress:
-              reason = retry_reason::key_value_sync_write_in_progress;
-              break;
-            case key_value_status_code::sync_write_re_commit_in_progress:
-              reason = retry_reason::key_value_sync_write_re_commit_in_progress;
-              break;
-            default:
-              break;
+  void on_response(std::error_code ec, retry_reason reason, io::mcbp_message&& msg)
+  {
+    if (!handler_) {
+      return;
+    }
+    retry_backoff.cancel();
+    if (ec == asio::error::operation_aborted) {
+      if (span_->uses_tags())
+        span_->add_tag(tracing::attributes::orphan, "aborted");
+      return invoke_handler(make_error_code(request.retries.idempotent()
+                                              ? errc::common::unambiguous_timeout
+                                              : errc::common::ambiguous_timeout));
+    }
+    if (ec == errc::common::request_canceled) {
+      if (!request.retries.idempotent() && !allows_non_idempotent_retry(reason)) {
+        if (span_->uses_tags())
+          span_->add_tag(tracing::attributes::orphan, "canceled");
+        return invoke_handler(ec);
+      }
+      return io::retry_orchestrator::maybe_retry(manager_, this->shared_from_this(), reason, ec);
+    }
+    key_value_status_code status = key_value_status_code::invalid;
+    std::optional<key_value_error_map_info> error_code{};
+    if (protocol::is_valid_status(msg.header.status())) {
+      status = static_cast<key_value_status_code>(msg.header.status());
+    } else {
+      error_code = session_->decode_error_code(msg.header.status());
+    }
+    if (status == key_value_status_code::not_my_vbucket) {
+      return io::retry_orchestrator::maybe_retry(
+        manager_, this->shared_from_this(), retry_reason::key_value_not_my_vbucket, ec);
+    }
+    if (status == key_value_status_code::unknown_collection) {
+      return handle_unknown_collection();
+    }
+    if (status == key_value_status_code::config_only) {
+      CB_LOG_DEBUG("{} server returned status 0x{:02x} ({}) meaning that the node does not "
+                   "serve data operations, "
+                   "requesting new "
+                   "configuration and retrying",
+                   session_->log_prefix(),
+                   msg.header.status(),
+                   status);
+      manager_->fetch_config();
+      return io::retry_orchestrator::maybe_retry(
+        manager_, this->shared_from_this(), retry_reason::service_response_code_indicated, ec);
+    }
+    if (error_code && error_code.value().has_retry_attribute()) {
+      reason = retry_reason::key_value_error_map_retry_indicated;
+    } else {
+      switch (status) {
+        case key_value_status_code::locked:
+          if constexpr (encoded_request_type::body_type::opcode !=
+                        protocol::client_opcode::unlock) {
+            /**
+             * special case for unlock command, when it should not be retried, because it does
+             * not make sense (someone else unlocked the document)
+             */
+            reason = retry_reason::key_value_locked;
           }
-        }
-        if (reason == retry_reason::do_not_retry) {
-          self->invoke_handler(ec, std::move(msg));
-        } else {
-          io::retry_orchestrator::maybe_retry(self->manager_, self, reason, ec);
-        }
-      });
+          break;
+        case key_value_status_code::temporary_failure:
+          reason = retry_reason::key_value_temporary_failure;
+          break;
+        case key_value_status_code::sync_write_in_progress:
+          reason = retry_reason::key_value_sync_write_in_progress;
+          break;
+        case key_value_status_code::sync_write_re_commit_in_progress:
+          reason = retry_reason::key_value_sync_write_re_commit_in_progress;
+          break;
+        default:
+          break;
+      }
+    }
+    if (reason == retry_reason::do_not_retry) {
+      invoke_handler(ec, std::move(msg));
+    } else {
+      io::retry_orchestrator::maybe_retry(manager_, this->shared_from_this(), reason, ec);
+    }
   }
 
   void send_to(io::mcbp_session session)
@@ -36,4 +36,14 @@ mcbp_message::header_data() const -> protocol::header_buffer
   std::memcpy(buf.data(), &header, sizeof(header));
   return buf;
 }
+
+void
+mcbp_message::join_value()
+{
+  if (!value) {
+    return;
+  }
+  body.insert(body.end(), value->begin(), value->end());
+  value.reset();
+}
 } // namespace couchbase::core::io
@@ -19,6 +19,7 @@
 
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace couchbase::core
@@ -48,6 +49,9 @@ struct binary_header {
 struct mcbp_message {
   binary_header header{};
   std::vector<std::byte> body{};
+  // large values might be received separately, then the body holds only framing extras, extras and
+  // key, see mcbp_parser
+  std::optional<std::vector<std::byte>> value{};
 
   mcbp_message() = default;
   mcbp_message(const mcbp_message& other) = delete;
@@ -56,6 +60,11 @@ struct mcbp_message {
   auto operator=(mcbp_message&& other) -> mcbp_message& = default;
 
   [[nodiscard]] auto header_data() const -> protocol::header_buffer;
+
+  /**
+   * Appends separately received value to the body, for the consumers that need the whole frame.
+   */
+  void join_value();
 };
 } // namespace io
 } // namespace couchbase::core
@@ -17,9 +17,12 @@
 
 #include "mcbp_parser.hxx"
 
+#include "core/error_context/key_value_status_code.hxx"
 #include "core/logger/logger.hxx"
+#include "core/protocol/client_opcode.hxx"
 #include "core/protocol/datatype.hxx"
 #include "core/protocol/magic.hxx"
+#include "core/protocol/server_opcode.hxx"
 #include "core/utils/byteswap.hxx"
 
 #include <snappy.h>
@@ -30,56 +33,165 @@
 
 namespace couchbase::core::io
 {
+namespace
+{
+auto
+prefix_size_of(const binary_header& header) -> std::uint32_t
+{
+  if (header.magic == static_cast<std::uint8_t>(protocol::magic::alt_client_response)) {
+    const std::uint8_t framing_extras_size = header.keylen & 0xffU;
+    const auto key_size = static_cast<std::uint32_t>(header.keylen >> 8U);
+    return static_cast<std::uint32_t>(framing_extras_size) +
+           static_cast<std::uint32_t>(header.extlen) + key_size;
+  }
+  return static_cast<std::uint32_t>(header.extlen) + utils::byte_swap(header.keylen);
+}
+
+/**
+ * Only successful responses of the GET family carry the document as the value, the other frames
+ * are consumed as a whole.
+ */
+auto
+has_separable_value(const binary_header& header) -> bool
+{
+  if (header.status() != static_cast<std::uint16_t>(key_value_status_code::success)) {
+    return false;
+  }
+  switch (static_cast<protocol::client_opcode>(header.opcode)) {
+    case protocol::client_opcode::get:
+    case protocol::client_opcode::get_and_lock:
+    case protocol::client_opcode::get_and_touch:
+    case protocol::client_opcode::get_replica:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Replaces the body of the message with the uncompressed version, when the frame has been sent
+ * with snappy datatype. Large values are uncompressed into the separate value of the message.
+ *
+ * @return false if the body could not be uncompressed
+ */
+auto
+uncompress_body(mcbp_message& msg, const std::byte* body, std::uint32_t body_size) -> bool
+{
+  const std::uint32_t prefix_size = prefix_size_of(msg.header);
+  const auto* compressed = reinterpret_cast<const char*>(body + prefix_size);
+  const std::size_t compressed_size = body_size - prefix_size;
+  std::size_t uncompressed_size{ 0 };
+  if (!snappy::GetUncompressedLength(compressed, compressed_size, &uncompressed_size)) {
+    return false;
+  }
+  if (uncompressed_size >= mcbp_parser::direct_body_threshold &&
+      has_separable_value(msg.header)) {
+    std::vector<std::byte> value(uncompressed_size);
+    if (!snappy::RawUncompress(
+          compressed, compressed_size, reinterpret_cast<char*>(value.data()))) {
+      return false;
+    }
+    msg.body.assign(body, body + prefix_size);
+    msg.value = std::move(value);
+  } else {
+    std::vector<std::byte> uncompressed(prefix_size + uncompressed_size);
+    if (!snappy::RawUncompress(compressed,
+                               compressed_size,
+                               reinterpret_cast<char*>(uncompressed.data() + prefix_size))) {
+      return false;
+    }
+    std::memcpy(uncompressed.data(), body, prefix_size);
+    msg.body = std::move(uncompressed);
+  }
+  // patch header with new body size
+  msg.header.bodylen =
+    utils::byte_swap(static_cast<std::uint32_t>(prefix_size + uncompressed_size));
+  return true;
+}
+
+/**
+ * The body of the large frame is allocated before it is received, so its header is checked first.
+ * The client receives only responses and the requests of the server.
+ */
+auto
+is_valid_large_frame(const binary_header& header, std::uint32_t body_size) -> bool
+{
+  if (body_size > mcbp_parser::max_body_size) {
+    return false;
+  }
+  switch (static_cast<protocol::magic>(header.magic)) {
+    case protocol::magic::client_response:
+    case protocol::magic::alt_client_response:
+      return protocol::is_valid_client_opcode(header.opcode);
+    case protocol::magic::server_request:
+      return protocol::is_valid_server_request_opcode(header.opcode);
+    default:
+      return false;
+  }
+}
+
+auto
+is_compressed(const binary_header& header) -> bool
+{
+  return (header.datatype & static_cast<std::uint8_t>(protocol::datatype::snappy)) != 0;
+}
+} // namespace
+
 auto
 mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
 {
   static const std::size_t header_size = 24;
-  if (buf.size() < header_size) {
-    return result::need_data;
+
+  if (pending_) {
+    if (pending_filled_ < receive_target().size()) {
+      return result::need_data;
+    }
+    msg.header = pending_->header;
+    auto body = std::move(pending_->body);
+    msg.value = std::move(pending_->value);
+    pending_.reset();
+    pending_filled_ = 0;
+    if (!is_compressed(msg.header) ||
+        !uncompress_body(msg, body.data(), static_cast<std::uint32_t>(body.size()))) {
+      msg.body = std::move(body);
+    }
+    return result::ok;
   }
-  std::memcpy(&msg.header, buf.data(), header_size);
-  std::uint32_t body_size = utils::byte_swap(msg.header.bodylen);
-  if (body_size > 0 && buf.size() - header_size < body_size) {
+
+  const std::size_t available = buf.size() - offset;
+  if (available < header_size) {
     return result::need_data;
   }
-  msg.body.clear();
-  msg.body.reserve(body_size);
-  std::uint32_t key_size = utils::byte_swap(msg.header.keylen);
-  std::uint32_t prefix_size = static_cast<std::uint32_t>(msg.header.extlen) + key_size;
-  if (msg.header.magic == static_cast<std::uint8_t>(protocol::magic::alt_client_response)) {
-    const std::uint8_t framing_extras_size = msg.header.keylen & 0xffU;
-    key_size = static_cast<std::uint32_t>(msg.header.keylen >> 8U);
-    prefix_size = static_cast<std::uint32_t>(framing_extras_size) +
-                  static_cast<std::uint32_t>(msg.header.extlen) + key_size;
-  }
-  msg.body.insert(
-    msg.body.end(), buf.begin() + header_size, buf.begin() + header_size + prefix_size);
-
-  const bool is_compressed =
-    (msg.header.datatype & static_cast<std::uint8_t>(protocol::datatype::snappy)) != 0;
-  bool use_raw_value = true;
-  if (is_compressed) {
-    std::string uncompressed;
-    const std::size_t offset = header_size + prefix_size;
-    if (snappy::Uncompress(reinterpret_cast<const char*>(buf.data() + offset),
-                           body_size - prefix_size,
-                           &uncompressed)) {
-      msg.body.insert(msg.body.end(),
-                      reinterpret_cast<std::byte*>(uncompressed.data()),
-                      reinterpret_cast<std::byte*>(uncompressed.data() + uncompressed.size()));
-      use_raw_value = false;
-      // patch header with new body size
-      msg.header.bodylen =
-        utils::byte_swap(static_cast<std::uint32_t>(prefix_size + uncompressed.size()));
+  const std::byte* frame = buf.data() + offset;
+  std::memcpy(&msg.header, frame, header_size);
+  std::uint32_t body_size = utils::byte_swap(msg.header.bodylen);
+  if (body_size > 0 && available - header_size < body_size) {
+    if (body_size >= direct_body_threshold) {
+      if (!is_valid_large_frame(msg.header, body_size)) {
+        CB_LOG_WARNING("invalid header of large frame: magic={:x}, opcode={:x}, opaque={}, "
+                       "body_len={}",
+                       msg.header.magic,
+                       msg.header.opcode,
+                       msg.header.opaque,
+                       body_size);
+        reset();
+        return result::failure;
+      }
+      start_pending_frame(msg.header, frame + header_size, available - header_size);
     }
+    return result::need_data;
   }
-  if (use_raw_value) {
-    msg.body.insert(msg.body.end(),
-                    buf.begin() + header_size + prefix_size,
-                    buf.begin() + header_size + body_size);
+  const std::byte* body = frame + header_size;
+  msg.value.reset();
+  if (!is_compressed(msg.header) || !uncompress_body(msg, body, body_size)) {
+    msg.body.assign(body, body + body_size);
   }
-  buf.erase(buf.begin(), buf.begin() + header_size + body_size);
-  if (!buf.empty() && !protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[0]))) {
+  offset += header_size + body_size;
+  if (offset == buf.size()) {
+    // everything has been consumed, so the next feed does not need to move anything
+    buf.clear();
+    offset = 0;
+  } else if (!protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[offset]))) {
     CB_LOG_WARNING("parsed frame for magic={:x}, opcode={:x}, opaque={}, body_len={}. Invalid "
                    "magic of the next frame: {:x}, {} "
                    "bytes to parse{}",
@@ -87,11 +199,41 @@ mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
                    msg.header.opcode,
                    msg.header.opaque,
                    body_size,
-                   buf[0],
-                   buf.size(),
-                   spdlog::to_hex(buf));
+                   buf[offset],
+                   buf.size() - offset,
+                   spdlog::to_hex(buf.begin() + static_cast<std::ptrdiff_t>(offset), buf.end()));
     reset();
   }
   return result::ok;
 }
+
+void
+mcbp_parser::start_pending_frame(const binary_header& header,
+                                 const std::byte* received,
+                                 std::size_t received_size)
+{
+  const std::uint32_t body_size = utils::byte_swap(header.bodylen);
+  const std::uint32_t prefix_size = prefix_size_of(header);
+  const bool separate_value = !is_compressed(header) && has_separable_value(header);
+  if (separate_value && received_size < prefix_size) {
+    // the value can only be separated once extras and key are here, keep buffering until then
+    return;
+  }
+
+  // move what we have into the message, the rest of the frame will be received directly into it
+  pending_.emplace();
+  pending_->header = header;
+  if (separate_value) {
+    pending_->body.assign(received, received + prefix_size);
+    pending_->value.emplace(body_size - prefix_size);
+    received += prefix_size;
+    received_size -= prefix_size;
+  } else {
+    pending_->body.resize(body_size);
+  }
+  std::memcpy(receive_target().data(), received, received_size);
+  pending_filled_ = received_size;
+  buf.clear();
+  offset = 0;
+}
 } // namespace couchbase::core::io
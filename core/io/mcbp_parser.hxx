@@ -19,11 +19,37 @@
 
 #include "mcbp_message.hxx"
 
+#include <gsl/span>
+
+#include <algorithm>
+#include <cstring>
 #include <iterator>
+#include <optional>
 
 namespace couchbase::core::io
 {
+/**
+ * Incremental parser for the MCBP frames.
+ *
+ * Frames are decoded in place starting from the read cursor, which is advanced after every parsed
+ * frame. The bytes behind the cursor are reclaimed lazily, only when new data is fed into the
+ * parser, so the cost of compaction is paid once per socket read and not once per frame.
+ *
+ * Frames with bodies of at least direct_body_threshold bytes are assembled directly in the resulting
+ * message. While such frame is incomplete, body_receive_buffer() exposes its unfilled tail, so that
+ * the socket could read into it without intermediate copies. For the successful responses of the
+ * GET family, the value is received into mcbp_message::value, separately from the framing extras,
+ * extras and key, so that it could be handed over to the response as is.
+ */
 struct mcbp_parser {
+  static constexpr std::size_t direct_body_threshold = 64 * 1024;
+  /**
+   * The largest document (20 MiB) together with its extended attributes (1 MiB), key and extras.
+   * Larger bodies can only come from the corrupted header, the parser fails instead of allocating
+   * them.
+   */
+  static constexpr std::size_t max_body_size = 22 * 1024 * 1024;
+
   enum class result {
     ok,
     need_data,
@@ -33,17 +59,85 @@ struct mcbp_parser {
   template<typename Iterator>
   void feed(Iterator begin, Iterator end)
   {
-    buf.reserve(buf.size() + static_cast<std::size_t>(std::distance(begin, end)));
+    if (pending_) {
+      auto window = body_receive_buffer();
+      auto size = std::min(window.size(), static_cast<std::size_t>(std::distance(begin, end)));
+      std::copy_n(begin, size, window.begin());
+      pending_filled_ += size;
+      std::advance(begin, size);
+    }
+    compact();
     buf.insert(buf.end(), begin, end);
   }
 
+  /**
+   * @return unfilled part of the body of the incomplete large frame, or empty span if the parser
+   * does not assemble any frame directly.
+   */
+  [[nodiscard]] auto body_receive_buffer() -> gsl::span<std::byte>
+  {
+    if (!pending_) {
+      return {};
+    }
+    auto& target = receive_target();
+    return { target.data() + pending_filled_, target.size() - pending_filled_ };
+  }
+
+  /**
+   * Marks bytes that have been written into body_receive_buffer() as received.
+   */
+  void commit_body(std::size_t bytes)
+  {
+    if (pending_) {
+      pending_filled_ = std::min(pending_filled_ + bytes, receive_target().size());
+    }
+  }
+
   void reset()
   {
     buf.clear();
+    offset = 0;
+    pending_.reset();
+    pending_filled_ = 0;
+  }
+
+  /**
+   * @return number of bytes received, but not yet consumed by the parser
+   */
+  [[nodiscard]] auto pending_bytes() const -> std::size_t
+  {
+    return buf.size() - offset + pending_filled_;
   }
 
   auto next(mcbp_message& msg) -> result;
 
   std::vector<std::byte> buf;
+  std::size_t offset{ 0 };
+
+private:
+  void start_pending_frame(const binary_header& header,
+                           const std::byte* received,
+                           std::size_t received_size);
+
+  [[nodiscard]] auto receive_target() -> std::vector<std::byte>&
+  {
+    return pending_->value ? *pending_->value : pending_->body;
+  }
+
+  void compact()
+  {
+    if (offset == 0) {
+      return;
+    }
+    if (offset < buf.size()) {
+      // only the tail of the partially received frame has to be moved
+      std::memmove(buf.data(), buf.data() + offset, buf.size() - offset);
+    }
+    buf.resize(buf.size() - offset);
+    offset = 0;
+  }
+
+  std::optional<mcbp_message> pending_{};
+  std::size_t pending_filled_{ 0 };
 };
 } // namespace couchbase::core::io
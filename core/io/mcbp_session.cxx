@@ -50,9 +50,12 @@
 #include "core/sasl/error_fmt.h"
 #include "core/topology/capabilities_fmt.hxx"
 #include "core/topology/configuration_fmt.hxx"
+#include "core/utils/byte_buffer_pool.hxx"
+#include "adaptive_read_buffer.hxx"
 #include "mcbp_context.hxx"
 #include "mcbp_message.hxx"
 #include "mcbp_parser.hxx"
+#include "opaque_table.hxx"
 #include "retry_orchestrator.hxx"
 #include "streams.hxx"
 
@@ -209,6 +212,20 @@ public:
   }
 };
 
+/**
+ * Handler of the command waiting for the response, together with the size of its request, that is
+ * accounted as outstanding until the response arrives.
+ */
+struct pending_command {
+  command_handler handler{};
+  std::size_t size{ 0 };
+
+  explicit operator bool() const
+  {
+    return static_cast<bool>(handler);
+  }
+};
+
 class mcbp_session_impl
   : public std::enable_shared_from_this<mcbp_session_impl>
   , public operation_map
@@ -871,6 +888,8 @@ public:
     , connection_deadline_(ctx_)
     , retry_backoff_(ctx_)
     , ping_deadline_(ctx_)
+    , write_coalescing_timer_(ctx_)
+    , read_buffer_release_timer_(ctx_)
     , origin_{ std::move(origin) }
     , bucket_name_{ std::move(bucket_name) }
     , supported_features_{ std::move(known_features) }
@@ -897,6 +916,8 @@ public:
     , connection_deadline_(ctx_)
     , retry_backoff_(ctx_)
     , ping_deadline_(ctx_)
+    , write_coalescing_timer_(ctx_)
+    , read_buffer_release_timer_(ctx_)
     , origin_(std::move(origin))
     , bucket_name_(std::move(bucket_name))
     , supported_features_(std::move(known_features))
@@ -945,7 +966,24 @@ public:
              remote_address(),
              local_address(),
              state_,
-             bucket_name_ };
+             bucket_name_,
+             fmt::format("outstanding_requests={}, outstanding_bytes={}, read_buffer_size={}, "
+                         "reads={}, bytes_read={}, writes={}, packets_per_write={:.2f}, "
+                         "bytes_per_write={:.2f}",
+                         outstanding_requests(),
+                         outstanding_bytes(),
+                         read_buffer_size_.load(),
+                         reads_.load(),
+                         bytes_read_.load(),
+                         writes_.load(),
+                         per_write(packets_written_.load()),
+                         per_write(bytes_written_.load())) };
+  }
+
+  [[nodiscard]] auto per_write(std::uint64_t total) const -> double
+  {
+    const auto writes = writes_.load();
+    return writes == 0 ? 0.0 : static_cast<double>(total) / static_cast<double>(writes);
   }
 
   void ping(const std::shared_ptr<diag::ping_reporter>& handler,
@@ -1181,6 +1219,8 @@ public:
     connection_deadline_.cancel();
     retry_backoff_.cancel();
     ping_deadline_.cancel();
+    write_coalescing_timer_.cancel();
+    read_buffer_release_timer_.cancel();
     resolver_.cancel();
     stream_->close([](std::error_code) {
     });
@@ -1196,23 +1236,21 @@ public:
         h(ec, {});
       }
     }
-    {
-      const std::scoped_lock lock(command_handlers_mutex_);
-      for (auto& [opaque, handler] : command_handlers_) {
-        if (handler) {
-          CB_LOG_DEBUG("{} MCBP cancel operation during session close, opaque={}, ec={}",
-                       log_prefix_,
-                       opaque,
-                       ec.message());
-          auto fun = std::move(handler);
-          fun(ec, reason, {}, {});
-        }
+    for (auto& [opaque, command] : command_handlers_.take_all()) {
+      outstanding_requests_.fetch_sub(1, std::memory_order_relaxed);
+      outstanding_bytes_.fetch_sub(command.size, std::memory_order_relaxed);
+      if (auto& handler = command.handler; handler) {
+        CB_LOG_DEBUG("{} MCBP cancel operation during session close, opaque={}, ec={}",
+                     log_prefix_,
+                     opaque,
+                     ec.message());
+        handler(ec, reason, {}, {});
       }
-      command_handlers_.clear();
     }
     {
       const std::scoped_lock lock(operations_mutex_);
       auto operations = std::move(operations_);
+      outstanding_requests_.fetch_sub(operations.size(), std::memory_order_relaxed);
       for (auto& [opaque, operation] : operations) {
         auto& [request, handler] = operation;
         if (handler) {
@@ -1244,7 +1282,15 @@ public:
     }
     CB_LOG_TRACE("{} MCBP send {}", log_prefix_, mcbp_header_view(buf));
     const std::scoped_lock lock(output_buffer_mutex_);
-    output_buffer_.emplace_back(std::move(buf));
+    ++output_packets_;
+    output_size_ += buf.size();
+    if (buf.size() >= write_coalescing_threshold()) {
+      // large values are written from their own buffer, instead of being copied
+      output_large_packets_.push_back({ output_buffer_.size(), std::move(buf) });
+      return;
+    }
+    output_buffer_.insert(output_buffer_.end(), buf.begin(), buf.end());
+    utils::byte_buffer_pool::local().release(std::move(buf));
   }
 
   void flush()
@@ -1263,7 +1309,50 @@ public:
       return;
     }
     write(std::move(buf));
-    flush();
+    if (corked_ > 0) {
+      return;
+    }
+    const auto delay = origin_.options().key_value_write_coalescing_delay;
+    if (delay.count() <= 0 || pending_output_size() >= write_coalescing_threshold()) {
+      return flush();
+    }
+    if (write_coalescing_armed_.exchange(true)) {
+      // the packet will leave with the ones already waiting for the timer
+      return;
+    }
+    asio::post(asio::bind_executor(ctx_, [self = shared_from_this(), delay]() {
+      self->write_coalescing_timer_.expires_after(delay);
+      self->write_coalescing_timer_.async_wait([self](std::error_code ec) {
+        if (ec == asio::error::operation_aborted) {
+          return;
+        }
+        self->write_coalescing_armed_ = false;
+        self->do_write();
+      });
+    }));
+  }
+
+  [[nodiscard]] auto pending_output_size() -> std::size_t
+  {
+    const std::scoped_lock lock(output_buffer_mutex_);
+    return output_size_;
+  }
+
+  [[nodiscard]] auto write_coalescing_threshold() const -> std::size_t
+  {
+    return std::max<std::size_t>(1, origin_.options().key_value_write_coalescing_threshold);
+  }
+
+  void cork()
+  {
+    ++corked_;
+  }
+
+  void uncork()
+  {
+    if (--corked_ == 0) {
+      flush();
+    }
   }
 
   void remove_request(std::shared_ptr<mcbp::queue_request> request) override
@@ -1271,6 +1360,7 @@ public:
     const std::scoped_lock lock(operations_mutex_);
     if (auto iter = operations_.find(request->opaque_); iter != operations_.end()) {
       operations_.erase(iter);
+      outstanding_requests_.fetch_sub(1, std::memory_order_relaxed);
     }
   }
 
@@ -1280,7 +1370,9 @@ public:
   {
     const std::scoped_lock lock(operations_mutex_);
     request->waiting_in_ = this;
-    operations_.try_emplace(opaque, request, handler);
+    if (operations_.try_emplace(opaque, request, handler).second) {
+      outstanding_requests_.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   auto handle_request(protocol::client_opcode opcode,
@@ -1289,15 +1381,7 @@ public:
                       mcbp_message&& msg) -> bool
   {
     // handle request old style
-    command_handler fun{};
-    {
-      const std::scoped_lock lock(command_handlers_mutex_);
-      if (auto handler = command_handlers_.find(opaque);
-          handler != command_handlers_.end() && handler->second) {
-        fun = std::move(handler->second);
-        command_handlers_.erase(handler);
-      }
-    }
+    command_handler fun = take_command_handler(opaque);
 
     auto reason = status == static_cast<std::uint16_t>(key_value_status_code::not_my_vbucket)
                     ? retry_reason::key_value_not_my_vbucket
@@ -1320,6 +1404,7 @@ public:
         handler = pair->second.second;
         if (!request->persistent_) {
           operations_.erase(pair);
+          outstanding_requests_.fetch_sub(1, std::memory_order_relaxed);
         }
       }
     }
@@ -1366,7 +1451,7 @@ public:
       if (bootstrapped_ && stream_->is_open()) {
         write_and_flush(std::move(data.value()));
       } else {
-        pending_buffer_.emplace_back(data.value());
+        pending_buffer_.emplace_back(std::move(data.value()));
       }
     }
   }
@@ -1382,10 +1467,18 @@ public:
       handler(errc::common::request_canceled, retry_reason::socket_closed_while_in_flight, {}, {});
       return;
     }
-    {
-      const std::scoped_lock lock(command_handlers_mutex_);
-      command_handlers_.try_emplace(opaque, std::move(handler));
+    if (pending_command pending{ std::move(handler), data.size() };
+        !command_handlers_.insert(opaque, std::move(pending))) {
+      CB_LOG_ERROR("{} MCBP reject operation, the opaque is already in flight, opaque={}",
+                   log_prefix_,
+                   opaque);
+      // rejected handler has not been moved from
+      // NOLINTNEXTLINE(bugprone-use-after-move)
+      pending.handler(errc::common::invalid_argument, retry_reason::do_not_retry, {}, {});
+      return;
     }
+    outstanding_requests_.fetch_add(1, std::memory_order_relaxed);
+    outstanding_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
     if (bootstrapped_ && stream_->is_open()) {
       write_and_flush(std::move(data));
     } else {
@@ -1396,32 +1489,45 @@ public:
       if (bootstrapped_ && stream_->is_open()) {
         write_and_flush(std::move(data));
       } else {
-        pending_buffer_.emplace_back(data);
+        pending_buffer_.emplace_back(std::move(data));
       }
     }
   }
 
+  [[nodiscard]] auto take_command_handler(std::uint32_t opaque) -> command_handler
+  {
+    auto command = command_handlers_.take(opaque);
+    if (command) {
+      outstanding_requests_.fetch_sub(1, std::memory_order_relaxed);
+      outstanding_bytes_.fetch_sub(command.size, std::memory_order_relaxed);
+    }
+    return std::move(command.handler);
+  }
+
+  [[nodiscard]] auto outstanding_requests() const -> std::size_t
+  {
+    return outstanding_requests_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto outstanding_bytes() const -> std::size_t
+  {
+    return outstanding_bytes_.load(std::memory_order_relaxed);
+  }
+
   [[nodiscard]] auto cancel(std::uint32_t opaque, std::error_code ec, retry_reason reason) -> bool
   {
     if (stopped_) {
       return false;
     }
-    command_handlers_mutex_.lock();
-    if (auto handler = command_handlers_.find(opaque); handler != command_handlers_.end()) {
+    if (auto fun = take_command_handler(opaque); fun) {
       CB_LOG_DEBUG("{} MCBP cancel operation, opaque={}, ec={} ({})",
                    log_prefix_,
                    opaque,
                    ec.value(),
                    ec.message());
-      if (handler->second) {
-        auto fun = std::move(handler->second);
-        command_handlers_.erase(handler);
-        command_handlers_mutex_.unlock();
-        fun(ec, reason, {}, {});
-        return true;
-      }
+      fun(ec, reason, {}, {});
+      return true;
     }
-    command_handlers_mutex_.unlock();
     return false;
   }
 
@@ -1878,10 +1984,17 @@ private:
       return;
     }
     reading_ = true;
+    // when the parser assembles large frame, let the socket fill the message body directly
+    auto body_buffer = parser_.body_receive_buffer();
+    const bool direct_read = !body_buffer.empty();
+    const asio::mutable_buffer buffer =
+      direct_read ? asio::buffer(body_buffer.data(), body_buffer.size())
+                  : asio::buffer(read_buffer_.data(), read_buffer_.size());
+    auto* read_buffer = static_cast<const std::byte*>(buffer.data());
     stream_->async_read_some(
-      asio::buffer(input_buffer_),
-      [self = shared_from_this(), stream_id = stream_->id()](std::error_code ec,
-                                                             std::size_t bytes_transferred) {
+      buffer,
+      [self = shared_from_this(), stream_id = stream_->id(), direct_read, read_buffer](
+        std::error_code ec, std::size_t bytes_transferred) {
         if (ec == asio::error::operation_aborted || self->stopped_) {
           CB_LOG_PROTOCOL("[MCBP, IN] host=\"{}\", port={}, rc={}, bytes_received={}",
                           self->connection_endpoints_.remote_address,
@@ -1895,8 +2008,8 @@ private:
                         self->connection_endpoints_.remote.port(),
                         ec ? ec.message() : "ok",
                         bytes_transferred,
-                        spdlog::to_hex(self->input_buffer_.data(),
-                                       self->input_buffer_.data() +
+                        spdlog::to_hex(read_buffer,
+                                       read_buffer +
                                          static_cast<std::ptrdiff_t>(bytes_transferred)));
 
         self->last_active_ = std::chrono::steady_clock::now();
@@ -1918,9 +2031,19 @@ private:
                        ec.message());
           return self->stop(retry_reason::socket_closed_while_in_flight);
         }
-        self->parser_.feed(self->input_buffer_.data(),
-                           self->input_buffer_.data() +
-                             static_cast<std::ptrdiff_t>(bytes_transferred));
+        ++self->reads_;
+        self->bytes_read_ += bytes_transferred;
+        if (direct_read) {
+          self->parser_.commit_body(bytes_transferred);
+        } else {
+          self->parser_.feed(self->read_buffer_.data(),
+                             self->read_buffer_.data() +
+                               static_cast<std::ptrdiff_t>(bytes_transferred));
+          if (self->read_buffer_.on_read(bytes_transferred,
+                                         self->origin_.options().max_key_value_read_buffer_size)) {
+            self->on_read_buffer_resized();
+          }
+        }
 
         for (;;) {
           mcbp_message msg{};
@@ -1942,6 +2065,11 @@ private:
             } break;
             case mcbp_parser::result::need_data:
               self->reading_ = false;
+              if (self->parser_.pending_bytes() == 0 && self->outstanding_requests() == 0 &&
+                  self->read_buffer_.on_idle()) {
+                // nothing is in flight, release the grown buffer unless the traffic resumes soon
+                self->schedule_read_buffer_release();
+              }
               if (!self->stopped_ && self->stream_->is_open()) {
                 self->do_read();
               }
@@ -1953,25 +2081,70 @@ private:
       });
   }
 
+  void on_read_buffer_resized()
+  {
+    CB_LOG_TRACE("{} resized read buffer from {} to {} bytes",
+                 log_prefix_,
+                 read_buffer_size_.load(),
+                 read_buffer_.capacity());
+    read_buffer_size_ = read_buffer_.capacity();
+  }
+
+  /**
+   * Every idle point re-arms the timer, so the buffer is released only when no read has completed
+   * for the whole delay.
+   */
+  void schedule_read_buffer_release()
+  {
+    read_buffer_release_timer_.expires_after(read_buffer_release_delay);
+    read_buffer_release_timer_.async_wait([self = shared_from_this()](std::error_code ec) {
+      if (ec == asio::error::operation_aborted || self->stopped_) {
+        return;
+      }
+      if (self->outstanding_requests() == 0 && self->read_buffer_.release()) {
+        self->on_read_buffer_resized();
+      }
+    });
+  }
+
   void do_write()
   {
     if (stopped_ || !stream_->is_open()) {
       return;
     }
     const std::scoped_lock lock(writing_buffer_mutex_, output_buffer_mutex_);
-    if (!writing_buffer_.empty() || output_buffer_.empty()) {
+    if (writing_packets_ > 0 || output_packets_ == 0) {
       return;
     }
     std::swap(writing_buffer_, output_buffer_);
-    std::vector<asio::const_buffer> buffers;
-    buffers.reserve(writing_buffer_.size());
-    for (auto& buf : writing_buffer_) {
-      CB_LOG_PROTOCOL("[MCBP, OUT] host=\"{}\", port={}, buffer_size={}{:a}",
-                      connection_endpoints_.remote_address,
-                      connection_endpoints_.remote.port(),
-                      buf.size(),
-                      spdlog::to_hex(buf));
-      buffers.emplace_back(asio::buffer(buf));
+    std::swap(writing_large_packets_, output_large_packets_);
+    std::swap(writing_packets_, output_packets_);
+    const auto writing_size = std::exchange(output_size_, 0);
+    ++writes_;
+    packets_written_ += writing_packets_;
+    bytes_written_ += writing_size;
+    CB_LOG_PROTOCOL(
+      "[MCBP, OUT] host=\"{}\", port={}, packets={}, large_packets={}, buffer_size={}{:a}",
+      connection_endpoints_.remote_address,
+      connection_endpoints_.remote.port(),
+      writing_packets_,
+      writing_large_packets_.size(),
+      writing_size,
+      spdlog::to_hex(writing_buffer_));
+    // interleave the large packets with the slices of the contiguous buffer, that precede them
+    std::vector<asio::const_buffer> buffers{};
+    buffers.reserve(2 * writing_large_packets_.size() + 1);
+    std::size_t offset{ 0 };
+    for (const auto& [position, packet] : writing_large_packets_) {
+      if (position > offset) {
+        buffers.emplace_back(asio::buffer(writing_buffer_.data() + offset, position - offset));
+        offset = position;
+      }
+      buffers.emplace_back(asio::buffer(packet));
+    }
+    if (writing_buffer_.size() > offset) {
+      buffers.emplace_back(
+        asio::buffer(writing_buffer_.data() + offset, writing_buffer_.size() - offset));
     }
     stream_->async_write(
       buffers, [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
@@ -1995,7 +2168,14 @@ private:
         }
         {
           const std::scoped_lock inner_lock(self->writing_buffer_mutex_);
-          self->writing_buffer_.clear();
+          if (self->writing_buffer_.capacity() > max_retained_write_buffer_size) {
+            // do not hold on to the memory of an exceptionally large burst
+            self->writing_buffer_ = {};
+          } else {
+            self->writing_buffer_.clear();
+          }
+          self->writing_large_packets_.clear();
+          self->writing_packets_ = 0;
         }
         asio::post(asio::bind_executor(self->ctx_, [self]() {
           self->do_write();
@@ -2013,6 +2193,8 @@ private:
   asio::steady_timer connection_deadline_;
   asio::steady_timer retry_backoff_;
   asio::steady_timer ping_deadline_;
+  asio::steady_timer write_coalescing_timer_;
+  asio::steady_timer read_buffer_release_timer_;
   couchbase::core::origin origin_;
   std::optional<std::string> bucket_name_;
   mcbp_parser parser_;
@@ -2021,13 +2203,19 @@ private:
   std::shared_ptr<message_handler> handler_{ nullptr };
   utils::movable_function<void(std::error_code, const topology::configuration&)>
     bootstrap_callback_{};
-  std::mutex command_handlers_mutex_{};
-  std::map<std::uint32_t, command_handler> command_handlers_{};
+  opaque_table<pending_command> command_handlers_{};
+  // requests written or queued by this session, that are still waiting for the response
+  std::atomic<std::size_t> outstanding_requests_{ 0 };
+  std::atomic<std::size_t> outstanding_bytes_{ 0 };
   std::vector<std::shared_ptr<config_listener>> config_listeners_{};
   utils::movable_function<void()> on_stop_handler_{};
 
   std::atomic_bool bootstrapped_{ false };
   std::atomic_bool stopped_{ false };
+  // while positive, written packets stay in output_buffer_ until the last uncork() flushes them
+  std::atomic_int corked_{ 0 };
+  // set while the write coalescing timer is pending, so that only the first packet arms it
+  std::atomic_bool write_coalescing_armed_{ false };
   bool authenticated_{ false };
   bool bucket_selected_{ false };
   bool supports_gcccp_{ true };
@@ -2035,10 +2223,30 @@ private:
 
   std::atomic<std::uint32_t> opaque_{ 0 };
 
-  std::array<std::byte, 16384> input_buffer_{};
-  std::vector<std::vector<std::byte>> output_buffer_{};
+  static constexpr std::chrono::milliseconds read_buffer_release_delay{ 1'000 };
+  adaptive_read_buffer read_buffer_{};
+  std::atomic<std::size_t> read_buffer_size_{ adaptive_read_buffer::min_size };
+  std::atomic<std::uint64_t> reads_{ 0 };
+  std::atomic<std::uint64_t> bytes_read_{ 0 };
+  static constexpr std::size_t max_retained_write_buffer_size{ 1024 * 1024 };
+  // packets are appended to the contiguous output buffer, which is swapped with the writing buffer
+  // for every socket write, so both keep their capacity between the writes
+  std::vector<std::byte> output_buffer_{};
+  // packets not smaller than the write coalescing threshold, with their offset in output_buffer_
+  struct large_packet {
+    std::size_t position;
+    std::vector<std::byte> data;
+  };
+  std::vector<large_packet> output_large_packets_{};
+  std::size_t output_packets_{ 0 };
+  std::size_t output_size_{ 0 };
   std::vector<std::vector<std::byte>> pending_buffer_{};
-  std::vector<std::vector<std::byte>> writing_buffer_{};
+  std::vector<std::byte> writing_buffer_{};
+  std::vector<large_packet> writing_large_packets_{};
+  std::size_t writing_packets_{ 0 };
+  std::atomic<std::uint64_t> writes_{ 0 };
+  std::atomic<std::uint64_t> packets_written_{ 0 };
+  std::atomic<std::uint64_t> bytes_written_{ 0 };
   std::mutex output_buffer_mutex_{};
   std::mutex pending_buffer_mutex_{};
   std::mutex writing_buffer_mutex_{};
@@ -2132,6 +2340,18 @@ mcbp_session::is_bootstrapped() const -> bool
   return impl_->is_bootstrapped();
 }
 
+auto
+mcbp_session::outstanding_requests() const -> std::size_t
+{
+  return impl_->outstanding_requests();
+}
+
+auto
+mcbp_session::outstanding_bytes() const -> std::size_t
+{
+  return impl_->outstanding_bytes();
+}
+
 auto
 mcbp_session::next_opaque() -> std::uint32_t
 {
@@ -2318,6 +2538,18 @@ mcbp_session::write_and_flush(std::vector<std::byte>&& buffer)
   return impl_->write_and_flush(std::move(buffer));
 }
 
+void
+mcbp_session::cork()
+{
+  return impl_->cork();
+}
+
+void
+mcbp_session::uncork()
+{
+  return impl_->uncork();
+}
+
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
 void
 mcbp_session::add_background_bootstrap_listener(
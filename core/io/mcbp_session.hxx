@@ -108,6 +108,11 @@ public:
   [[nodiscard]] auto cancel(std::uint32_t opaque, std::error_code ec, retry_reason reason) -> bool;
   [[nodiscard]] auto is_stopped() const -> bool;
   [[nodiscard]] auto is_bootstrapped() const -> bool;
+  /**
+   * Number and total size of the requests, that are waiting for the response on this connection.
+   */
+  [[nodiscard]] auto outstanding_requests() const -> std::size_t;
+  [[nodiscard]] auto outstanding_bytes() const -> std::size_t;
   [[nodiscard]] auto next_opaque() -> std::uint32_t;
   [[nodiscard]] auto get_collection_uid(const std::string& collection_path)
     -> std::optional<std::uint32_t>;
@@ -124,6 +129,12 @@ public:
   [[nodiscard]] auto last_bootstrap_error() && -> std::optional<impl::bootstrap_error>;
   [[nodiscard]] auto last_bootstrap_error() const& -> const std::optional<impl::bootstrap_error>&;
   void write_and_flush(std::vector<std::byte>&& buffer);
+  /**
+   * Holds back flushing of the written packets until the matching uncork(), so that a batch of
+   * commands leaves in a single write.
+   */
+  void cork();
+  void uncork();
   void write_and_subscribe(const std::shared_ptr<mcbp::queue_request>&,
                            const std::shared_ptr<response_handler>& handler);
   void write_and_subscribe(std::uint32_t opaque,
@@ -0,0 +1,181 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <gsl/assert>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Maps opaque of the in-flight request to its handler.
+ *
+ * Opaques are allocated from monotonically increasing per-session counter, so the low bits of the
+ * opaque select the slot directly. Every slot carries a state word (opaque and a tag), and both
+ * insertion and removal claim the slot with a single compare-and-swap, so the lookup on the IO
+ * thread never blocks and never allocates.
+ *
+ * When the slot is still occupied by an older request (more requests in flight than the table
+ * has slots), the handler goes to the overflow map protected by the mutex. The overflow map is
+ * only consulted when it is not empty.
+ */
+template<typename Handler>
+class opaque_table
+{
+public:
+  static constexpr std::size_t default_capacity{ 1024 };
+
+  explicit opaque_table(std::size_t capacity = default_capacity)
+    : mask_{ capacity - 1 }
+    , slots_{ std::make_unique<slot[]>(capacity) }
+  {
+    Expects(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  }
+
+  opaque_table(const opaque_table&) = delete;
+  opaque_table(opaque_table&&) = delete;
+  auto operator=(const opaque_table&) -> opaque_table& = delete;
+  auto operator=(opaque_table&&) -> opaque_table& = delete;
+  ~opaque_table() = default;
+
+  [[nodiscard]] auto capacity() const -> std::size_t
+  {
+    return mask_ + 1;
+  }
+
+  /**
+   * Registers handler for the opaque.
+   *
+   * @return false if the opaque already has a handler. The existing handler is left untouched,
+   * and the given one is not moved from.
+   */
+  auto insert(std::uint32_t opaque, Handler&& handler) -> bool
+  {
+    auto& s = slots_[opaque & mask_];
+    std::uint64_t expected = empty_state;
+    if (s.state.compare_exchange_strong(expected, make_state(opaque, tag_busy))) {
+      s.handler = std::move(handler);
+      s.state.store(make_state(opaque, tag_ready), std::memory_order_release);
+      return true;
+    }
+    if ((expected >> tag_bits) == opaque) {
+      // the slot is held by the same opaque, the overflow map must not get the second handler
+      return false;
+    }
+    const std::scoped_lock lock(overflow_mutex_);
+    if (!overflow_.try_emplace(opaque, std::move(handler)).second) {
+      return false;
+    }
+    overflow_size_.fetch_add(1);
+    return true;
+  }
+
+  /**
+   * Removes and returns handler registered for the opaque. Returns empty handler when it does not
+   * exist or has been already taken.
+   */
+  [[nodiscard]] auto take(std::uint32_t opaque) -> Handler
+  {
+    auto& s = slots_[opaque & mask_];
+    std::uint64_t expected = make_state(opaque, tag_ready);
+    if (s.state.compare_exchange_strong(expected, make_state(opaque, tag_busy))) {
+      Handler handler = std::move(s.handler);
+      s.handler = Handler{};
+      s.state.store(empty_state, std::memory_order_release);
+      return handler;
+    }
+    if (overflow_size_.load() == 0) {
+      return {};
+    }
+    const std::scoped_lock lock(overflow_mutex_);
+    if (auto it = overflow_.find(opaque); it != overflow_.end()) {
+      Handler handler = std::move(it->second);
+      overflow_.erase(it);
+      overflow_size_.fetch_sub(1);
+      return handler;
+    }
+    return {};
+  }
+
+  /**
+   * Removes all registered handlers, and returns them ordered by opaque.
+   */
+  [[nodiscard]] auto take_all() -> std::vector<std::pair<std::uint32_t, Handler>>
+  {
+    std::map<std::uint32_t, Handler> handlers;
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      auto& s = slots_[i];
+      auto state = s.state.load(std::memory_order_acquire);
+      if ((state & tag_mask) != tag_ready) {
+        continue;
+      }
+      if (s.state.compare_exchange_strong(state, (state & ~tag_mask) | tag_busy)) {
+        handlers.try_emplace(static_cast<std::uint32_t>(state >> tag_bits), std::move(s.handler));
+        s.handler = Handler{};
+        s.state.store(empty_state, std::memory_order_release);
+      }
+    }
+    {
+      const std::scoped_lock lock(overflow_mutex_);
+      for (auto& [opaque, handler] : overflow_) {
+        handlers.try_emplace(opaque, std::move(handler));
+      }
+      overflow_size_.fetch_sub(overflow_.size());
+      overflow_.clear();
+    }
+    std::vector<std::pair<std::uint32_t, Handler>> result;
+    result.reserve(handlers.size());
+    for (auto& [opaque, handler] : handlers) {
+      result.emplace_back(opaque, std::move(handler));
+    }
+    return result;
+  }
+
+private:
+  static constexpr std::uint64_t tag_bits{ 2 };
+  static constexpr std::uint64_t tag_mask{ (1U << tag_bits) - 1 };
+  static constexpr std::uint64_t tag_busy{ 1 };
+  static constexpr std::uint64_t tag_ready{ 2 };
+  static constexpr std::uint64_t empty_state{ 0 };
+
+  static constexpr auto make_state(std::uint32_t opaque, std::uint64_t tag) -> std::uint64_t
+  {
+    return (static_cast<std::uint64_t>(opaque) << tag_bits) | tag;
+  }
+
+  struct slot {
+    std::atomic<std::uint64_t> state{ empty_state };
+    Handler handler{};
+  };
+
+  std::size_t mask_;
+  std::unique_ptr<slot[]> slots_;
+
+  std::atomic<std::size_t> overflow_size_{ 0 };
+  std::mutex overflow_mutex_{};
+  std::map<std::uint32_t, Handler> overflow_{};
+};
+} // namespace couchbase::core::io
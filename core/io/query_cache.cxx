@@ -0,0 +1,179 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "query_cache.hxx"
+
+#include <algorithm>
+#include <functional>
+
+namespace couchbase::core
+{
+query_cache::query_cache(std::size_t capacity)
+{
+  set_capacity(capacity);
+}
+
+void
+query_cache::set_capacity(std::size_t capacity)
+{
+  capacity_ = std::max<std::size_t>(1, capacity);
+}
+
+void
+query_cache::set_meter(const std::shared_ptr<couchbase::metrics::meter>& meter)
+{
+  if (meter == nullptr) {
+    return;
+  }
+  static const std::string meter_name{ "db.couchbase.query_cache" };
+  auto make_tags = [](const std::string& outcome) -> std::map<std::string, std::string> {
+    return {
+      { "db.couchbase.service", "query" },
+      { "outcome", outcome },
+    };
+  };
+  hit_recorder_ = meter->get_value_recorder(meter_name, make_tags("hit"));
+  miss_recorder_ = meter->get_value_recorder(meter_name, make_tags("miss"));
+  eviction_recorder_ = meter->get_value_recorder(meter_name, make_tags("eviction"));
+}
+
+void
+query_cache::erase(const std::string& statement)
+{
+  auto& s = shard_for(statement);
+  const std::scoped_lock lock(s.mutex);
+  if (auto it = s.index.find(statement); it != s.index.end()) {
+    auto node = it->second;
+    s.index.erase(it);
+    s.lru.erase(node);
+  }
+}
+
+void
+query_cache::put(const std::string& statement, const std::string& prepared)
+{
+  insert(statement, entry{ prepared });
+}
+
+void
+query_cache::put(const std::string& statement,
+                 const std::string& name,
+                 const std::string& encoded_plan)
+{
+  insert(statement, entry{ name, encoded_plan });
+}
+
+auto
+query_cache::get(const std::string& statement) -> std::optional<entry>
+{
+  std::optional<entry> result{};
+  {
+    auto& s = shard_for(statement);
+    const std::scoped_lock lock(s.mutex);
+    if (auto it = s.index.find(statement); it != s.index.end()) {
+      s.lru.splice(s.lru.begin(), s.lru, it->second);
+      result = it->second->value;
+    }
+  }
+  if (result) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    record(hit_recorder_.get());
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    record(miss_recorder_.get());
+  }
+  return result;
+}
+
+auto
+query_cache::capacity() const -> std::size_t
+{
+  return capacity_;
+}
+
+auto
+query_cache::stats() const -> query_cache_stats
+{
+  query_cache_stats stats{
+    hits_.load(std::memory_order_relaxed),
+    misses_.load(std::memory_order_relaxed),
+    evictions_.load(std::memory_order_relaxed),
+  };
+  for (auto& s : shards_) {
+    const std::scoped_lock lock(s.mutex);
+    stats.size += s.lru.size();
+  }
+  return stats;
+}
+
+auto
+query_cache::shard_index(const std::string& statement) -> std::size_t
+{
+  return std::hash<std::string>{}(statement) % number_of_shards;
+}
+
+auto
+query_cache::shard_for(const std::string& statement) -> shard&
+{
+  return shards_[shard_index(statement)];
+}
+
+auto
+query_cache::shard_capacity(std::size_t index) const -> std::size_t
+{
+  // the remainder goes to the first shards, so that the limits add up to the capacity
+  const std::size_t capacity = capacity_;
+  return capacity / number_of_shards + (index < capacity % number_of_shards ? 1 : 0);
+}
+
+void
+query_cache::insert(const std::string& statement, entry value)
+{
+  std::size_t evicted{ 0 };
+  {
+    const auto index = shard_index(statement);
+    auto& s = shards_[index];
+    const std::scoped_lock lock(s.mutex);
+    if (s.index.find(statement) != s.index.end()) {
+      // keep the statement that has been prepared first
+      return;
+    }
+    s.lru.push_front(node{ statement, std::move(value) });
+    s.index.try_emplace(s.lru.front().statement, s.lru.begin());
+    const auto limit = shard_capacity(index);
+    while (s.lru.size() > limit) {
+      s.index.erase(s.lru.back().statement);
+      s.lru.pop_back();
+      ++evicted;
+    }
+  }
+  if (evicted > 0) {
+    evictions_.fetch_add(evicted, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < evicted; ++i) {
+      record(eviction_recorder_.get());
+    }
+  }
+}
+
+void
+query_cache::record(couchbase::metrics::value_recorder* recorder)
+{
+  if (recorder != nullptr) {
+    recorder->record_value(1);
+  }
+}
+} // namespace couchbase::core
@@ -17,55 +17,107 @@
 
 #pragma once
 
-#include <map>
+#include <couchbase/metrics/meter.hxx>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace couchbase::core
 {
+struct query_cache_stats {
+  std::uint64_t hits{ 0 };
+  std::uint64_t misses{ 0 };
+  std::uint64_t evictions{ 0 };
+  std::size_t size{ 0 };
+};
+
+/**
+ * Cache of the prepared statements, used for the queries with adhoc=false.
+ *
+ * The statements are spread over independently locked shards by the hash of their text, and every
+ * shard evicts its least recently used entries once the capacity is exceeded.
+ */
 class query_cache
 {
 public:
+  static constexpr std::size_t default_capacity{ 5'000 };
+
   struct entry {
     std::string name;
     std::optional<std::string> plan{};
   };
 
-  void erase(const std::string& statement)
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return;
-    }
-    store_.erase(it);
-  }
-
-  void put(const std::string& statement, const std::string& prepared)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ prepared });
-  }
-
-  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ name, encoded_plan });
-  }
-
-  auto get(const std::string& statement) -> std::optional<entry>
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return {};
-    }
-    return it->second;
-  }
+  query_cache() = default;
+  explicit query_cache(std::size_t capacity);
+  query_cache(const query_cache&) = delete;
+  query_cache(query_cache&&) = delete;
+  auto operator=(const query_cache&) -> query_cache& = delete;
+  auto operator=(query_cache&&) -> query_cache& = delete;
+  ~query_cache() = default;
+
+  /**
+   * Limits the number of statements. The limit is split between the shards, and every shard
+   * evicts on its own, so the cache never holds more statements than the capacity, but it might
+   * start evicting before it is full, when the statements hash unevenly. With the capacity below
+   * the number of shards, some statements are never cached. Shrinking takes effect on the
+   * following insertions.
+   */
+  void set_capacity(std::size_t capacity);
+
+  /**
+   * Hits, misses and evictions will be reported to the "db.couchbase.query_cache" meter, each event
+   * as a value of 1 recorded with the "outcome" tag. Must be set before the cache is used.
+   */
+  void set_meter(const std::shared_ptr<couchbase::metrics::meter>& meter);
+
+  void erase(const std::string& statement);
+  void put(const std::string& statement, const std::string& prepared);
+  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan);
+  auto get(const std::string& statement) -> std::optional<entry>;
+
+  [[nodiscard]] auto capacity() const -> std::size_t;
+  [[nodiscard]] auto stats() const -> query_cache_stats;
 
 private:
-  std::map<std::string, entry> store_;
-  std::mutex store_mutex_{};
+  static constexpr std::size_t number_of_shards{ 16 };
+
+  struct node {
+    std::string statement;
+    entry value;
+  };
+
+  struct shard {
+    mutable std::mutex mutex{};
+    // most recently used entries in the front
+    std::list<node> lru{};
+    // keys point to the statements owned by the nodes of the lru list
+    std::unordered_map<std::string_view, std::list<node>::iterator> index{};
+  };
+
+  static auto shard_index(const std::string& statement) -> std::size_t;
+  auto shard_for(const std::string& statement) -> shard&;
+  [[nodiscard]] auto shard_capacity(std::size_t index) const -> std::size_t;
+  void insert(const std::string& statement, entry value);
+  void record(couchbase::metrics::value_recorder* recorder);
+
+  std::atomic_size_t capacity_{ default_capacity };
+  std::array<shard, number_of_shards> shards_{};
+
+  std::atomic_uint64_t hits_{ 0 };
+  std::atomic_uint64_t misses_{ 0 };
+  std::atomic_uint64_t evictions_{ 0 };
+
+  std::shared_ptr<couchbase::metrics::value_recorder> hit_recorder_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> miss_recorder_{};
+  std::shared_ptr<couchbase::metrics::value_recorder> eviction_recorder_{};
 };
 } // namespace couchbase::core
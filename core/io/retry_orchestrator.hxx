@@ -63,7 +63,7 @@ retry_with_duration(std::shared_ptr<Manager> manager,
     manager->log_prefix(),
     decltype(command->request)::encoded_request_type::body_type::opcode,
     duration.count(),
-    command->id_,
+    command->id(),
     command->request.partition,
     reason,
     command->request.retries.retry_attempts(),
@@ -98,7 +98,7 @@ maybe_retry(std::shared_ptr<Manager> manager,
   CB_LOG_TRACE(R"({} not retrying operation {} (id="{}", reason={}, attempts={}, ec={} ({})))",
                manager->log_prefix(),
                decltype(command->request)::encoded_request_type::body_type::opcode,
-               command->id_,
+               command->id(),
                reason,
                command->request.retries.retry_attempts(),
                ec.value(),
@@ -17,8 +17,10 @@
 
 #pragma once
 
+#include "core/platform/uuid.h"
 #include "core/utils/movable_function.hxx"
 #include "ip_protocol.hxx"
+#include "tls_session_cache.hxx"
 
 #include <asio.hpp>
 #include <asio/ssl.hpp>
@@ -214,7 +216,13 @@ public:
   void close(utils::movable_function<void(std::error_code)>&& handler) override
   {
     open_ = false;
-    return asio::post(strand_, [stream = stream_, h = std::move(handler)]() {
+    const bool resumable = tls_session_cache::from(tls_) != nullptr;
+    return asio::post(strand_, [stream = stream_, resumable, h = std::move(handler)]() {
+      if (resumable) {
+        // the socket is closed without close_notify, so the library would invalidate the session,
+        // unless the connection is marked as shut down
+        SSL_set_shutdown(stream->native_handle(), SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+      }
       asio::error_code ec{};
       stream->lowest_layer().shutdown(asio::socket_base::shutdown_both, ec);
       stream->lowest_layer().close(ec);
@@ -244,8 +252,15 @@ public:
   void async_connect(const asio::ip::tcp::resolver::results_type::endpoint_type& endpoint,
                      utils::movable_function<void(std::error_code)>&& handler) override
   {
+    auto* sessions = tls_session_cache::from(tls_);
+    std::string session_key{};
+    if (sessions != nullptr) {
+      session_key = endpoint.address().to_string() + ":" + std::to_string(endpoint.port());
+    }
     return stream_->lowest_layer().async_connect(
-      endpoint, [this, handler = std::move(handler)](std::error_code ec_connect) mutable {
+      endpoint,
+      [this, sessions, session_key = std::move(session_key), handler = std::move(handler)](
+        std::error_code ec_connect) mutable {
         if (ec_connect == asio::error::operation_aborted) {
           return;
         }
@@ -253,12 +268,24 @@ public:
           return handler(ec_connect);
         }
         open_ = stream_->lowest_layer().is_open();
+        if (sessions != nullptr) {
+          sessions->prepare(stream_->native_handle(), session_key);
+        }
         stream_->async_handshake(
           asio::ssl::stream_base::client,
-          [handler = std::move(handler)](std::error_code ec_handshake) mutable {
+          [stream = stream_, sessions, session_key, handler = std::move(handler)](
+            std::error_code ec_handshake) mutable {
             if (ec_handshake == asio::error::operation_aborted) {
               return;
             }
+            if (sessions != nullptr) {
+              if (ec_handshake) {
+                // do not offer the session, that the endpoint might have refused
+                sessions->erase(session_key);
+              } else {
+                sessions->record_handshake(stream->native_handle());
+              }
+            }
             return handler(ec_handshake);
           });
       });
@@ -0,0 +1,257 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "timing_wheel.hxx"
+
+#include <asio/error.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace couchbase::core::io
+{
+wheel_timer::wheel_timer(timing_wheel& wheel)
+  : wheel_{ wheel }
+{
+}
+
+wheel_timer::~wheel_timer()
+{
+  // the wheel keeps the owner alive while the timer is linked, so normally there is nothing to do
+  cancel();
+}
+
+void
+wheel_timer::expires_after(clock_type::duration duration)
+{
+  expiry_ = clock_type::now() + duration;
+}
+
+void
+wheel_timer::expires_at(clock_type::time_point expiry)
+{
+  expiry_ = expiry;
+}
+
+auto
+wheel_timer::expiry() const -> clock_type::time_point
+{
+  return expiry_;
+}
+
+auto
+wheel_timer::cancel() -> bool
+{
+  return wheel_.cancel(*this);
+}
+
+auto
+wheel_timer::wheel() const -> timing_wheel&
+{
+  return wheel_;
+}
+
+void
+wheel_timer::schedule(std::shared_ptr<void> owner, void (*callback)(void*))
+{
+  wheel_.schedule(*this, std::move(owner), callback);
+}
+
+timing_wheel::timing_wheel(asio::io_context& ctx)
+  : asio::io_context::service(ctx)
+  , timer_{ ctx }
+{
+}
+
+auto
+timing_wheel::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+void
+timing_wheel::shutdown()
+{
+  std::vector<std::shared_ptr<void>> owners{};
+  {
+    const std::scoped_lock lock(mutex_);
+    stopped_ = true;
+    for (auto& head : slots_) {
+      while (head != nullptr) {
+        auto* timer = head;
+        owners.emplace_back(std::move(timer->owner_));
+        unlink(*timer);
+      }
+    }
+    timer_.cancel();
+    armed_ = false;
+  }
+  // owners are destroyed here, outside of the lock
+}
+
+auto
+timing_wheel::tick_of(clock_type::time_point time) const -> std::uint64_t
+{
+  if (time <= origin_) {
+    return 0;
+  }
+  // round up, so that the timer never fires before its expiry
+  return static_cast<std::uint64_t>((time - origin_ + tick_duration - clock_type::duration{ 1 }) /
+                                    tick_duration);
+}
+
+auto
+timing_wheel::time_of(std::uint64_t tick) const -> clock_type::time_point
+{
+  return origin_ + tick * tick_duration;
+}
+
+void
+timing_wheel::schedule(wheel_timer& timer, std::shared_ptr<void> owner, void (*callback)(void*))
+{
+  std::shared_ptr<void> previous_owner{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    if (timer.linked_) {
+      previous_owner = std::move(timer.owner_);
+      unlink(timer);
+    }
+    // the ticks that already have been processed will not be visited again
+    const auto tick = std::max(tick_of(timer.expiry_), current_tick_ + 1);
+    timer.slot_ = static_cast<std::size_t>(tick % number_of_slots);
+    timer.owner_ = std::move(owner);
+    timer.callback_ = callback;
+    timer.prev_ = nullptr;
+    timer.next_ = slots_[timer.slot_];
+    if (timer.next_ != nullptr) {
+      timer.next_->prev_ = &timer;
+    }
+    slots_[timer.slot_] = &timer;
+    timer.linked_ = true;
+    ++size_;
+
+    if (const auto due = time_of(tick); !armed_ || due < armed_expiry_) {
+      rearm(due);
+    }
+  }
+}
+
+auto
+timing_wheel::cancel(wheel_timer& timer) -> bool
+{
+  std::shared_ptr<void> owner{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (!timer.linked_) {
+      return false;
+    }
+    owner = std::move(timer.owner_);
+    unlink(timer);
+  }
+  // the owner might be destroyed here, outside of the lock
+  return true;
+}
+
+void
+timing_wheel::unlink(wheel_timer& timer)
+{
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    slots_[timer.slot_] = timer.next_;
+  }
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = timer.prev_;
+  }
+  timer.prev_ = nullptr;
+  timer.next_ = nullptr;
+  timer.callback_ = nullptr;
+  timer.linked_ = false;
+  --size_;
+}
+
+void
+timing_wheel::rearm(clock_type::time_point expiry)
+{
+  armed_ = true;
+  armed_expiry_ = expiry;
+  timer_.expires_at(expiry);
+  timer_.async_wait([this, generation = ++generation_](std::error_code ec) {
+    if (ec == asio::error::operation_aborted) {
+      return;
+    }
+    on_tick(generation);
+  });
+}
+
+void
+timing_wheel::on_tick(std::uint64_t generation)
+{
+  std::vector<expired_timer> expired{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (stopped_ || generation != generation_) {
+      return;
+    }
+    armed_ = false;
+    std::swap(expired, expired_);
+
+    const auto now = clock_type::now();
+    // the last tick, that is not in the future, all its timers have expired
+    const auto now_tick = static_cast<std::uint64_t>((now - origin_) / tick_duration);
+    // every slot has to be visited at most once, even if the wheel has been asleep for a long time
+    const auto ticks_to_visit = std::min<std::uint64_t>(now_tick - current_tick_, number_of_slots);
+    for (std::uint64_t i = 1; i <= ticks_to_visit; ++i) {
+      auto* timer = slots_[(current_tick_ + i) % number_of_slots];
+      while (timer != nullptr) {
+        auto* next = timer->next_;
+        if (timer->expiry_ <= now) {
+          expired.push_back({ std::move(timer->owner_), timer->callback_ });
+          unlink(*timer);
+        }
+        timer = next;
+      }
+    }
+    current_tick_ = std::max(current_tick_, now_tick);
+
+    if (size_ > 0) {
+      // sleep until the next slot that has timers, they might belong to one of the next rounds
+      std::size_t distance = 1;
+      while (distance < number_of_slots &&
+             slots_[(current_tick_ + distance) % number_of_slots] == nullptr) {
+        ++distance;
+      }
+      rearm(time_of(current_tick_ + distance));
+    }
+  }
+
+  for (auto& [owner, callback] : expired) {
+    callback(owner.get());
+  }
+  expired.clear();
+
+  const std::scoped_lock lock(mutex_);
+  // keep the capacity for the next tick
+  if (expired_.capacity() < expired.capacity()) {
+    std::swap(expired, expired_);
+  }
+}
+} // namespace couchbase::core::io
@@ -0,0 +1,153 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace couchbase::core::io
+{
+class timing_wheel;
+
+/**
+ * Deadline registered in the timing_wheel.
+ *
+ * The timer is embedded into the object that owns the deadline (for example a command), so that
+ * arming and cancelling it does not allocate. While the timer is armed, the wheel keeps the owner
+ * alive.
+ */
+class wheel_timer
+{
+public:
+  using clock_type = std::chrono::steady_clock;
+
+  explicit wheel_timer(timing_wheel& wheel);
+  wheel_timer(const wheel_timer&) = delete;
+  wheel_timer(wheel_timer&&) = delete;
+  auto operator=(const wheel_timer&) -> wheel_timer& = delete;
+  auto operator=(wheel_timer&&) -> wheel_timer& = delete;
+  ~wheel_timer();
+
+  void expires_after(clock_type::duration duration);
+  void expires_at(clock_type::time_point expiry);
+
+  [[nodiscard]] auto expiry() const -> clock_type::time_point;
+
+  /**
+   * Arms the timer. When it expires, the Callback member function is invoked on the owner from
+   * the thread running the IO context of the wheel. Cancelled timer does not invoke the callback.
+   */
+  template<auto Callback, typename Owner>
+  void async_wait(std::shared_ptr<Owner> owner)
+  {
+    schedule(std::move(owner), [](void* ptr) {
+      (static_cast<Owner*>(ptr)->*Callback)();
+    });
+  }
+
+  /**
+   * @return true if the timer has been armed, and the callback will not be invoked
+   */
+  auto cancel() -> bool;
+
+  [[nodiscard]] auto wheel() const -> timing_wheel&;
+
+private:
+  friend class timing_wheel;
+
+  void schedule(std::shared_ptr<void> owner, void (*callback)(void*));
+
+  timing_wheel& wheel_;
+  clock_type::time_point expiry_{};
+
+  // the fields below are protected by the mutex of the wheel
+  std::shared_ptr<void> owner_{};
+  void (*callback_)(void*){ nullptr };
+  wheel_timer* prev_{ nullptr };
+  wheel_timer* next_{ nullptr };
+  std::size_t slot_{ 0 };
+  bool linked_{ false };
+};
+
+/**
+ * Hashed timing wheel, that tracks deadlines of the operations dispatched through the IO context.
+ *
+ * The wheel is an IO context service, so all the objects sharing the IO context share the wheel,
+ * and its single steady_timer. Timers are kept in intrusive lists, one per slot, where the slot is
+ * selected by the expiry tick modulo the number of slots. Arming and cancelling a timer is O(1) and
+ * does not allocate, and the system timer only wakes up when the next non-empty slot is due.
+ */
+class timing_wheel : public asio::io_context::service
+{
+public:
+  using clock_type = wheel_timer::clock_type;
+
+  static inline asio::io_context::id id{};
+
+  static constexpr std::chrono::milliseconds tick_duration{ 1 };
+  static constexpr std::size_t number_of_slots{ 512 };
+
+  explicit timing_wheel(asio::io_context& ctx);
+  timing_wheel(const timing_wheel&) = delete;
+  timing_wheel(timing_wheel&&) = delete;
+  auto operator=(const timing_wheel&) -> timing_wheel& = delete;
+  auto operator=(timing_wheel&&) -> timing_wheel& = delete;
+  ~timing_wheel() override = default;
+
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  friend class wheel_timer;
+
+  struct expired_timer {
+    std::shared_ptr<void> owner;
+    void (*callback)(void*);
+  };
+
+  void shutdown() override;
+
+  void schedule(wheel_timer& timer, std::shared_ptr<void> owner, void (*callback)(void*));
+  auto cancel(wheel_timer& timer) -> bool;
+  void unlink(wheel_timer& timer);
+  void rearm(clock_type::time_point expiry);
+  void on_tick(std::uint64_t generation);
+
+  [[nodiscard]] auto tick_of(clock_type::time_point time) const -> std::uint64_t;
+  [[nodiscard]] auto time_of(std::uint64_t tick) const -> clock_type::time_point;
+
+  mutable std::mutex mutex_{};
+  asio::steady_timer timer_;
+  const clock_type::time_point origin_{ clock_type::now() };
+  std::array<wheel_timer*, number_of_slots> slots_{};
+  std::size_t size_{ 0 };
+  std::uint64_t current_tick_{ 0 };
+  std::uint64_t generation_{ 0 };
+  bool armed_{ false };
+  clock_type::time_point armed_expiry_{};
+  bool stopped_{ false };
+  std::vector<expired_timer> expired_{};
+};
+} // namespace couchbase::core::io
@@ -0,0 +1,181 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "tls_session_cache.hxx"
+
+#include <algorithm>
+
+#include <fmt/core.h>
+
+namespace couchbase::core::io
+{
+namespace
+{
+auto
+context_index() -> int
+{
+  static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
+void
+free_endpoint(void* /* parent */,
+              void* ptr,
+              CRYPTO_EX_DATA* /* ad */,
+              int /* index */,
+              long /* argl */, // NOLINT(google-runtime-int)
+              void* /* argp */)
+{
+  delete static_cast<std::string*>(ptr);
+}
+
+/**
+ * The endpoint is attached to the connection, because the server might issue the sessions after the
+ * handshake (TLS 1.3 sends the tickets with the first records of the application data).
+ */
+auto
+endpoint_index() -> int
+{
+  static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, free_endpoint);
+  return index;
+}
+} // namespace
+
+tls_session_cache::tls_session_cache(std::size_t capacity)
+  : capacity_{ std::max<std::size_t>(1, capacity) }
+{
+}
+
+tls_session_cache::~tls_session_cache()
+{
+  if (context_ != nullptr) {
+    SSL_CTX_sess_set_new_cb(context_, nullptr);
+    SSL_CTX_set_ex_data(context_, context_index(), nullptr);
+  }
+  clear();
+}
+
+void
+tls_session_cache::attach(asio::ssl::context& tls)
+{
+  context_ = tls.native_handle();
+  SSL_CTX_set_ex_data(context_, context_index(), this);
+  // the sessions are kept here, because the internal cache of OpenSSL is not used by clients
+  SSL_CTX_set_session_cache_mode(context_,
+                                 SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(context_, &tls_session_cache::on_new_session);
+}
+
+auto
+tls_session_cache::from(asio::ssl::context& tls) -> tls_session_cache*
+{
+  return static_cast<tls_session_cache*>(SSL_CTX_get_ex_data(tls.native_handle(), context_index()));
+}
+
+void
+tls_session_cache::prepare(SSL* ssl, const std::string& endpoint)
+{
+  delete static_cast<std::string*>(SSL_get_ex_data(ssl, endpoint_index()));
+  SSL_set_ex_data(ssl, endpoint_index(), new std::string(endpoint));
+
+  const std::scoped_lock lock(mutex_);
+  if (auto it = sessions_.find(endpoint); it != sessions_.end()) {
+    SSL_set_session(ssl, it->second);
+  }
+}
+
+void
+tls_session_cache::record_handshake(SSL* ssl)
+{
+  if (SSL_session_reused(ssl) != 0) {
+    resumed_handshakes_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    full_handshakes_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void
+tls_session_cache::erase(const std::string& endpoint)
+{
+  const std::scoped_lock lock(mutex_);
+  if (auto it = sessions_.find(endpoint); it != sessions_.end()) {
+    SSL_SESSION_free(it->second);
+    sessions_.erase(it);
+  }
+}
+
+void
+tls_session_cache::clear()
+{
+  const std::scoped_lock lock(mutex_);
+  for (auto& [endpoint, session] : sessions_) {
+    SSL_SESSION_free(session);
+  }
+  sessions_.clear();
+}
+
+auto
+tls_session_cache::stats() const -> tls_session_cache_stats
+{
+  tls_session_cache_stats stats{
+    resumed_handshakes_.load(std::memory_order_relaxed),
+    full_handshakes_.load(std::memory_order_relaxed),
+  };
+  const std::scoped_lock lock(mutex_);
+  stats.size = sessions_.size();
+  return stats;
+}
+
+auto
+tls_session_cache::on_new_session(SSL* ssl, SSL_SESSION* session) -> int
+{
+  auto* cache = static_cast<tls_session_cache*>(
+    SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), context_index()));
+  const auto* endpoint = static_cast<const std::string*>(SSL_get_ex_data(ssl, endpoint_index()));
+  if (cache == nullptr || endpoint == nullptr) {
+    // the session is not retained, and will be released by the library
+    return 0;
+  }
+  cache->store(*endpoint, session);
+  return 1;
+}
+
+void
+tls_session_cache::store(const std::string& endpoint, SSL_SESSION* session)
+{
+  const std::scoped_lock lock(mutex_);
+  if (auto it = sessions_.find(endpoint); it != sessions_.end()) {
+    SSL_SESSION_free(it->second);
+    it->second = session;
+    return;
+  }
+  if (sessions_.size() >= capacity_) {
+    SSL_SESSION_free(sessions_.begin()->second);
+    sessions_.erase(sessions_.begin());
+  }
+  sessions_.try_emplace(endpoint, session);
+}
+
+auto
+to_string(const tls_session_cache_stats& stats) -> std::string
+{
+  return fmt::format("tls_resumed_handshakes={}, tls_full_handshakes={}, tls_cached_sessions={}",
+                     stats.resumed_handshakes,
+                     stats.full_handshakes,
+                     stats.size);
+}
+} // namespace couchbase::core::io
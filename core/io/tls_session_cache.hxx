@@ -0,0 +1,106 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <asio/ssl.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace couchbase::core::io
+{
+struct tls_session_cache_stats {
+  std::uint64_t resumed_handshakes{ 0 };
+  std::uint64_t full_handshakes{ 0 };
+  std::size_t size{ 0 };
+};
+
+/**
+ * Client side TLS sessions, keyed by the endpoint of the connection.
+ *
+ * Once attached to the TLS context, every stream created with the context offers the last session
+ * received from its endpoint, so that the reconnecting KV sessions and the pooled HTTP sessions
+ * resume the session (with TLS 1.2 session IDs or tickets, and with TLS 1.3 tickets) instead of
+ * performing the full handshake.
+ */
+class tls_session_cache
+{
+public:
+  static constexpr std::size_t default_capacity{ 1'024 };
+
+  tls_session_cache() = default;
+  explicit tls_session_cache(std::size_t capacity);
+  tls_session_cache(const tls_session_cache&) = delete;
+  tls_session_cache(tls_session_cache&&) = delete;
+  auto operator=(const tls_session_cache&) -> tls_session_cache& = delete;
+  auto operator=(tls_session_cache&&) -> tls_session_cache& = delete;
+  ~tls_session_cache();
+
+  /**
+   * Enables caching of the client sessions for the context. The cache detaches itself from the
+   * context when destroyed.
+   */
+  void attach(asio::ssl::context& tls);
+
+  /**
+   * @return the cache attached to the context, or nullptr if the session resumption is disabled.
+   */
+  static auto from(asio::ssl::context& tls) -> tls_session_cache*;
+
+  /**
+   * Must be called before the handshake. Offers the cached session of the endpoint (if any), and
+   * associates the connection with the endpoint, so that the sessions issued by the server will be
+   * stored for it.
+   */
+  void prepare(SSL* ssl, const std::string& endpoint);
+
+  /**
+   * Must be called after the handshake completes, to account it as resumed or full.
+   */
+  void record_handshake(SSL* ssl);
+
+  /**
+   * Forgets the session of the endpoint, for example when the handshake with it has failed.
+   */
+  void erase(const std::string& endpoint);
+
+  void clear();
+
+  [[nodiscard]] auto stats() const -> tls_session_cache_stats;
+
+private:
+  static auto on_new_session(SSL* ssl, SSL_SESSION* session) -> int;
+  void store(const std::string& endpoint, SSL_SESSION* session);
+
+  const std::size_t capacity_{ default_capacity };
+  SSL_CTX* context_{ nullptr };
+
+  mutable std::mutex mutex_{};
+  std::map<std::string, SSL_SESSION*> sessions_{};
+
+  std::atomic_uint64_t resumed_handshakes_{ 0 };
+  std::atomic_uint64_t full_handshakes_{ 0 };
+};
+
+[[nodiscard]] auto
+to_string(const tls_session_cache_stats& stats) -> std::string;
+} // namespace couchbase::core::io
@@ -110,7 +110,7 @@ queue_request::internal_cancel() -> bool
     return false;
   }
 
-  cancel_timer(deadline_);
+  cancel_deadline();
   cancel_timer(retry_backoff_);
 
   if (auto* queued_with = queued_with_.load(); queued_with) {
@@ -132,9 +132,30 @@ queue_request::cancel(std::error_code error)
 }
 
 void
-queue_request::set_deadline(std::shared_ptr<asio::steady_timer> timer)
+queue_request::set_deadline(io::timing_wheel& wheel, std::chrono::milliseconds timeout)
 {
-  deadline_ = std::move(timer);
+  const std::scoped_lock lock(processing_mutex_);
+  if (is_completed_) {
+    return;
+  }
+  cancel_deadline();
+  deadline_.emplace(wheel);
+  deadline_->expires_after(timeout);
+  deadline_->async_wait<&queue_request::on_deadline>(shared_from_this());
+}
+
+void
+queue_request::on_deadline()
+{
+  cancel(errc::common::unambiguous_timeout);
+}
+
+void
+queue_request::cancel_deadline()
+{
+  if (deadline_) {
+    deadline_->cancel();
+  }
 }
 
 void
@@ -146,7 +167,10 @@ queue_request::set_retry_backoff(std::shared_ptr<asio::steady_timer> timer)
 void
 queue_request::try_callback(std::shared_ptr<queue_response> response, std::error_code error)
 {
-  cancel_timer(deadline_);
+  {
+    const std::scoped_lock lock(processing_mutex_);
+    cancel_deadline();
+  }
   cancel_timer(retry_backoff_);
 
   if (persistent_) {
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "core/io/timing_wheel.hxx"
 #include "core/pending_operation.hxx"
 #include "packet.hxx"
 #include "queue_callback.hxx"
@@ -27,8 +28,10 @@
 #include <asio/steady_timer.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 
 namespace couchbase::core
@@ -67,7 +70,10 @@ public:
   void try_callback(std::shared_ptr<queue_response> response, std::error_code error);
   auto internal_cancel() -> bool;
 
-  void set_deadline(std::shared_ptr<asio::steady_timer> timer);
+  /**
+   * Cancels the request with unambiguous_timeout, unless it completes before the timeout expires.
+   */
+  void set_deadline(io::timing_wheel& wheel, std::chrono::milliseconds timeout);
   void set_retry_backoff(std::shared_ptr<asio::steady_timer> timer);
 
   std::string collection_name_{};
@@ -114,7 +120,11 @@ private:
   queue_request_connection_info connection_info_{};
   mutable std::mutex connection_info_mutex_{};
 
-  std::shared_ptr<asio::steady_timer> deadline_{};
+  void on_deadline();
+  void cancel_deadline();
+
+  // protected by processing_mutex_
+  std::optional<io::wheel_timer> deadline_{};
   std::shared_ptr<asio::steady_timer> retry_backoff_{};
 
   friend operation_queue;
@@ -0,0 +1,63 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "kv_operation_recorders.hxx"
+
+#include "core/protocol/client_opcode_fmt.hxx"
+#include "noop_meter.hxx"
+
+#include <fmt/core.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace couchbase::core::metrics
+{
+kv_operation_recorders::kv_operation_recorders(std::shared_ptr<couchbase::metrics::meter> meter)
+  : meter_{ std::move(meter) }
+{
+}
+
+auto
+kv_operation_recorders::recorder_for(protocol::client_opcode opcode)
+  -> couchbase::metrics::value_recorder&
+{
+  const auto index = static_cast<std::size_t>(opcode);
+  if (auto* recorder = recorders_[index].load(std::memory_order_acquire); recorder != nullptr) {
+    return *recorder;
+  }
+
+  const std::scoped_lock lock(resolve_mutex_);
+  if (auto* recorder = recorders_[index].load(std::memory_order_acquire); recorder != nullptr) {
+    return *recorder;
+  }
+  if (meter_ == nullptr) {
+    resolved_recorders_[index] = std::make_shared<noop_value_recorder>();
+  } else {
+    static const std::string meter_name = "db.couchbase.operations";
+    resolved_recorders_[index] =
+      meter_->get_value_recorder(meter_name,
+                                 {
+                                   { "db.couchbase.service", "kv" },
+                                   { "db.operation", fmt::format("{}", opcode) },
+                                 });
+  }
+  recorders_[index].store(resolved_recorders_[index].get(), std::memory_order_release);
+  return *resolved_recorders_[index];
+}
+} // namespace couchbase::core::metrics
@@ -0,0 +1,54 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/protocol/client_opcode.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace couchbase::core::metrics
+{
+/**
+ * Caches value recorders of the "db.couchbase.operations" meter for the KV service.
+ *
+ * The recorder for the opcode is requested from the meter only once, after that the lookup is a
+ * single atomic load from the array indexed by the opcode, without locks and building the tags.
+ */
+class kv_operation_recorders
+{
+public:
+  explicit kv_operation_recorders(std::shared_ptr<couchbase::metrics::meter> meter);
+
+  [[nodiscard]] auto recorder_for(protocol::client_opcode opcode)
+    -> couchbase::metrics::value_recorder&;
+
+private:
+  static constexpr std::size_t number_of_opcodes{ 256 };
+
+  std::shared_ptr<couchbase::metrics::meter> meter_;
+  std::array<std::atomic<couchbase::metrics::value_recorder*>, number_of_opcodes> recorders_{};
+  std::mutex resolve_mutex_{};
+  std::array<std::shared_ptr<couchbase::metrics::value_recorder>, number_of_opcodes>
+    resolved_recorders_{};
+};
+} // namespace couchbase::core::metrics
@@ -21,32 +21,109 @@
 
 #include "core/logger/logger.hxx"
 #include "core/utils/json.hxx"
+#include "core/utils/thread_index.hxx"
 #include "noop_meter.hxx"
 
 #include <gsl/assert>
 #include <hdr/hdr_histogram.h>
 #include <tao/json/value.hpp>
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 namespace couchbase::core::metrics
 {
+namespace
+{
+auto
+make_histogram() -> hdr_histogram*
+{
+  hdr_histogram* histogram{ nullptr };
+  hdr_init(/* minimum - 1 ns*/ 1,
+           /* maximum - 30 s*/ 30'000'000'000LL,
+           /* significant figures */ 3,
+           /* pointer */ &histogram);
+  Expects(histogram != nullptr);
+  return histogram;
+}
+} // namespace
+
+/**
+ * Recording threads are spread across a small fixed set of histogram shards, so that they do not
+ * contend on the counters of the single histogram. Recording does not take any lock: the value is
+ * added with hdr_record_value_atomic to the buffer that is currently published in the shard. The
+ * report swaps the published buffer with a spare one, waits for the writers that still hold the old
+ * buffer, and merges it with hdr_add. The old buffer becomes the spare for the next shard, so the
+ * buffers are allocated once and released only with the recorder.
+ */
 class logging_value_recorder : public couchbase::metrics::value_recorder
 {
 private:
+  static constexpr std::size_t number_of_shards{ 4 };
+
+  struct histogram_buffer {
+    hdr_histogram* histogram{ make_histogram() };
+    std::atomic_size_t writers{ 0 };
+
+    histogram_buffer() = default;
+    histogram_buffer(const histogram_buffer&) = delete;
+    histogram_buffer(histogram_buffer&&) = delete;
+    auto operator=(const histogram_buffer&) -> histogram_buffer& = delete;
+    auto operator=(histogram_buffer&&) -> histogram_buffer& = delete;
+
+    ~histogram_buffer()
+    {
+      hdr_close(histogram);
+    }
+  };
+
+  struct alignas(64) shard {
+    std::atomic<histogram_buffer*> buffer{ nullptr };
+  };
+
   std::string name_;
   std::map<std::string, std::string> tags_;
-  hdr_histogram* histogram_{ nullptr };
+  mutable std::array<shard, number_of_shards> shards_{};
+  mutable std::unique_ptr<histogram_buffer> spare_{};
+  hdr_histogram* merged_{ nullptr };
 
   void initialize_histogram()
   {
-    histogram_ = nullptr;
-    hdr_init(/* minimum - 1 ns*/ 1,
-             /* maximum - 30 s*/ 30'000'000'000LL,
-             /* significant figures */ 3,
-             /* pointer */ &histogram_);
-    Expects(histogram_ != nullptr);
+    close_histograms();
+    merged_ = make_histogram();
+  }
+
+  void close_histograms()
+  {
+    for (auto& s : shards_) {
+      delete s.buffer.exchange(nullptr);
+    }
+    spare_.reset();
+    if (merged_ != nullptr) {
+      hdr_close(merged_);
+      merged_ = nullptr;
+    }
+  }
+
+  /**
+   * Returns the buffer published in the shard, allocating it on the first use of the shard.
+   */
+  static auto published_buffer(shard& s) -> histogram_buffer*
+  {
+    auto* buffer = s.buffer.load();
+    if (buffer != nullptr) {
+      return buffer;
+    }
+    auto created = std::make_unique<histogram_buffer>();
+    if (s.buffer.compare_exchange_strong(buffer, created.get())) {
+      return created.release();
+    }
+    // another thread has published its buffer first
+    return buffer;
   }
 
 public:
@@ -98,30 +175,50 @@ public:
 
   ~logging_value_recorder() override
   {
-    if (histogram_ != nullptr) {
-      hdr_close(histogram_);
-      histogram_ = nullptr;
-    }
+    close_histograms();
   }
 
   void record_value(std::int64_t value) override
   {
-    if (histogram_ == nullptr) {
-      return;
+    auto& s = shards_[utils::current_thread_index() % number_of_shards];
+    while (true) {
+      auto* buffer = published_buffer(s);
+      buffer->writers.fetch_add(1);
+      // the report might have swapped the buffer out before it saw this writer
+      if (s.buffer.load() == buffer) {
+        hdr_record_value_atomic(buffer->histogram, value);
+        buffer->writers.fetch_sub(1);
+        return;
+      }
+      buffer->writers.fetch_sub(1);
     }
-    hdr_record_value_atomic(histogram_, value);
   }
 
   [[nodiscard]] auto emit() const -> tao::json::value
   {
-    auto total_count = histogram_->total_count;
-    auto val_50_0 = hdr_value_at_percentile(histogram_, 50.0);
-    auto val_90_0 = hdr_value_at_percentile(histogram_, 90.0);
-    auto val_99_0 = hdr_value_at_percentile(histogram_, 99.0);
-    auto val_99_9 = hdr_value_at_percentile(histogram_, 99.9);
-    auto val_100_0 = hdr_value_at_percentile(histogram_, 100.0);
-
-    hdr_reset(histogram_);
+    hdr_reset(merged_);
+    for (auto& s : shards_) {
+      if (s.buffer.load() == nullptr) {
+        continue;
+      }
+      if (!spare_) {
+        spare_ = std::make_unique<histogram_buffer>();
+      }
+      std::unique_ptr<histogram_buffer> retired{ s.buffer.exchange(spare_.release()) };
+      while (retired->writers.load() != 0) {
+        std::this_thread::yield();
+      }
+      hdr_add(merged_, retired->histogram);
+      hdr_reset(retired->histogram);
+      spare_ = std::move(retired);
+    }
+
+    auto total_count = merged_->total_count;
+    auto val_50_0 = hdr_value_at_percentile(merged_, 50.0);
+    auto val_90_0 = hdr_value_at_percentile(merged_, 90.0);
+    auto val_99_0 = hdr_value_at_percentile(merged_, 99.0);
+    auto val_99_9 = hdr_value_at_percentile(merged_, 99.9);
+    auto val_100_0 = hdr_value_at_percentile(merged_, 100.0);
 
     return {
       { "total_count", total_count },
@@ -95,7 +95,7 @@ analytics_request::encode_to(analytics_request::encoded_request_type& encoded,
     encoded.streaming.emplace(couchbase::core::io::streaming_settings{
       "/results/^",
       4,
-      std::move(row_callback.value()),
+      row_callback.value(),
     });
   }
   return {};
@@ -34,12 +34,12 @@ get_and_lock_request::encode_to(get_and_lock_request::encoded_request_type& enco
 
 auto
 get_and_lock_request::make_response(key_value_error_context&& ctx,
-                                    const encoded_response_type& encoded) const
+                                    encoded_response_type&& encoded) const
   -> get_and_lock_response
 {
   get_and_lock_response response{ std::move(ctx) };
   if (!response.ctx.ec()) {
-    response.value = encoded.body().value();
+    response.value = std::move(encoded.body()).value();
     response.cas = encoded.cas();
     response.flags = encoded.body().flags();
   }
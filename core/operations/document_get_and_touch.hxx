@@ -54,7 +54,7 @@ struct get_and_touch_request {
                                mcbp_context&& context) const -> std::error_code;
 
   [[nodiscard]] auto make_response(key_value_error_context&& ctx,
-                                   const encoded_response_type& encoded) const
+                                   encoded_response_type&& encoded) const
     -> get_and_touch_response;
 };
 
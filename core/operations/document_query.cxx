@@ -37,6 +37,7 @@ query_request::encode_to(query_request::encoded_request_type& encoded,
                          http_context& context) -> std::error_code
 {
   ctx_.emplace(context);
+  extract_encoded_plan_ = false;
   tao::json::value body{
     { "client_context_id", encoded.client_context_id },
   };
@@ -198,11 +199,12 @@ query_request::encode_to(query_request::encoded_request_type& encoded,
                  utils::json::generate(stmt),
                  utils::json::generate(body));
   }
-  if (row_callback) {
+  // the legacy PREPARE returns the plan as its only row, and make_response has to find it there
+  if (row_callback && !extract_encoded_plan_) {
     encoded.streaming.emplace(couchbase::core::io::streaming_settings{
       "/results/^",
       4,
-      std::move(row_callback.value()),
+      row_callback.value(),
     });
   }
   return {};
@@ -32,6 +32,7 @@
 #include <couchbase/mutation_token.hxx>
 
 #include <map>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -174,6 +175,11 @@ struct search_request {
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
 };
 
+/**
+ * Parses one entry of the "hits" array, the way it is passed to search_request::row_callback.
+ */
+auto
+parse_search_row(std::string_view row) -> search_response::search_row;
 } // namespace couchbase::core::operations
 namespace couchbase::core::io::http_traits
 {
@@ -39,6 +39,15 @@ struct traits<std::chrono::milliseconds> {
   }
 };
 
+template<>
+struct traits<std::chrono::microseconds> {
+  template<template<typename...> class Traits>
+  static void assign(tao::json::basic_value<Traits>& v, const std::chrono::microseconds& o)
+  {
+    v = fmt::format("{}", o);
+  }
+};
+
 template<>
 struct traits<std::chrono::nanoseconds> {
   template<template<typename...> class Traits>
@@ -242,9 +251,12 @@ origin::to_json() const -> std::string
         { "enable_dns_srv", options_.enable_dns_srv },
         { "dns_config", options_.dns_config },
         { "show_queries", options_.show_queries },
+        { "query_cache_capacity", options_.query_cache_capacity },
         { "enable_unordered_execution", options_.enable_unordered_execution },
         { "enable_clustermap_notification", options_.enable_clustermap_notification },
         { "enable_compression", options_.enable_compression },
+        { "compression_min_size", options_.compression_min_size },
+        { "compression_min_ratio", options_.compression_min_ratio },
         { "enable_tracing", options_.enable_tracing },
         { "enable_metrics", options_.enable_metrics },
         { "tcp_keep_alive_interval", options_.tcp_keep_alive_interval },
@@ -252,6 +264,12 @@ origin::to_json() const -> std::string
         { "config_poll_floor", options_.config_poll_floor },
         { "config_idle_redial_timeout", options_.config_idle_redial_timeout },
         { "max_http_connections", options_.max_http_connections },
+        { "max_key_value_read_buffer_size", options_.max_key_value_read_buffer_size },
+        { "key_value_write_coalescing_delay", options_.key_value_write_coalescing_delay },
+        { "key_value_write_coalescing_threshold",
+          options_.key_value_write_coalescing_threshold },
+        { "num_kv_connections", options_.num_kv_connections },
+        { "io_threads", options_.io_threads },
         { "idle_http_connection_timeout", options_.idle_http_connection_timeout },
         { "user_agent_extra", options_.user_agent_extra },
         { "dump_configuration", options_.dump_configuration },
@@ -259,6 +277,7 @@ origin::to_json() const -> std::string
         { "metrics_options", options_.metrics_options },
         { "network", options_.network },
         { "tls_verify", options_.tls_verify },
+        { "tls_session_resumption", options_.tls_session_resumption },
         { "tracing_options", options_.tracing_options },
         { "transactions_options", options_.transactions },
       },
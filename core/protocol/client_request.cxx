@@ -16,26 +16,13 @@
  */
 
 #include "client_request.hxx"
-#include "core/utils/binary.hxx"
-
-#include <snappy.h>
 
 namespace couchbase::core::protocol
 {
 auto
-compress_value(const std::vector<std::byte>& value,
-               std::vector<std::byte>::iterator& output) -> std::pair<bool, std::uint32_t>
+default_value_compressor() -> value_compressor&
 {
-  static const double min_ratio = 0.83;
-
-  std::string compressed;
-  const std::size_t compressed_size =
-    snappy::Compress(reinterpret_cast<const char*>(value.data()), value.size(), &compressed);
-  if (gsl::narrow_cast<double>(compressed_size) / gsl::narrow_cast<double>(value.size()) <
-      min_ratio) {
-    utils::to_binary(compressed, output);
-    return { true, gsl::narrow_cast<std::uint32_t>(compressed_size) };
-  }
-  return { false, 0 };
+  static value_compressor compressor{};
+  return compressor;
 }
 } // namespace couchbase::core::protocol
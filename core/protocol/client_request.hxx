@@ -22,8 +22,10 @@
 #include "client_opcode.hxx"
 #include "client_response.hxx"
 #include "core/utils/binary.hxx"
+#include "core/utils/byte_buffer_pool.hxx"
 #include "core/utils/byteswap.hxx"
 #include "magic.hxx"
+#include "value_compressor.hxx"
 
 #include <algorithm>
 #include <cstring>
@@ -31,9 +33,11 @@
 
 namespace couchbase::core::protocol
 {
-auto
-compress_value(const std::vector<std::byte>& value,
-               std::vector<std::byte>::iterator& output) -> std::pair<bool, std::uint32_t>;
+/**
+ * Compressor with default thresholds, for the requests that are not associated with a bucket.
+ */
+[[nodiscard]] auto
+default_value_compressor() -> value_compressor&;
 
 template<typename Body>
 class client_request
@@ -101,28 +105,44 @@ public:
   }
 
   [[nodiscard]] auto data(bool try_to_compress = false) -> std::vector<std::byte>
+  {
+    if (try_to_compress) {
+      return data(default_value_compressor());
+    }
+    return generate_payload(nullptr);
+  }
+
+  [[nodiscard]] auto data(value_compressor& compressor) -> std::vector<std::byte>
   {
     switch (opcode_) {
       case protocol::client_opcode::insert:
       case protocol::client_opcode::upsert:
       case protocol::client_opcode::replace:
-        return generate_payload(try_to_compress);
+        return generate_payload(&compressor);
       default:
         break;
     }
-    return generate_payload(false);
+    return generate_payload(nullptr);
   }
 
 private:
-  [[nodiscard]] auto generate_payload(bool try_to_compress) -> std::vector<std::byte>
+  [[nodiscard]] auto generate_payload(value_compressor* compressor) -> std::vector<std::byte>
   {
+    const auto& value = body_.value();
+    const bool try_to_compress = compressor != nullptr && compressor->should_compress(value.size());
+    std::size_t payload_size = header_size + body_.size();
+    if (try_to_compress) {
+      // reserve enough space to compress the value directly into the payload
+      payload_size += value_compressor::max_compressed_length(value.size()) - value.size();
+    }
+
     // SA: for some reason GCC 8.5.0 on CentOS 8 sees here null-pointer dereference
     // JC: BoringSSL changes, noticed the same when building w/ GCC 11.3.0; TODO:  is 12 okay?
 #if defined(__GNUC__) && __GNUC__ >= 8 && __GNUC__ < 12
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wnull-dereference"
 #endif
-    std::vector<std::byte> payload(header_size + body_.size(), std::byte{});
+    auto payload = utils::byte_buffer_pool::local().acquire(payload_size);
     payload[0] = static_cast<std::byte>(magic_);
     payload[1] = static_cast<std::byte>(opcode_);
 #if defined(__GNUC__) && __GNUC__ >= 8 && __GNUC__ < 12
@@ -162,21 +182,21 @@ private:
     body_itr = std::copy(body_.extras().begin(), body_.extras().end(), body_itr);
     body_itr = utils::to_binary(body_.key(), body_itr);
 
-    if (static const std::size_t min_size_to_compress = 32;
-        try_to_compress && body_.value().size() > min_size_to_compress) {
-      if (auto [compressed, new_value_size] = compress_value(body_.value(), body_itr); compressed) {
-        /* the compressed value meets requirements and was copied to the payload */
+    if (try_to_compress) {
+      auto* output = payload.data() + std::distance(payload.begin(), body_itr);
+      if (auto compressed_size = compressor->compress(value.data(), value.size(), output);
+          compressed_size > 0) {
         payload[5] |= static_cast<std::byte>(protocol::datatype::snappy);
-        std::uint32_t new_body_size = utils::byte_swap(body_size) -
-                                      gsl::narrow_cast<std::uint32_t>(body_.value().size()) +
-                                      new_value_size;
+        std::uint32_t new_body_size =
+          gsl::narrow_cast<std::uint32_t>(body_.size() - value.size() + compressed_size);
         payload.resize(header_size + new_body_size);
         new_body_size = utils::byte_swap(new_body_size);
         memcpy(payload.data() + 8, &new_body_size, sizeof(new_body_size));
         return payload;
       }
     }
-    std::copy(body_.value().begin(), body_.value().end(), body_itr);
+    std::copy(value.begin(), value.end(), body_itr);
+    payload.resize(header_size + body_.size());
     return payload;
   }
 };
@@ -39,6 +39,8 @@
 #include <cmath>
 #include <cstring>
 #include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace couchbase::core::protocol
 {
@@ -49,6 +51,20 @@ parse_server_duration_us(const io::mcbp_message& msg) -> double;
 auto
 parse_enhanced_error(std::string_view str, key_value_extended_error_info& info) -> bool;
 
+/**
+ * Response bodies that are able to adopt the value, which has been received separately from the
+ * rest of the frame (see io::mcbp_parser), define assign_value(std::vector<std::byte>&&).
+ */
+template<typename Body, typename = void>
+struct accepts_separate_value : std::false_type {
+};
+
+template<typename Body>
+struct accepts_separate_value<Body,
+                              std::void_t<decltype(std::declval<Body&>().assign_value(
+                                std::declval<std::vector<std::byte>&&>()))>> : std::true_type {
+};
+
 template<typename Body>
 class client_response
 {
@@ -59,6 +75,7 @@ private:
   header_buffer header_{};
   std::uint8_t data_type_{ 0 };
   std::vector<std::byte> data_{};
+  std::optional<std::vector<std::byte>> value_{};
   std::uint16_t key_size_{ 0 };
   std::uint8_t framing_extras_size_{ 0 };
   std::uint8_t extras_size_{ 0 };
@@ -79,8 +96,15 @@ public:
   client_response(io::mcbp_message&& msg, const cmd_info& info)
     : header_(msg.header_data())
     , data_(std::move(msg.body))
+    , value_(std::move(msg.value))
     , info_(info)
   {
+    if constexpr (!accepts_separate_value<Body>::value) {
+      if (value_) {
+        data_.insert(data_.end(), value_->begin(), value_->end());
+        value_.reset();
+      }
+    }
     verify_header();
     parse_body();
   }
@@ -146,7 +170,7 @@ public:
     std::uint32_t field = 0;
     memcpy(&field, header_.data() + 8, sizeof(field));
     body_size_ = utils::byte_swap(field);
-    data_.resize(body_size_);
+    data_.resize(body_size_ - (value_ ? value_->size() : 0));
 
     memcpy(&opaque_, header_.data() + 12, sizeof(opaque_));
     opaque_ = utils::byte_swap(opaque_);
@@ -174,6 +198,12 @@ public:
     parse_framing_extras();
     bool parsed =
       body_.parse(status_, header_, framing_extras_size_, key_size_, extras_size_, data_, info_);
+    if constexpr (accepts_separate_value<Body>::value) {
+      if (parsed && value_) {
+        body_.assign_value(std::move(*value_));
+        value_.reset();
+      }
+    }
     if (status_ != key_value_status_code::success && !parsed && has_json_datatype(data_type_)) {
       key_value_extended_error_info err;
       std::vector<std::uint8_t>::difference_type offset =
@@ -21,6 +21,7 @@
 #include "core/utils/unsigned_leb128.hxx"
 
 #include <cstring>
+#include <utility>
 #include <gsl/assert>
 
 namespace couchbase::core::protocol
@@ -31,7 +32,7 @@ get_response_body::parse(key_value_status_code status,
                          std::uint8_t framing_extras_size,
                          std::uint16_t key_size,
                          std::uint8_t extras_size,
-                         const std::vector<std::byte>& body,
+                         std::vector<std::byte>& body,
                          const cmd_info& /* info */) -> bool
 {
   Expects(header[1] == static_cast<std::byte>(opcode));
@@ -45,7 +46,9 @@ get_response_body::parse(key_value_status_code status,
       offset += extras_size;
     }
     offset += key_size;
-    value_.assign(body.begin() + offset, body.end());
+    // take over the buffer of the small frame, large values are adopted by assign_value()
+    value_ = std::move(body);
+    value_.erase(value_.begin(), value_.begin() + offset);
     return true;
   }
   return false;
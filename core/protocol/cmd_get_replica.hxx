@@ -35,11 +35,21 @@ private:
 public:
   static const inline client_opcode opcode = client_opcode::get_replica;
 
-  [[nodiscard]] auto value() const -> const auto&
+  [[nodiscard]] auto value() const& -> const std::vector<std::byte>&
   {
     return value_;
   }
 
+  [[nodiscard]] auto value() && -> std::vector<std::byte>
+  {
+    return std::move(value_);
+  }
+
+  void assign_value(std::vector<std::byte>&& value)
+  {
+    value_ = std::move(value);
+  }
+
   [[nodiscard]] auto flags() const -> std::uint32_t;
 
   [[nodiscard]] auto parse(key_value_status_code status,
@@ -47,7 +57,7 @@ public:
                            std::uint8_t framing_extras_size,
                            std::uint16_t key_size,
                            std::uint8_t extras_size,
-                           const std::vector<std::byte>& body,
+                           std::vector<std::byte>& body,
                            const cmd_info& info) -> bool;
 };
 
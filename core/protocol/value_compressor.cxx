@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "value_compressor.hxx"
+
+#include <fmt/format.h>
+#include <gsl/util>
+#include <snappy.h>
+
+namespace couchbase::core::protocol
+{
+value_compressor::value_compressor(std::size_t min_size, double min_ratio)
+  : min_size_{ min_size }
+  , min_ratio_{ min_ratio }
+{
+}
+
+auto
+value_compressor::should_compress(std::size_t value_size) -> bool
+{
+  if (value_size == 0 || value_size < min_size_) {
+    skipped_values_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+auto
+value_compressor::max_compressed_length(std::size_t value_size) -> std::size_t
+{
+  return snappy::MaxCompressedLength(value_size);
+}
+
+auto
+value_compressor::compress(const std::byte* value,
+                           std::size_t value_size,
+                           std::byte* output) -> std::size_t
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t compressed_size{ 0 };
+  snappy::RawCompress(reinterpret_cast<const char*>(value),
+                      value_size,
+                      reinterpret_cast<char*>(output),
+                      &compressed_size);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  compression_time_ns_.fetch_add(
+    gsl::narrow_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+    std::memory_order_relaxed);
+  input_bytes_.fetch_add(value_size, std::memory_order_relaxed);
+
+  if (gsl::narrow_cast<double>(compressed_size) / gsl::narrow_cast<double>(value_size) <
+      min_ratio_) {
+    compressed_values_.fetch_add(1, std::memory_order_relaxed);
+    saved_bytes_.fetch_add(value_size - compressed_size, std::memory_order_relaxed);
+    return compressed_size;
+  }
+  rejected_values_.fetch_add(1, std::memory_order_relaxed);
+  return 0;
+}
+
+auto
+value_compressor::min_size() const -> std::size_t
+{
+  return min_size_;
+}
+
+auto
+value_compressor::min_ratio() const -> double
+{
+  return min_ratio_;
+}
+
+auto
+value_compressor::stats() const -> value_compressor_stats
+{
+  return {
+    compressed_values_.load(std::memory_order_relaxed),
+    rejected_values_.load(std::memory_order_relaxed),
+    skipped_values_.load(std::memory_order_relaxed),
+    input_bytes_.load(std::memory_order_relaxed),
+    saved_bytes_.load(std::memory_order_relaxed),
+    std::chrono::nanoseconds{ compression_time_ns_.load(std::memory_order_relaxed) },
+  };
+}
+
+auto
+to_string(const value_compressor_stats& stats) -> std::string
+{
+  return fmt::format("compressed_values={}, rejected_values={}, skipped_values={}, "
+                     "compression_input_bytes={}, compression_saved_bytes={}, "
+                     "compression_time_us={}",
+                     stats.compressed_values,
+                     stats.rejected_values,
+                     stats.skipped_values,
+                     stats.input_bytes,
+                     stats.saved_bytes,
+                     std::chrono::duration_cast<std::chrono::microseconds>(stats.compression_time)
+                       .count());
+}
+} // namespace couchbase::core::protocol
@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace couchbase::core::protocol
+{
+struct value_compressor_stats {
+  /// values, that were sent compressed
+  std::uint64_t compressed_values{ 0 };
+  /// values, that were compressed, but did not satisfy the ratio, and were sent as is
+  std::uint64_t rejected_values{ 0 };
+  /// values, that were smaller than the minimal size and were not compressed at all
+  std::uint64_t skipped_values{ 0 };
+  /// total size of the values passed to the compressor
+  std::uint64_t input_bytes{ 0 };
+  /// how many bytes have been saved on the wire by the compressed values
+  std::uint64_t saved_bytes{ 0 };
+  /// time spent in the compressor, including the rejected values
+  std::chrono::nanoseconds compression_time{ 0 };
+};
+
+/**
+ * Snappy compressor for document values, configured with compression_options of the cluster.
+ *
+ * The compressor writes directly into the destination buffer, and only reports success when the
+ * value shrinks at least to min_ratio of its original size. It also collects counters, that allow
+ * to compare the bytes saved with the time spent compressing.
+ */
+class value_compressor
+{
+public:
+  static constexpr std::size_t default_min_size{ 32 };
+  static constexpr double default_min_ratio{ 0.83 };
+
+  value_compressor() = default;
+  value_compressor(std::size_t min_size, double min_ratio);
+  value_compressor(const value_compressor&) = delete;
+  value_compressor(value_compressor&&) = delete;
+  auto operator=(const value_compressor&) -> value_compressor& = delete;
+  auto operator=(value_compressor&&) -> value_compressor& = delete;
+  ~value_compressor() = default;
+
+  /**
+   * @return true if the value is large enough to be compressed. Small values counted as skipped.
+   */
+  [[nodiscard]] auto should_compress(std::size_t value_size) -> bool;
+
+  /**
+   * @return size of the buffer, that is always enough to hold compressed value
+   */
+  [[nodiscard]] static auto max_compressed_length(std::size_t value_size) -> std::size_t;
+
+  /**
+   * Compresses the value into the output, that must have at least max_compressed_length() bytes.
+   *
+   * @return size of the compressed value, or zero if the compression is not worth it, and the
+   * original value should be sent.
+   */
+  auto compress(const std::byte* value, std::size_t value_size, std::byte* output) -> std::size_t;
+
+  [[nodiscard]] auto min_size() const -> std::size_t;
+  [[nodiscard]] auto min_ratio() const -> double;
+  [[nodiscard]] auto stats() const -> value_compressor_stats;
+
+private:
+  const std::size_t min_size_{ default_min_size };
+  const double min_ratio_{ default_min_ratio };
+
+  std::atomic_uint64_t compressed_values_{ 0 };
+  std::atomic_uint64_t rejected_values_{ 0 };
+  std::atomic_uint64_t skipped_values_{ 0 };
+  std::atomic_uint64_t input_bytes_{ 0 };
+  std::atomic_uint64_t saved_bytes_{ 0 };
+  std::atomic_uint64_t compression_time_ns_{ 0 };
+};
+
+[[nodiscard]] auto
+to_string(const value_compressor_stats& stats) -> std::string;
+} // namespace couchbase::core::protocol
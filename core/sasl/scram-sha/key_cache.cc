@@ -0,0 +1,128 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#include "key_cache.h"
+
+#include "core/logger/logger.hxx"
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+
+ScramKeys::~ScramKeys()
+{
+  wipe();
+}
+
+void
+ScramKeys::wipe()
+{
+  couchbase::core::crypto::cleanse(saltedPassword);
+  couchbase::core::crypto::cleanse(clientKey);
+  couchbase::core::crypto::cleanse(serverKey);
+}
+
+KeyCache::Entry::~Entry()
+{
+  couchbase::core::crypto::cleanse(passwordFingerprint);
+}
+
+KeyCache&
+KeyCache::instance()
+{
+  static KeyCache cache;
+  return cache;
+}
+
+ScramKeys
+KeyCache::get(Mechanism mechanism,
+              couchbase::core::crypto::Algorithm algorithm,
+              const std::string& username,
+              const std::string& password,
+              const std::string& salt,
+              unsigned int iterationCount)
+{
+  // the fingerprint is keyed by the salt, so it does not reveal equal
+  // passwords of the different users
+  auto fingerprint = couchbase::core::crypto::CBC_HMAC(algorithm, salt, password);
+  Key key{ username, mechanism, salt, iterationCount };
+
+  std::shared_ptr<Entry> entry;
+  {
+    const std::scoped_lock lock(mutex);
+    if (auto it = entries.find(key); it != entries.end()) {
+      if (it->second->passwordFingerprint == fingerprint) {
+        ++counters.hits;
+        couchbase::core::crypto::cleanse(fingerprint);
+        entry = it->second;
+      } else {
+        CB_LOG_DEBUG("SCRAM: credentials have been changed, wiping cached keys for the user");
+        entries.erase(it);
+      }
+    }
+    if (!entry) {
+      ++counters.misses;
+      if (entries.size() >= maxEntries) {
+        clearLocked();
+      }
+      entry = std::make_shared<Entry>();
+      entry->passwordFingerprint = std::move(fingerprint);
+      entries.try_emplace(std::move(key), entry);
+    }
+  }
+
+  // The sessions reconnecting at the same time use the same salt, so all
+  // but the first one will wait for the result instead of repeating the
+  // derivation. If it throws, the next caller derives the keys again.
+  std::call_once(entry->derived, [&entry, algorithm, &password, &salt, iterationCount]() {
+    entry->keys.saltedPassword =
+      couchbase::core::crypto::PBKDF2_HMAC(algorithm, password, salt, iterationCount);
+    entry->keys.clientKey =
+      couchbase::core::crypto::CBC_HMAC(algorithm, entry->keys.saltedPassword, "Client Key");
+    entry->keys.serverKey =
+      couchbase::core::crypto::CBC_HMAC(algorithm, entry->keys.saltedPassword, "Server Key");
+  });
+  return entry->keys;
+}
+
+void
+KeyCache::clear()
+{
+  const std::scoped_lock lock(mutex);
+  clearLocked();
+}
+
+void
+KeyCache::clearLocked()
+{
+  // the entries still used by the sessions are wiped when they release them
+  entries.clear();
+}
+
+std::size_t
+KeyCache::size() const
+{
+  const std::scoped_lock lock(mutex);
+  return entries.size();
+}
+
+KeyCacheStats
+KeyCache::stats() const
+{
+  const std::scoped_lock lock(mutex);
+  return counters;
+}
+
+} // namespace couchbase::core::sasl::mechanism::scram
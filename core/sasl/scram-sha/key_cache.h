@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include "core/crypto/cbcrypto.h"
+#include "core/sasl/mechanism.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+
+/**
+ * The keys derived from the password, that do not depend on the nonces
+ * of the particular authentication exchange.
+ */
+struct ScramKeys {
+  std::string saltedPassword;
+  std::string clientKey;
+  std::string serverKey;
+
+  ScramKeys() = default;
+  ScramKeys(const ScramKeys&) = default;
+  ScramKeys(ScramKeys&&) = default;
+  ScramKeys& operator=(const ScramKeys&) = default;
+  ScramKeys& operator=(ScramKeys&&) = default;
+  ~ScramKeys();
+
+  /**
+   * Overwrite all keys with zeros.
+   */
+  void wipe();
+};
+
+struct KeyCacheStats {
+  std::uint64_t hits{ 0 };
+  std::uint64_t misses{ 0 };
+};
+
+/**
+ * Process-wide cache of the SCRAM keys.
+ *
+ * Deriving SaltedPassword with PBKDF2 takes thousands of HMAC iterations,
+ * and every connection to every node repeats it with the same salt, so
+ * reconnecting all sessions after a failover or rebalance would burn a lot
+ * of CPU on the IO threads. The keys are cached by user, mechanism, salt
+ * and iteration count. The entry also remembers the fingerprint of the
+ * password, so that when the credentials change, the stale keys are wiped
+ * and derived again.
+ */
+class KeyCache
+{
+public:
+  static constexpr std::size_t maxEntries{ 64 };
+
+  static KeyCache& instance();
+
+  /**
+   * Return the keys for the given parameters, and derive them when they
+   * are not in the cache yet.
+   *
+   * @throws std::runtime_error - Failures generating the keys
+   */
+  ScramKeys get(Mechanism mechanism,
+                couchbase::core::crypto::Algorithm algorithm,
+                const std::string& username,
+                const std::string& password,
+                const std::string& salt,
+                unsigned int iterationCount);
+
+  /**
+   * Wipe all cached keys.
+   */
+  void clear();
+
+  [[nodiscard]] std::size_t size() const;
+
+  [[nodiscard]] KeyCacheStats stats() const;
+
+private:
+  using Key = std::tuple<std::string, Mechanism, std::string, unsigned int>;
+
+  /**
+   * The keys are derived outside of the cache lock, so only the callers
+   * asking for the same entry wait for each other. A caller may still hold
+   * the entry after it has been evicted, the keys are wiped when the last
+   * one releases it.
+   */
+  struct Entry {
+    std::string passwordFingerprint;
+    std::once_flag derived;
+    ScramKeys keys;
+
+    Entry() = default;
+    Entry(const Entry&) = delete;
+    Entry(Entry&&) = delete;
+    Entry& operator=(const Entry&) = delete;
+    Entry& operator=(Entry&&) = delete;
+    ~Entry();
+  };
+
+  void clearLocked();
+
+  mutable std::mutex mutex;
+  std::map<Key, std::shared_ptr<Entry>> entries;
+  KeyCacheStats counters;
+};
+
+} // namespace couchbase::core::sasl::mechanism::scram
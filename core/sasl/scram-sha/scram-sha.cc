@@ -204,9 +204,7 @@ ScramShaBackend::addAttribute(std::ostream& out, char key, int value, bool more)
 std::string
 ScramShaBackend::getServerSignature()
 {
-  auto serverKey = couchbase::core::crypto::CBC_HMAC(algorithm, getSaltedPassword(), "Server Key");
-
-  return couchbase::core::crypto::CBC_HMAC(algorithm, serverKey, getAuthMessage());
+  return couchbase::core::crypto::CBC_HMAC(algorithm, getKeys().serverKey, getAuthMessage());
 }
 
 /**
@@ -224,7 +222,7 @@ ScramShaBackend::getServerSignature()
 std::string
 ScramShaBackend::getClientProof()
 {
-  auto clientKey = couchbase::core::crypto::CBC_HMAC(algorithm, getSaltedPassword(), "Client Key");
+  const auto& clientKey = getKeys().clientKey;
   auto storedKey = couchbase::core::crypto::digest(algorithm, clientKey);
   std::string authMessage = getAuthMessage();
   auto clientSignature = couchbase::core::crypto::CBC_HMAC(algorithm, storedKey, authMessage);
@@ -369,7 +367,10 @@ bool
 ClientBackend::generateSaltedPassword(const std::string& secret)
 {
   try {
-    saltedPassword = couchbase::core::crypto::PBKDF2_HMAC(algorithm, secret, salt, iterationCount);
+    // ClientKey and ServerKey do not depend on the nonces either, so they are cached along with
+    // the SaltedPassword
+    keys = KeyCache::instance().get(
+      mechanism, algorithm, usernameCallback(), secret, salt, iterationCount);
     return true;
   } catch (...) {
     return false;
@@ -30,6 +30,7 @@
 
 #include "core/sasl/client.h"
 #include "core/sasl/mechanism.h"
+#include "key_cache.h"
 
 #include <array>
 #include <iostream>
@@ -84,7 +85,7 @@ protected:
 
   std::string getClientProof();
 
-  virtual std::string getSaltedPassword() = 0;
+  virtual const ScramKeys& getKeys() = 0;
 
   /**
    * Get the AUTH message (as specified in the RFC)
@@ -126,15 +127,15 @@ public:
 protected:
   bool generateSaltedPassword(const std::string& secret);
 
-  std::string getSaltedPassword() override
+  const ScramKeys& getKeys() override
   {
-    if (saltedPassword.empty()) {
-      throw std::logic_error("getSaltedPassword called before salted password is initialized");
+    if (keys.saltedPassword.empty()) {
+      throw std::logic_error("getKeys called before salted password is initialized");
     }
-    return saltedPassword;
+    return keys;
   }
 
-  std::string saltedPassword;
+  ScramKeys keys;
   std::string salt;
   unsigned int iterationCount = 4096;
 };
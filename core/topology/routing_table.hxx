@@ -0,0 +1,164 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "configuration.hxx"
+#include "core/utils/crc32.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::topology
+{
+/**
+ * Immutable snapshot of everything needed to route a KV operation: the vBucket map flattened into
+ * single array, and the sessions indexed by the node index. Every node might have additional
+ * sessions, when more than one connection is opened to each node.
+ *
+ * The snapshot is rebuilt whenever the configuration or the set of sessions changes, so that the
+ * operations can be routed without taking the locks that protect them.
+ */
+template<typename Session>
+class routing_table
+{
+public:
+  routing_table() = default;
+
+  routing_table(const std::optional<configuration>& config,
+                const std::map<std::size_t, Session>& sessions,
+                const std::map<std::size_t, std::vector<Session>>& extra_sessions = {})
+    : number_of_sessions_{ sessions.size() }
+  {
+    if (config) {
+      rev_ = config->rev_str();
+      if (const auto& vbmap = config->vbmap; vbmap && !vbmap->empty()) {
+        number_of_vbuckets_ = vbmap->size();
+        for (const auto& vbucket : vbmap.value()) {
+          stride_ = std::max(stride_, vbucket.size());
+        }
+        servers_.resize(number_of_vbuckets_ * stride_, -1);
+        for (std::size_t vbucket = 0; vbucket < number_of_vbuckets_; ++vbucket) {
+          std::copy(vbmap->at(vbucket).begin(),
+                    vbmap->at(vbucket).end(),
+                    servers_.begin() + static_cast<std::ptrdiff_t>(vbucket * stride_));
+        }
+      }
+    }
+    if (!sessions.empty()) {
+      sessions_.resize(sessions.rbegin()->first + 1);
+      for (const auto& [index, session] : sessions) {
+        auto& connections = sessions_[index];
+        connections.emplace_back(session);
+        if (auto extra = extra_sessions.find(index); extra != extra_sessions.end()) {
+          connections.insert(connections.end(), extra->second.begin(), extra->second.end());
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] auto rev_str() const -> const std::string&
+  {
+    return rev_;
+  }
+
+  [[nodiscard]] auto number_of_sessions() const -> std::size_t
+  {
+    return number_of_sessions_;
+  }
+
+  [[nodiscard]] auto server_by_vbucket(std::uint16_t vbucket, std::size_t index) const
+    -> std::optional<std::size_t>
+  {
+    if (vbucket >= number_of_vbuckets_ || index >= stride_) {
+      return {};
+    }
+    if (auto server_index = servers_[vbucket * stride_ + index]; server_index >= 0) {
+      return static_cast<std::size_t>(server_index);
+    }
+    return {};
+  }
+
+  template<typename Key>
+  [[nodiscard]] auto map_key(const Key& key, std::size_t index) const
+    -> std::pair<std::uint16_t, std::optional<std::size_t>>
+  {
+    if (number_of_vbuckets_ == 0) {
+      return { 0, {} };
+    }
+    const std::uint32_t crc = utils::hash_crc32(key.data(), key.size());
+    auto vbucket = static_cast<std::uint16_t>(crc % number_of_vbuckets_);
+    return { vbucket, server_by_vbucket(vbucket, index) };
+  }
+
+  [[nodiscard]] auto find_session(std::size_t index) const -> std::optional<Session>
+  {
+    if (index < sessions_.size() && !sessions_[index].empty()) {
+      return sessions_[index].front();
+    }
+    return {};
+  }
+
+  /**
+   * Returns the session of the node with the lowest score, e.g. the least loaded connection. The
+   * first session of the node wins the ties.
+   */
+  template<typename Score>
+  [[nodiscard]] auto select_session(std::size_t index, Score&& score) const
+    -> std::optional<Session>
+  {
+    if (index >= sessions_.size() || sessions_[index].empty()) {
+      return {};
+    }
+    const auto& candidates = sessions_[index];
+    auto best = candidates.begin();
+    if (candidates.size() > 1) {
+      auto best_score = score(*best);
+      for (auto it = std::next(best); it != candidates.end(); ++it) {
+        if (auto current_score = score(*it); current_score < best_score) {
+          best = it;
+          best_score = current_score;
+        }
+      }
+    }
+    return *best;
+  }
+
+  [[nodiscard]] auto find_sessions(std::size_t index) const -> std::vector<Session>
+  {
+    if (index < sessions_.size()) {
+      return sessions_[index];
+    }
+    return {};
+  }
+
+private:
+  std::string rev_{ "<no-config>" };
+  std::size_t number_of_vbuckets_{ 0 };
+  std::size_t stride_{ 0 };
+  std::vector<std::int16_t> servers_{};
+  std::vector<std::vector<Session>> sessions_{};
+  std::size_t number_of_sessions_{ 0 };
+};
+} // namespace couchbase::core::topology
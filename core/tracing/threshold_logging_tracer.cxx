@@ -21,43 +21,91 @@
 
 #include "constants.hxx"
 #include "core/logger/logger.hxx"
-#include "core/meta/version.hxx"
-#include "core/platform/uuid.h"
 #include "core/service_type_fmt.hxx"
 #include "core/utils/json.hxx"
 
 #include <asio/steady_timer.hpp>
 #include <tao/json/value.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 namespace couchbase::core::tracing
 {
-struct reported_span {
-  std::chrono::microseconds duration;
-  tao::json::value payload;
+/**
+ * The tags, that might end up in the report. All other tags are not retained by the span.
+ */
+enum class reported_tag : std::size_t {
+  operation_id,
+  local_id,
+  local_socket,
+  remote_socket,
+  number_of_tags,
+};
 
-  auto operator<(const reported_span& other) const -> bool
-  {
-    return duration < other.duration;
+auto
+to_reported_tag(std::string_view name) -> std::optional<reported_tag>
+{
+  if (name == attributes::operation_id) {
+    return reported_tag::operation_id;
   }
-};
+  if (name == attributes::local_id) {
+    return reported_tag::local_id;
+  }
+  if (name == attributes::local_socket) {
+    return reported_tag::local_socket;
+  }
+  if (name == attributes::remote_socket) {
+    return reported_tag::remote_socket;
+  }
+  return {};
+}
+
+auto
+to_service_type(std::string_view service_name) -> std::optional<service_type>
+{
+  if (service_name == tracing::service::key_value) {
+    return service_type::key_value;
+  }
+  if (service_name == tracing::service::query) {
+    return service_type::query;
+  }
+  if (service_name == tracing::service::view) {
+    return service_type::view;
+  }
+  if (service_name == tracing::service::search) {
+    return service_type::search;
+  }
+  if (service_name == tracing::service::analytics) {
+    return service_type::analytics;
+  }
+  if (service_name == tracing::service::management) {
+    return service_type::management;
+  }
+  return {};
+}
 
-class threshold_logging_span
-  : public couchbase::tracing::request_span
-  , public std::enable_shared_from_this<threshold_logging_span>
+/**
+ * The span is created for every operation, while only the few of them exceed the threshold, so it
+ * keeps only the tags used by the reports, and does not allocate anything besides the values of
+ * these tags.
+ */
+class threshold_logging_span : public couchbase::tracing::request_span
 {
 private:
   std::chrono::system_clock::time_point start_{ std::chrono::system_clock::now() };
-  std::string id_{ uuid::to_string(uuid::random()) };
-  std::map<std::string, std::uint64_t> integer_tags_{};
-  std::map<std::string, std::string> string_tags_{
-    { attributes::system, "couchbase" },
-    { attributes::span_kind, "client" },
-    { attributes::component, couchbase::core::meta::sdk_id() },
-  };
+  std::array<std::optional<std::string>,
+             static_cast<std::size_t>(reported_tag::number_of_tags)>
+    tags_{};
+  std::optional<service_type> service_{};
+  bool orphan_{ false };
   std::chrono::microseconds duration_{ 0 };
   std::uint64_t last_server_duration_us_{ 0 };
   std::uint64_t total_server_duration_us_{ 0 };
@@ -79,19 +127,29 @@ public:
       last_server_duration_us_ = value;
       total_server_duration_us_ += value;
     }
-    integer_tags_.try_emplace(name, value);
   }
 
   void add_tag(const std::string& name, const std::string& value) override
   {
-    string_tags_.try_emplace(name, value);
+    if (name == tracing::attributes::service) {
+      if (!service_) {
+        service_ = to_service_type(value);
+      }
+    } else if (name == tracing::attributes::orphan) {
+      orphan_ = true;
+    } else if (auto tag = to_reported_tag(name); tag) {
+      // the first value of the tag is reported
+      if (auto& slot = tags_[static_cast<std::size_t>(tag.value())]; !slot) {
+        slot = value;
+      }
+    }
   }
 
   void end() override;
 
-  [[nodiscard]] auto string_tags() const -> const auto&
+  [[nodiscard]] auto tag(reported_tag tag) const -> const std::optional<std::string>&
   {
-    return string_tags_;
+    return tags_[static_cast<std::size_t>(tag)];
   }
 
   [[nodiscard]] auto duration() const -> std::chrono::microseconds
@@ -111,153 +169,162 @@ public:
 
   [[nodiscard]] auto orphan() const -> bool
   {
-    return string_tags_.find(tracing::attributes::orphan) != string_tags_.end();
+    return orphan_;
   }
 
   [[nodiscard]] auto is_key_value() const -> bool
   {
-    auto service_tag = string_tags_.find(tracing::attributes::service);
-    if (service_tag == string_tags_.end()) {
-      return false;
-    }
-    return service_tag->second == tracing::service::key_value;
+    return service_ == service_type::key_value;
   }
 
   [[nodiscard]] auto service() const -> std::optional<service_type>
   {
-    auto service_tag = string_tags_.find(tracing::attributes::service);
-    if (service_tag == string_tags_.end()) {
-      return {};
-    }
-    const auto& service_name = service_tag->second;
-    if (service_name == tracing::service::key_value) {
-      return service_type::key_value;
-    }
-    if (service_name == tracing::service::query) {
-      return service_type::query;
-    }
-    if (service_name == tracing::service::view) {
-      return service_type::view;
-    }
-    if (service_name == tracing::service::search) {
-      return service_type::search;
-    }
-    if (service_name == tracing::service::analytics) {
-      return service_type::analytics;
-    }
-    if (service_name == tracing::service::management) {
-      return service_type::management;
-    }
-    return {};
+    return service_;
   }
 };
 
-template<typename T>
-class concurrent_fixed_queue
-{
-private:
-  std::mutex mutex_;
-  std::priority_queue<T> data_;
-  std::size_t capacity_{};
-
-public:
-  using size_type = typename std::priority_queue<T>::size_type;
-
-  explicit concurrent_fixed_queue(std::size_t capacity)
-    : capacity_(capacity)
+/**
+ * Raw data of the span, that is formatted only when the report is emitted.
+ */
+struct reported_span {
+  std::chrono::microseconds duration{};
+  std::string operation_name{};
+  bool key_value{ false };
+  std::uint64_t last_server_duration_us{ 0 };
+  std::uint64_t total_server_duration_us{ 0 };
+  std::array<std::optional<std::string>, static_cast<std::size_t>(reported_tag::number_of_tags)>
+    tags{};
+
+  explicit reported_span(const threshold_logging_span& span)
+    : duration{ span.duration() }
+    , operation_name{ span.name() }
+    , key_value{ span.is_key_value() }
+    , last_server_duration_us{ span.last_server_duration_us() }
+    , total_server_duration_us{ span.total_server_duration_us() }
   {
+    for (std::size_t i = 0; i < tags.size(); ++i) {
+      tags[i] = span.tag(static_cast<reported_tag>(i));
+    }
   }
 
-  concurrent_fixed_queue(concurrent_fixed_queue& other)
+  [[nodiscard]] auto tag(reported_tag tag) const -> const std::optional<std::string>&
   {
-    std::unique_lock<std::mutex> lock(other.mutex_);
-    data_ = other.data_;
-    capacity_ = other.capacity_;
+    return tags[static_cast<std::size_t>(tag)];
   }
+};
 
-  concurrent_fixed_queue(const concurrent_fixed_queue& other) = delete;
-
-  concurrent_fixed_queue(concurrent_fixed_queue&& other) noexcept
-  {
-    std::unique_lock<std::mutex> lock(other.mutex_);
-    std::swap(data_, other.data_);
-    std::swap(capacity_, other.capacity_);
+auto
+to_json(const reported_span& span) -> tao::json::value
+{
+  tao::json::value entry{
+    { "operation_name", span.operation_name },
+    { "total_duration_us", span.duration.count() },
+  };
+  if (span.key_value) {
+    entry["last_server_duration_us"] = span.last_server_duration_us;
+    entry["total_server_duration_us"] = span.total_server_duration_us;
+  }
+  if (const auto& value = span.tag(reported_tag::operation_id); value) {
+    entry["last_operation_id"] = value.value();
+  }
+  if (const auto& value = span.tag(reported_tag::local_id); value) {
+    entry["last_local_id"] = value.value();
   }
+  if (const auto& value = span.tag(reported_tag::local_socket); value) {
+    entry["last_local_socket"] = value.value();
+  }
+  if (const auto& value = span.tag(reported_tag::remote_socket); value) {
+    entry["last_remote_socket"] = value.value();
+  }
+  return entry;
+}
 
-  void pop()
+/**
+ * Keeps the longest spans, up to the capacity. The spans are kept in the heap with the shortest
+ * span on top, so that it can be checked and evicted in constant time.
+ */
+class top_spans
+{
+public:
+  explicit top_spans(std::size_t capacity)
+    : capacity_{ capacity }
   {
-    std::unique_lock<std::mutex> lock(mutex_);
-    data_.pop();
   }
 
-  auto size() -> size_type
+  [[nodiscard]] auto accepts(std::chrono::microseconds duration) const -> bool
   {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return data_.size();
+    return spans_.size() < capacity_ || (!spans_.empty() && duration > spans_.front().duration);
   }
 
-  auto empty() -> bool
+  void push(reported_span&& span)
   {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return data_.empty();
+    if (!accepts(span.duration)) {
+      return;
+    }
+    if (spans_.size() == capacity_) {
+      std::pop_heap(spans_.begin(), spans_.end(), longer);
+      spans_.pop_back();
+    }
+    spans_.emplace_back(std::move(span));
+    std::push_heap(spans_.begin(), spans_.end(), longer);
   }
 
-  void emplace(const T&& item)
+  void merge(std::vector<reported_span>&& spans)
   {
-    std::unique_lock<std::mutex> lock(mutex_);
-    data_.emplace(std::forward<const T>(item));
-    if (data_.size() > capacity_) {
-      data_.pop();
+    for (auto& span : spans) {
+      push(std::move(span));
     }
   }
 
-  auto steal_data() -> std::priority_queue<T>
+  [[nodiscard]] auto empty() const -> bool
   {
-    std::priority_queue<T> data;
-    std::unique_lock<std::mutex> lock(mutex_);
-    std::swap(data, data_);
-    return data;
+    return spans_.empty();
   }
-};
 
-using fixed_span_queue = concurrent_fixed_queue<reported_span>;
-
-auto
-convert(std::shared_ptr<threshold_logging_span> span) -> reported_span
-{
-  tao::json::value entry{
-    { "operation_name", span->name() },
-    { "total_duration_us",
-      std::chrono::duration_cast<std::chrono::microseconds>(span->duration()).count() }
-  };
-  if (span->is_key_value()) {
-    entry["last_server_duration_us"] = span->last_server_duration_us();
-    entry["total_server_duration_us"] = span->total_server_duration_us();
+  auto take() -> std::vector<reported_span>
+  {
+    std::vector<reported_span> spans{};
+    std::swap(spans, spans_);
+    return spans;
   }
 
-  const auto& tags = span->string_tags();
-  auto pair = tags.find(attributes::operation_id);
-  if (pair != tags.end()) {
-    entry["last_operation_id"] = pair->second;
+  /**
+   * @return the spans ordered from the longest to the shortest
+   */
+  auto take_sorted() -> std::vector<reported_span>
+  {
+    std::sort_heap(spans_.begin(), spans_.end(), longer);
+    return take();
   }
 
-  pair = tags.find(attributes::local_id);
-  if (pair != tags.end()) {
-    entry["last_local_id"] = pair->second;
+private:
+  static auto longer(const reported_span& lhs, const reported_span& rhs) -> bool
+  {
+    return lhs.duration > rhs.duration;
   }
 
-  pair = tags.find(attributes::local_socket);
-  if (pair != tags.end()) {
-    entry["last_local_socket"] = pair->second;
-  }
+  std::size_t capacity_;
+  std::vector<reported_span> spans_{};
+};
 
-  pair = tags.find(attributes::remote_socket);
-  if (pair != tags.end()) {
-    entry["last_remote_socket"] = pair->second;
-  }
+constexpr std::size_t number_of_services{ static_cast<std::size_t>(service_type::eventing) + 1 };
 
-  return { span->duration(), std::move(entry) };
-}
+/**
+ * Spans collected by a single thread. The mutex is contended only when the reporter takes the
+ * spans, so the threads that end the slow spans do not wait for each other.
+ */
+struct span_buffer {
+  std::mutex mutex{};
+  top_spans orphans;
+  // indexed by service_type
+  std::vector<top_spans> thresholds;
+
+  explicit span_buffer(const threshold_logging_options& options)
+    : orphans{ options.orphaned_sample_size }
+    , thresholds(number_of_services, top_spans{ options.threshold_sample_size })
+  {
+  }
+};
 
 class threshold_logging_tracer_impl
 {
@@ -266,14 +333,7 @@ public:
     : options_(options)
     , emit_orphan_report_(ctx)
     , emit_threshold_report_(ctx)
-    , orphan_queue_{ options.orphaned_sample_size }
   {
-    threshold_queues_.try_emplace(service_type::key_value, options.threshold_sample_size);
-    threshold_queues_.try_emplace(service_type::query, options.threshold_sample_size);
-    threshold_queues_.try_emplace(service_type::view, options.threshold_sample_size);
-    threshold_queues_.try_emplace(service_type::search, options.threshold_sample_size);
-    threshold_queues_.try_emplace(service_type::analytics, options.threshold_sample_size);
-    threshold_queues_.try_emplace(service_type::management, options.threshold_sample_size);
   }
 
   ~threshold_logging_tracer_impl()
@@ -297,21 +357,28 @@ public:
     emit_threshold_report_.cancel();
   }
 
-  void add_orphan(std::shared_ptr<threshold_logging_span> span)
+  void add_orphan(const threshold_logging_span& span)
   {
-    orphan_queue_.emplace(convert(std::move(span)));
+    auto& buffer = local_buffer();
+    const std::scoped_lock lock(buffer.mutex);
+    if (buffer.orphans.accepts(span.duration())) {
+      buffer.orphans.push(reported_span{ span });
+    }
   }
 
-  void check_threshold(std::shared_ptr<threshold_logging_span> span)
+  void check_threshold(const threshold_logging_span& span)
   {
-    auto service = span->service();
+    auto service = span.service();
     if (!service.has_value()) {
       return;
     }
-    if (span->duration() > options_.threshold_for_service(service.value())) {
-      auto queue = threshold_queues_.find(service.value());
-      if (queue != threshold_queues_.end()) {
-        queue->second.emplace(convert(span));
+    if (span.duration() > options_.threshold_for_service(service.value())) {
+      auto& buffer = local_buffer();
+      const std::scoped_lock lock(buffer.mutex);
+      auto& spans = buffer.thresholds[static_cast<std::size_t>(service.value())];
+      // the record is not created for the span, that would be evicted immediately
+      if (spans.accepts(span.duration())) {
+        spans.push(reported_span{ span });
       }
     }
   }
@@ -341,23 +408,81 @@ private:
     });
   }
 
+  /**
+   * Returns the buffer of the current thread, and registers it on the first call.
+   */
+  auto local_buffer() -> span_buffer&
+  {
+    struct local_entry {
+      std::uint64_t tracer_id;
+      span_buffer* buffer;
+      std::weak_ptr<span_buffer> owner;
+    };
+    // the thread usually reports to the single tracer, so the list is short
+    thread_local std::vector<local_entry> local_buffers{};
+
+    for (const auto& entry : local_buffers) {
+      if (entry.tracer_id == id_) {
+        return *entry.buffer;
+      }
+    }
+    // forget the buffers of the destroyed tracers
+    local_buffers.erase(std::remove_if(local_buffers.begin(),
+                                       local_buffers.end(),
+                                       [](const local_entry& entry) {
+                                         return entry.owner.expired();
+                                       }),
+                        local_buffers.end());
+    auto buffer = std::make_shared<span_buffer>(options_);
+    {
+      const std::scoped_lock lock(buffers_mutex_);
+      buffers_.emplace_back(buffer);
+    }
+    local_buffers.push_back({ id_, buffer.get(), buffer });
+    return *buffer;
+  }
+
+  /**
+   * Merges the spans collected by all threads.
+   */
+  template<typename Selector>
+  auto collect(std::size_t capacity, Selector selector) -> std::vector<reported_span>
+  {
+    top_spans merged{ capacity };
+    const std::scoped_lock lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+      std::vector<reported_span> spans{};
+      {
+        const std::scoped_lock buffer_lock(buffer->mutex);
+        auto& collected = selector(*buffer);
+        if (collected.empty()) {
+          continue;
+        }
+        spans = collected.take();
+      }
+      merged.merge(std::move(spans));
+    }
+    return merged.take_sorted();
+  }
+
   void log_orphan_report()
   {
-    if (orphan_queue_.empty()) {
+    auto spans = collect(options_.orphaned_sample_size, [](span_buffer& buffer) -> top_spans& {
+      return buffer.orphans;
+    });
+    if (spans.empty()) {
       return;
     }
-    auto queue = orphan_queue_.steal_data();
     tao::json::value report{
-      { "count", queue.size() },
+      { "count", spans.size() },
 #if COUCHBASE_CXX_CLIENT_DEBUG_BUILD
       { "emit_interval_ms", options_.orphaned_emit_interval.count() },
       { "sample_size", options_.orphaned_sample_size },
 #endif
     };
     tao::json::value entries = tao::json::empty_array;
-    while (!queue.empty()) {
-      entries.emplace_back(queue.top().payload);
-      queue.pop();
+    for (const auto& span : spans) {
+      entries.emplace_back(to_json(span));
     }
     report["top"] = entries;
     CB_LOG_WARNING("Orphan responses observed: {}", utils::json::generate(report));
@@ -365,13 +490,16 @@ private:
 
   void log_threshold_report()
   {
-    for (auto& [service, threshold_queue] : threshold_queues_) {
-      if (threshold_queue.empty()) {
+    for (const auto service : reported_services) {
+      auto spans =
+        collect(options_.threshold_sample_size, [service](span_buffer& buffer) -> top_spans& {
+          return buffer.thresholds[static_cast<std::size_t>(service)];
+        });
+      if (spans.empty()) {
         continue;
       }
-      auto queue = threshold_queue.steal_data();
       tao::json::value report{
-        { "count", queue.size() },
+        { "count", spans.size() },
         { "service", fmt::format("{}", service) },
 #if COUCHBASE_CXX_CLIENT_DEBUG_BUILD
         { "emit_interval_ms", options_.threshold_emit_interval.count() },
@@ -383,21 +511,29 @@ private:
 #endif
       };
       tao::json::value entries = tao::json::empty_array;
-      while (!queue.empty()) {
-        entries.emplace_back(queue.top().payload);
-        queue.pop();
+      for (const auto& span : spans) {
+        entries.emplace_back(to_json(span));
       }
       report["top"] = entries;
       CB_LOG_WARNING("Operations over threshold: {}", utils::json::generate(report));
     }
   }
 
+  static constexpr std::array reported_services{
+    service_type::key_value, service_type::query,     service_type::analytics,
+    service_type::search,    service_type::view,      service_type::management,
+  };
+
+  inline static std::atomic_uint64_t next_id_{ 0 };
+
+  const std::uint64_t id_{ next_id_.fetch_add(1) };
   const threshold_logging_options& options_;
 
   asio::steady_timer emit_orphan_report_;
   asio::steady_timer emit_threshold_report_;
-  fixed_span_queue orphan_queue_;
-  std::map<service_type, fixed_span_queue> threshold_queues_{};
+
+  std::mutex buffers_mutex_{};
+  std::vector<std::shared_ptr<span_buffer>> buffers_{};
 };
 
 auto
@@ -409,12 +545,12 @@ threshold_logging_tracer::start_span(std::string name,
 }
 
 void
-threshold_logging_tracer::report(std::shared_ptr<threshold_logging_span> span)
+threshold_logging_tracer::report(const threshold_logging_span& span)
 {
-  if (span->orphan()) {
-    impl_->add_orphan(std::move(span));
+  if (span.orphan()) {
+    impl_->add_orphan(span);
   } else {
-    impl_->check_threshold(std::move(span));
+    impl_->check_threshold(span);
   }
 }
 
@@ -437,12 +573,24 @@ threshold_logging_tracer::stop()
   impl_->stop();
 }
 
+auto
+threshold_logging_tracer::options() const -> const threshold_logging_options&
+{
+  return options_;
+}
+
 void
 threshold_logging_span::end()
 {
   duration_ = std::chrono::duration_cast<std::chrono::microseconds>(
     std::chrono::system_clock::now() - start_);
-  tracer_->report(shared_from_this());
+  // fast path for the most of the spans: there is nothing to report, when the operation has not
+  // exceeded the threshold of its service
+  if (!orphan_ &&
+      (!service_ || duration_ <= tracer_->options().threshold_for_service(service_.value()))) {
+    return;
+  }
+  tracer_->report(*this);
 }
 
 } // namespace couchbase::core::tracing
@@ -40,7 +40,8 @@ public:
 
   auto start_span(std::string name, std::shared_ptr<couchbase::tracing::request_span> parent)
     -> std::shared_ptr<couchbase::tracing::request_span> override;
-  void report(std::shared_ptr<threshold_logging_span> span);
+  void report(const threshold_logging_span& span);
+  [[nodiscard]] auto options() const -> const threshold_logging_options&;
   void start() override;
   void stop() override;
 
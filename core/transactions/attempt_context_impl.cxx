@@ -36,6 +36,8 @@
 #include "internal/utils.hxx"
 #include "staged_mutation.hxx"
 
+#include <asio/post.hpp>
+
 namespace couchbase::core::transactions
 {
 
@@ -2124,20 +2126,6 @@ attempt_context_impl::atr_commit(bool ambiguity_resolution_mode)
 {
   retry_op<void>([self = shared_from_this(), &ambiguity_resolution_mode]() {
     try {
-      const std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id() + ".");
-      core::operations::mutate_in_request req{ self->atr_id_.value() };
-      req.specs =
-        couchbase::mutate_in_specs{
-          couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_STATUS,
-                                             attempt_state_name(attempt_state::COMMITTED))
-            .xattr(),
-          couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_START_COMMIT,
-                                             subdoc::mutate_in_macro::cas)
-            .xattr(),
-          couchbase::mutate_in_specs::insert(prefix + ATR_FIELD_PREVENT_COLLLISION, 0).xattr(),
-        }
-          .specs();
-      wrap_durable_request(req, self->overall_->config());
       auto ec = self->error_if_expired_and_not_in_overtime(STAGE_ATR_COMMIT, {});
       if (ec) {
         throw client_error(
@@ -2147,18 +2135,12 @@ attempt_context_impl::atr_commit(bool ambiguity_resolution_mode)
         return self->hooks_.before_atr_commit(self, std::move(handler));
       });
       if (ec) {
-        // for now, throw.  Later, if this is async, we will use error handler
-        // no doubt.
         throw client_error(
           *ec, fmt::format("before_atr_commit hook raised error, error_class={}", ec.value()));
       }
-      self->staged_mutations_->extract_to(prefix, req);
+      auto req = self->make_atr_commit_request();
       auto barrier = std::make_shared<std::promise<result>>();
       auto f = barrier->get_future();
-      CB_ATTEMPT_CTX_LOG_TRACE(self,
-                               "updating atr {}, setting to {}",
-                               req.id,
-                               attempt_state_name(attempt_state::COMMITTED));
       self->overall_->cluster_ref().execute(
         req, [barrier](const core::operations::mutate_in_response& resp) {
           barrier->set_value(result::create_from_subdoc_response(resp));
@@ -2172,85 +2154,181 @@ attempt_context_impl::atr_commit(bool ambiguity_resolution_mode)
       }
       self->state(attempt_state::COMMITTED);
     } catch (const client_error& e) {
-      const error_class ec = e.ec();
-      switch (ec) {
-        case FAIL_EXPIRY: {
-          self->expiry_overtime_mode_ = true;
-          auto out = transaction_operation_failed(ec, e.what()).no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          } else {
-            out.expired();
-          }
-          throw out;
-        }
-        case FAIL_AMBIGUOUS:
-          CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr_commit got FAIL_AMBIGUOUS, resolving ambiguity...");
-          ambiguity_resolution_mode = true;
-          throw retry_operation(e.what());
-        case FAIL_TRANSIENT:
-          if (ambiguity_resolution_mode) {
-            throw retry_operation(e.what());
-          }
-          throw transaction_operation_failed(ec, e.what()).retry();
+      self->handle_atr_commit_error(e, ambiguity_resolution_mode);
+      // Need retry_op as atr_commit_ambiguity_resolution can throw
+      // retry_operation
+      return retry_op<void>([self]() {
+        return self->atr_commit_ambiguity_resolution();
+      });
+    }
+  });
+}
 
-        case FAIL_PATH_ALREADY_EXISTS:
-          // Need retry_op as atr_commit_ambiguity_resolution can throw
-          // retry_operation
-          return retry_op<void>([self]() {
-            return self->atr_commit_ambiguity_resolution();
-          });
-        case FAIL_HARD: {
-          auto out = transaction_operation_failed(ec, e.what()).no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
-        }
-        case FAIL_DOC_NOT_FOUND: {
-          auto out = transaction_operation_failed(ec, e.what())
-                       .cause(external_exception::ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
-                       .no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
-        }
-        case FAIL_PATH_NOT_FOUND: {
-          auto out = transaction_operation_failed(ec, e.what())
-                       .cause(external_exception::ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
-                       .no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
-        }
-        case FAIL_ATR_FULL: {
-          auto out = transaction_operation_failed(ec, e.what())
-                       .cause(external_exception::ACTIVE_TRANSACTION_RECORD_FULL)
-                       .no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
+void
+attempt_context_impl::atr_commit(bool ambiguity_resolution_mode,
+                                 std::shared_ptr<async_constant_delay> delay,
+                                 VoidCallback&& cb)
+{
+  auto handler = [self = shared_from_this(), ambiguity_resolution_mode, delay, cb = std::move(cb)](
+                   const std::optional<client_error>& e) mutable {
+    if (!e) {
+      self->state(attempt_state::COMMITTED);
+      return cb({});
+    }
+    try {
+      self->handle_atr_commit_error(e.value(), ambiguity_resolution_mode);
+    } catch (const retry_operation&) {
+      return (*delay)([self, ambiguity_resolution_mode, delay, cb = std::move(cb)](
+                        const std::exception_ptr& exc) mutable {
+        if (exc) {
+          return cb(exc);
         }
-        default: {
-          CB_ATTEMPT_CTX_LOG_ERROR(self,
-                                   "failed to commit transaction {}, attempt {}, "
-                                   "ambiguity_resolution_mode {}, with error {}",
-                                   self->transaction_id(),
-                                   self->id(),
-                                   ambiguity_resolution_mode,
-                                   e.what());
-          auto out = transaction_operation_failed(ec, e.what());
-          if (ambiguity_resolution_mode) {
-            out.no_rollback().ambiguous();
+        CB_ATTEMPT_CTX_LOG_TRACE(self, "retrying atr_commit");
+        self->atr_commit(ambiguity_resolution_mode, delay, std::move(cb));
+      });
+    } catch (const transaction_operation_failed&) {
+      return cb(std::current_exception());
+    }
+    self->atr_commit_ambiguity_resolution(delay, std::move(cb));
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_COMMIT, {});
+  if (ec) {
+    return handler(client_error(
+      *ec, fmt::format("atr_commit check for expiry threw error, error_class={}", ec.value())));
+  }
+  hooks_.before_atr_commit(
+    shared_from_this(),
+    [self = shared_from_this(), handler = std::move(handler)](std::optional<error_class> ec) mutable {
+      if (ec) {
+        return handler(client_error(
+          *ec, fmt::format("before_atr_commit hook raised error, error_class={}", ec.value())));
+      }
+      auto req = self->make_atr_commit_request();
+      self->overall_->cluster_ref().execute(
+        req,
+        [self, handler = std::move(handler)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res, false);
+          } catch (const client_error& e) {
+            return handler(e);
           }
-          throw out;
-        }
+          self->hooks_.after_atr_commit(
+            self, [handler = std::move(handler)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return handler(client_error(*ec, "after_atr_commit hook raised error"));
+              }
+              handler({});
+            });
+        });
+    });
+}
+
+auto
+attempt_context_impl::make_atr_commit_request() -> core::operations::mutate_in_request
+{
+  const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id() + ".");
+  // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  core::operations::mutate_in_request req{ atr_id_.value() };
+  req.specs =
+    couchbase::mutate_in_specs{
+      couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_STATUS,
+                                         attempt_state_name(attempt_state::COMMITTED))
+        .xattr(),
+      couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_START_COMMIT,
+                                         subdoc::mutate_in_macro::cas)
+        .xattr(),
+      couchbase::mutate_in_specs::insert(prefix + ATR_FIELD_PREVENT_COLLLISION, 0).xattr(),
+    }
+      .specs();
+  wrap_durable_request(req, overall_->config());
+  staged_mutations_->extract_to(prefix, req);
+  CB_ATTEMPT_CTX_LOG_TRACE(
+    this, "updating atr {}, setting to {}", req.id, attempt_state_name(attempt_state::COMMITTED));
+  return req;
+}
+
+void
+attempt_context_impl::handle_atr_commit_error(const client_error& e,
+                                              bool& ambiguity_resolution_mode)
+{
+  const error_class ec = e.ec();
+  switch (ec) {
+    case FAIL_EXPIRY: {
+      expiry_overtime_mode_ = true;
+      auto out = transaction_operation_failed(ec, e.what()).no_rollback();
+      if (ambiguity_resolution_mode) {
+        out.ambiguous();
+      } else {
+        out.expired();
       }
+      throw out;
     }
-  });
+    case FAIL_AMBIGUOUS:
+      CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_commit got FAIL_AMBIGUOUS, resolving ambiguity...");
+      ambiguity_resolution_mode = true;
+      throw retry_operation(e.what());
+    case FAIL_TRANSIENT:
+      if (ambiguity_resolution_mode) {
+        throw retry_operation(e.what());
+      }
+      throw transaction_operation_failed(ec, e.what()).retry();
+
+    case FAIL_PATH_ALREADY_EXISTS:
+      // the caller resolves the ambiguity by reading the status from the ATR
+      return;
+    case FAIL_HARD: {
+      auto out = transaction_operation_failed(ec, e.what()).no_rollback();
+      if (ambiguity_resolution_mode) {
+        out.ambiguous();
+      }
+      throw out;
+    }
+    case FAIL_DOC_NOT_FOUND: {
+      auto out = transaction_operation_failed(ec, e.what())
+                   .cause(external_exception::ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
+                   .no_rollback();
+      if (ambiguity_resolution_mode) {
+        out.ambiguous();
+      }
+      throw out;
+    }
+    case FAIL_PATH_NOT_FOUND: {
+      auto out = transaction_operation_failed(ec, e.what())
+                   .cause(external_exception::ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
+                   .no_rollback();
+      if (ambiguity_resolution_mode) {
+        out.ambiguous();
+      }
+      throw out;
+    }
+    case FAIL_ATR_FULL: {
+      auto out = transaction_operation_failed(ec, e.what())
+                   .cause(external_exception::ACTIVE_TRANSACTION_RECORD_FULL)
+                   .no_rollback();
+      if (ambiguity_resolution_mode) {
+        out.ambiguous();
+      }
+      throw out;
+    }
+    default: {
+      CB_ATTEMPT_CTX_LOG_ERROR(this,
+                               "failed to commit transaction {}, attempt {}, "
+                               "ambiguity_resolution_mode {}, with error {}",
+                               transaction_id(),
+                               id(),
+                               ambiguity_resolution_mode,
+                               e.what());
+      auto out = transaction_operation_failed(ec, e.what());
+      if (ambiguity_resolution_mode) {
+        out.no_rollback().ambiguous();
+      }
+      throw out;
+    }
+  }
 }
 
 void
@@ -2279,44 +2357,120 @@ attempt_context_impl::atr_commit_ambiguity_resolution()
                                       barrier->set_value(result::create_from_subdoc_response(resp));
                                     });
     auto res = wrap_operation_future(f);
-    auto atr_status_raw = res.values[0].content_as<std::string>();
-    CB_ATTEMPT_CTX_LOG_DEBUG(
-      this, "atr_commit_ambiguity_resolution read atr state {}", atr_status_raw);
-    auto atr_status = attempt_state_value(atr_status_raw);
-    switch (atr_status) {
-      case attempt_state::COMMITTED:
-        return;
-      case attempt_state::ABORTED:
-        // aborted by another process?
-        throw transaction_operation_failed(FAIL_OTHER, "transaction aborted externally").retry();
-      default:
-        throw transaction_operation_failed(FAIL_OTHER,
-                                           "unexpected state found on ATR ambiguity resolution")
-          .cause(ILLEGAL_STATE_EXCEPTION)
-          .no_rollback();
-    }
+    check_atr_commit_ambiguity_resolution_result(res);
   } catch (const client_error& e) {
-    const error_class ec = e.ec();
-    switch (ec) {
-      case FAIL_EXPIRY:
-      case FAIL_HARD:
-        throw transaction_operation_failed(ec, e.what()).no_rollback().ambiguous();
-      case FAIL_TRANSIENT:
-      case FAIL_OTHER:
-        throw retry_operation(e.what());
-      case FAIL_PATH_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
-          .no_rollback()
-          .ambiguous();
-      case FAIL_DOC_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
-          .no_rollback()
-          .ambiguous();
-      default:
-        throw transaction_operation_failed(ec, e.what()).no_rollback().ambiguous();
+    handle_atr_commit_ambiguity_resolution_error(e);
+  }
+}
+
+void
+attempt_context_impl::atr_commit_ambiguity_resolution(std::shared_ptr<async_constant_delay> delay,
+                                                      VoidCallback&& cb)
+{
+  auto handler = [self = shared_from_this(), delay, cb = std::move(cb)](
+                   const std::optional<client_error>& e,
+                   const std::exception_ptr& failed = {}) mutable {
+    if (failed) {
+      return cb(failed);
     }
+    if (!e) {
+      return cb({});
+    }
+    try {
+      self->handle_atr_commit_ambiguity_resolution_error(e.value());
+    } catch (const retry_operation&) {
+      return (*delay)(
+        [self, delay, cb = std::move(cb)](const std::exception_ptr& exc) mutable {
+          if (exc) {
+            return cb(exc);
+          }
+          CB_ATTEMPT_CTX_LOG_TRACE(self, "retrying atr_commit_ambiguity_resolution");
+          self->atr_commit_ambiguity_resolution(delay, std::move(cb));
+        });
+    } catch (const transaction_operation_failed&) {
+      return cb(std::current_exception());
+    }
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_COMMIT_AMBIGUITY_RESOLUTION, {});
+  if (ec) {
+    return handler(client_error(*ec, "atr_commit_ambiguity_resolution raised error"));
+  }
+  hooks_.before_atr_commit_ambiguity_resolution(
+    shared_from_this(),
+    [self = shared_from_this(), handler = std::move(handler)](std::optional<error_class> ec) mutable {
+      if (ec) {
+        return handler(client_error(*ec, "before_atr_commit_ambiguity_resolution hook threw error"));
+      }
+      const std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id() + ".");
+      // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+      // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+      core::operations::lookup_in_request req{ self->atr_id_.value() };
+      req.specs =
+        lookup_in_specs{ lookup_in_specs::get(prefix + ATR_FIELD_STATUS).xattr() }.specs();
+      self->overall_->cluster_ref().execute(
+        req,
+        [self, handler = std::move(handler)](
+          const core::operations::lookup_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+            self->check_atr_commit_ambiguity_resolution_result(res);
+          } catch (const client_error& e) {
+            return handler(e);
+          } catch (const transaction_operation_failed&) {
+            // the ATR has not been committed, this is not retryable
+            return handler({}, std::current_exception());
+          }
+          handler({});
+        });
+    });
+}
+
+void
+attempt_context_impl::check_atr_commit_ambiguity_resolution_result(const result& res)
+{
+  auto atr_status_raw = res.values[0].content_as<std::string>();
+  CB_ATTEMPT_CTX_LOG_DEBUG(
+    this, "atr_commit_ambiguity_resolution read atr state {}", atr_status_raw);
+  auto atr_status = attempt_state_value(atr_status_raw);
+  switch (atr_status) {
+    case attempt_state::COMMITTED:
+      return;
+    case attempt_state::ABORTED:
+      // aborted by another process?
+      throw transaction_operation_failed(FAIL_OTHER, "transaction aborted externally").retry();
+    default:
+      throw transaction_operation_failed(FAIL_OTHER,
+                                         "unexpected state found on ATR ambiguity resolution")
+        .cause(ILLEGAL_STATE_EXCEPTION)
+        .no_rollback();
+  }
+}
+
+void
+attempt_context_impl::handle_atr_commit_ambiguity_resolution_error(const client_error& e)
+{
+  const error_class ec = e.ec();
+  switch (ec) {
+    case FAIL_EXPIRY:
+    case FAIL_HARD:
+      throw transaction_operation_failed(ec, e.what()).no_rollback().ambiguous();
+    case FAIL_TRANSIENT:
+    case FAIL_OTHER:
+      throw retry_operation(e.what());
+    case FAIL_PATH_NOT_FOUND:
+      throw transaction_operation_failed(ec, e.what())
+        .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
+        .no_rollback()
+        .ambiguous();
+    case FAIL_DOC_NOT_FOUND:
+      throw transaction_operation_failed(ec, e.what())
+        .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
+        .no_rollback()
+        .ambiguous();
+    default:
+      throw transaction_operation_failed(ec, e.what()).no_rollback().ambiguous();
   }
 }
 
@@ -2324,7 +2478,6 @@ void
 attempt_context_impl::atr_complete()
 {
   try {
-    const result atr_res;
     auto ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
       return self->hooks_.before_atr_complete(self, std::move(handler));
     });
@@ -2337,18 +2490,7 @@ attempt_context_impl::atr_complete()
     if (ec) {
       throw client_error(*ec, "atr_complete threw error");
     }
-    // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
-    // NOLINTBEGIN(bugprone-unchecked-optional-access)
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "removing attempt {} from atr", atr_id_.value());
-    const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    // NOLINTEND(bugprone-unchecked-optional-access)
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::remove(prefix).xattr(),
-      }
-        .specs();
-    wrap_durable_request(req, overall_->config());
+    auto req = make_atr_complete_request();
     auto barrier = std::make_shared<std::promise<result>>();
     auto f = barrier->get_future();
     overall_->cluster_ref().execute(req,
@@ -2364,29 +2506,159 @@ attempt_context_impl::atr_complete()
     }
     state(attempt_state::COMPLETED);
   } catch (const client_error& er) {
-    switch (const error_class ec = er.ec(); ec) {
-      case FAIL_HARD:
-        throw transaction_operation_failed(ec, er.what()).no_rollback().failed_post_commit();
-      default:
-        CB_ATTEMPT_CTX_LOG_INFO(this, "ignoring error in atr_complete {}", er.what());
-    }
+    handle_atr_complete_error(er);
   }
 }
 
 void
-attempt_context_impl::commit(VoidCallback&& cb)
+attempt_context_impl::atr_complete(VoidCallback&& cb)
 {
-  // for now, lets keep the blocking implementation
-  std::thread([cb = std::move(cb), self = shared_from_this()]() mutable {
-    try {
-      self->commit();
+  auto handler = [self = shared_from_this(),
+                  cb = std::move(cb)](const std::optional<client_error>& e) mutable {
+    if (e) {
+      try {
+        self->handle_atr_complete_error(e.value());
+      } catch (const transaction_operation_failed&) {
+        return cb(std::current_exception());
+      }
       return cb({});
-    } catch (const transaction_operation_failed&) {
-      return cb(std::current_exception());
-    } catch (const std::exception& e) {
-      return cb(std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what())));
     }
-  }).detach();
+    self->state(attempt_state::COMPLETED);
+    cb({});
+  };
+
+  hooks_.before_atr_complete(
+    shared_from_this(),
+    [self = shared_from_this(), handler = std::move(handler)](std::optional<error_class> ec) mutable {
+      if (ec) {
+        return handler(client_error(*ec, "before_atr_complete hook threw error"));
+      }
+      // if we have expired (and not in overtime mode), just raise the final
+      // error.
+      if (auto expired = self->error_if_expired_and_not_in_overtime(STAGE_ATR_COMPLETE, {});
+          expired) {
+        return handler(client_error(*expired, "atr_complete threw error"));
+      }
+      auto req = self->make_atr_complete_request();
+      self->overall_->cluster_ref().execute(
+        req,
+        [self, handler = std::move(handler)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+          } catch (const client_error& e) {
+            return handler(e);
+          }
+          self->hooks_.after_atr_complete(
+            self, [handler = std::move(handler)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return handler(client_error(*ec, "after_atr_complete hook threw error"));
+              }
+              handler({});
+            });
+        });
+    });
+}
+
+auto
+attempt_context_impl::make_atr_complete_request() -> core::operations::mutate_in_request
+{
+  // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  CB_ATTEMPT_CTX_LOG_DEBUG(this, "removing attempt {} from atr", atr_id_.value());
+  const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
+  core::operations::mutate_in_request req{ atr_id_.value() };
+  // NOLINTEND(bugprone-unchecked-optional-access)
+  req.specs =
+    couchbase::mutate_in_specs{
+      couchbase::mutate_in_specs::remove(prefix).xattr(),
+    }
+      .specs();
+  wrap_durable_request(req, overall_->config());
+  return req;
+}
+
+void
+attempt_context_impl::handle_atr_complete_error(const client_error& e)
+{
+  switch (const error_class ec = e.ec(); ec) {
+    case FAIL_HARD:
+      throw transaction_operation_failed(ec, e.what()).no_rollback().failed_post_commit();
+    default:
+      CB_ATTEMPT_CTX_LOG_INFO(this, "ignoring error in atr_complete {}", e.what());
+  }
+}
+
+void
+attempt_context_impl::commit(VoidCallback&& cb)
+{
+  CB_ATTEMPT_CTX_LOG_DEBUG(this, "waiting on ops to finish...");
+  op_list_.async_wait_and_block_ops([self = shared_from_this(), cb = std::move(cb)]() mutable {
+    // the last operation might complete on the IO thread, do not continue inside its callback
+    asio::post(self->cluster_ref().io_context(), [self, cb = std::move(cb)]() mutable {
+      auto done = [cb = std::move(cb)](const std::exception_ptr& err) mutable {
+        if (!err) {
+          return cb({});
+        }
+        try {
+          std::rethrow_exception(err);
+        } catch (const transaction_operation_failed&) {
+          return cb(std::current_exception());
+        } catch (const std::exception& e) {
+          return cb(std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what())));
+        }
+      };
+      try {
+        self->existing_error(false);
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "commit {}", self->id());
+        if (self->op_list_.get_mode().is_query()) {
+          return self->commit_with_query(std::move(done));
+        }
+        if (self->check_expiry_pre_commit(STAGE_BEFORE_COMMIT, {})) {
+          throw transaction_operation_failed(FAIL_EXPIRY, "transaction expired").expired();
+        }
+        if (!self->atr_id_ || self->atr_id_->key().empty() || self->is_done_) {
+          // no mutation, no need to commit
+          if (!self->is_done_) {
+            CB_ATTEMPT_CTX_LOG_DEBUG(
+              self, "calling commit on attempt that has got no mutations, skipping");
+            self->is_done_ = true;
+            return done({});
+          } // do not rollback or retry
+          throw transaction_operation_failed(FAIL_OTHER,
+                                             "calling commit on attempt that is already completed")
+            .no_rollback();
+        }
+      } catch (const std::exception&) {
+        return done(std::current_exception());
+      }
+      auto delay = std::make_shared<async_constant_delay>(std::shared_ptr<asio::steady_timer>{},
+                                                          DEFAULT_RETRY_OP_DELAY,
+                                                          std::numeric_limits<std::size_t>::max());
+      delay->io = &self->cluster_ref().io_context();
+      self->atr_commit(
+        false, delay, [self, done = std::move(done)](const std::exception_ptr& err) mutable {
+          if (err) {
+            return done(err);
+          }
+          self->staged_mutations_->commit(
+            self, [self, done = std::move(done)](std::exception_ptr err) mutable {
+              if (err) {
+                return done(err);
+              }
+              self->atr_complete(
+                [self, done = std::move(done)](const std::exception_ptr& err) mutable {
+                  if (err) {
+                    return done(err);
+                  }
+                  self->is_done_ = true;
+                  done({});
+                });
+            });
+        });
+    });
+  });
 }
 
 void
@@ -2447,24 +2719,7 @@ attempt_context_impl::atr_abort()
     if (ec) {
       throw client_error(*ec, "before_atr_aborted hook threw error");
     }
-    const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id() + ".");
-    // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_STATUS,
-                                           attempt_state_name(attempt_state::ABORTED))
-          .xattr()
-          .create_path(),
-        couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_TIMESTAMP_ROLLBACK_START,
-                                           subdoc::mutate_in_macro::cas)
-          .xattr()
-          .create_path(),
-      }
-        .specs();
-    staged_mutations_->extract_to(prefix, req);
-    wrap_durable_request(req, overall_->config());
+    auto req = make_atr_abort_request();
     auto barrier = std::make_shared<std::promise<result>>();
     auto f = barrier->get_future();
     overall_->cluster_ref().execute(req,
@@ -2482,37 +2737,125 @@ attempt_context_impl::atr_abort()
     }
     CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback completed atr abort phase");
   } catch (const client_error& e) {
-    auto ec = e.ec();
-    CB_ATTEMPT_CTX_LOG_TRACE(this, "atr_abort got {} {}", ec, e.what());
-    if (expiry_overtime_mode_.load()) {
-      CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_abort got error \"{}\" while in overtime mode", e.what());
-      throw transaction_operation_failed(FAIL_EXPIRY,
-                                         std::string("expired in atr_abort with {} ") + e.what())
-        .no_rollback()
-        .expired();
+    handle_atr_abort_error(e);
+  }
+}
+
+void
+attempt_context_impl::atr_abort(std::shared_ptr<async_exp_delay> delay, VoidCallback&& cb)
+{
+  auto handler = [self = shared_from_this(), delay, cb = std::move(cb)](
+                   const std::optional<client_error>& e) mutable {
+    if (!e) {
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "rollback completed atr abort phase");
+      return cb({});
     }
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_abort got error {}", ec);
-    switch (ec) {
-      case FAIL_EXPIRY:
-        expiry_overtime_mode_ = true;
-        throw retry_operation("expired, setting overtime mode and retry atr_abort");
-      case FAIL_PATH_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .no_rollback()
-          .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND);
-      case FAIL_DOC_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .no_rollback()
-          .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND);
-      case FAIL_ATR_FULL:
-        throw transaction_operation_failed(ec, e.what())
-          .no_rollback()
-          .cause(ACTIVE_TRANSACTION_RECORD_FULL);
-      case FAIL_HARD:
-        throw transaction_operation_failed(ec, e.what()).no_rollback();
-      default:
-        throw retry_operation("retry atr_abort");
+    try {
+      self->handle_atr_abort_error(e.value());
+    } catch (const retry_operation&) {
+      return (*delay)(
+        [self, delay, cb = std::move(cb)](const std::exception_ptr& exc) mutable {
+          if (exc) {
+            return cb(exc);
+          }
+          CB_ATTEMPT_CTX_LOG_TRACE(self, "retrying atr_abort");
+          self->atr_abort(delay, std::move(cb));
+        });
+    } catch (const transaction_operation_failed&) {
+      return cb(std::current_exception());
+    }
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ABORT, {});
+  if (ec) {
+    return handler(client_error(*ec, "atr_abort check for expiry threw error"));
+  }
+  hooks_.before_atr_aborted(
+    shared_from_this(),
+    [self = shared_from_this(), handler = std::move(handler)](std::optional<error_class> ec) mutable {
+      if (ec) {
+        return handler(client_error(*ec, "before_atr_aborted hook threw error"));
+      }
+      auto req = self->make_atr_abort_request();
+      self->overall_->cluster_ref().execute(
+        req,
+        [self, handler = std::move(handler)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+          } catch (const client_error& e) {
+            return handler(e);
+          }
+          self->state(attempt_state::ABORTED);
+          self->hooks_.after_atr_aborted(
+            self, [handler = std::move(handler)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return handler(client_error(*ec, "after_atr_aborted hook threw error"));
+              }
+              handler({});
+            });
+        });
+    });
+}
+
+auto
+attempt_context_impl::make_atr_abort_request() -> core::operations::mutate_in_request
+{
+  const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id() + ".");
+  // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  core::operations::mutate_in_request req{ atr_id_.value() };
+  req.specs =
+    couchbase::mutate_in_specs{
+      couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_STATUS,
+                                         attempt_state_name(attempt_state::ABORTED))
+        .xattr()
+        .create_path(),
+      couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_TIMESTAMP_ROLLBACK_START,
+                                         subdoc::mutate_in_macro::cas)
+        .xattr()
+        .create_path(),
     }
+      .specs();
+  staged_mutations_->extract_to(prefix, req);
+  wrap_durable_request(req, overall_->config());
+  return req;
+}
+
+void
+attempt_context_impl::handle_atr_abort_error(const client_error& e)
+{
+  auto ec = e.ec();
+  CB_ATTEMPT_CTX_LOG_TRACE(this, "atr_abort got {} {}", ec, e.what());
+  if (expiry_overtime_mode_.load()) {
+    CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_abort got error \"{}\" while in overtime mode", e.what());
+    throw transaction_operation_failed(FAIL_EXPIRY,
+                                       std::string("expired in atr_abort with {} ") + e.what())
+      .no_rollback()
+      .expired();
+  }
+  CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_abort got error {}", ec);
+  switch (ec) {
+    case FAIL_EXPIRY:
+      expiry_overtime_mode_ = true;
+      throw retry_operation("expired, setting overtime mode and retry atr_abort");
+    case FAIL_PATH_NOT_FOUND:
+      throw transaction_operation_failed(ec, e.what())
+        .no_rollback()
+        .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND);
+    case FAIL_DOC_NOT_FOUND:
+      throw transaction_operation_failed(ec, e.what())
+        .no_rollback()
+        .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND);
+    case FAIL_ATR_FULL:
+      throw transaction_operation_failed(ec, e.what())
+        .no_rollback()
+        .cause(ACTIVE_TRANSACTION_RECORD_FULL);
+    case FAIL_HARD:
+      throw transaction_operation_failed(ec, e.what()).no_rollback();
+    default:
+      throw retry_operation("retry atr_abort");
   }
 }
 
@@ -2531,16 +2874,7 @@ attempt_context_impl::atr_rollback_complete()
     if (ec) {
       throw client_error(*ec, "before_atr_rolled_back hook threw error");
     }
-    const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
-    // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::remove(prefix).xattr(),
-      }
-        .specs();
-    wrap_durable_request(req, overall_->config());
+    auto req = make_atr_rollback_complete_request();
     auto barrier = std::make_shared<std::promise<result>>();
     auto f = barrier->get_future();
     overall_->cluster_ref().execute(req,
@@ -2558,119 +2892,189 @@ attempt_context_impl::atr_rollback_complete()
     is_done_ = true;
 
   } catch (const client_error& e) {
-    auto ec = e.ec();
-    if (expiry_overtime_mode_.load()) {
-      CB_ATTEMPT_CTX_LOG_DEBUG(
-        this, "atr_rollback_complete error while in overtime mode {}", e.what());
-      throw transaction_operation_failed(
-        FAIL_EXPIRY, std::string("expired in atr_rollback_complete with {} ") + e.what())
-        .no_rollback()
-        .expired();
-    }
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_rollback_complete got error {}", ec);
-    // FIXME(SA): if atr_id_ is optional, we should report an error somehow
-    // TODO(CXXCBC-549)
-    // NOLINTBEGIN(bugprone-unchecked-optional-access)
-    switch (ec) {
-      case FAIL_DOC_NOT_FOUND:
-      case FAIL_PATH_NOT_FOUND:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} not found, ignoring", atr_id_->key());
-        is_done_ = true;
-        break;
-      case FAIL_ATR_FULL:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} full!", atr_id_->key());
-        throw retry_operation(e.what());
-      case FAIL_HARD:
-        throw transaction_operation_failed(ec, e.what()).no_rollback();
-      case FAIL_EXPIRY:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "timed out writing atr {}", atr_id_->key());
-        throw transaction_operation_failed(ec, e.what()).no_rollback().expired();
-      default:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "retrying atr_rollback_complete");
-        throw retry_operation(e.what());
-    }
-    // NOLINTEND(bugprone-unchecked-optional-access)
+    handle_atr_rollback_complete_error(e);
   }
 }
+
 void
-attempt_context_impl::rollback(VoidCallback&& cb)
+attempt_context_impl::atr_rollback_complete(std::shared_ptr<async_exp_delay> delay,
+                                            VoidCallback&& cb)
 {
-  // for now, lets keep the blocking implementation
-  std::thread([cb = std::move(cb), this]() mutable {
-    if (op_list_.get_mode().is_query()) {
-      return rollback_with_query(std::move(cb));
+  auto handler = [self = shared_from_this(), delay, cb = std::move(cb)](
+                   const std::optional<client_error>& e) mutable {
+    if (!e) {
+      self->is_done_ = true;
+      return cb({});
     }
     try {
-      rollback();
-      return cb({});
+      self->handle_atr_rollback_complete_error(e.value());
+    } catch (const retry_operation&) {
+      return (*delay)(
+        [self, delay, cb = std::move(cb)](const std::exception_ptr& exc) mutable {
+          if (exc) {
+            return cb(exc);
+          }
+          CB_ATTEMPT_CTX_LOG_TRACE(self, "retrying atr_rollback_complete");
+          self->atr_rollback_complete(delay, std::move(cb));
+        });
     } catch (const transaction_operation_failed&) {
       return cb(std::current_exception());
-    } catch (const std::exception& e) {
-      return cb(
-        std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what()).no_rollback()));
-    } catch (...) {
-      return cb(std::make_exception_ptr(
-        transaction_operation_failed(FAIL_OTHER, "unexpected exception during rollback")));
     }
-  }).detach();
+    cb({});
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ROLLBACK_COMPLETE, std::nullopt);
+  if (ec) {
+    return handler(client_error(*ec, "atr_rollback_complete raised error"));
+  }
+  hooks_.before_atr_rolled_back(
+    shared_from_this(),
+    [self = shared_from_this(), handler = std::move(handler)](std::optional<error_class> ec) mutable {
+      if (ec) {
+        return handler(client_error(*ec, "before_atr_rolled_back hook threw error"));
+      }
+      auto req = self->make_atr_rollback_complete_request();
+      self->overall_->cluster_ref().execute(
+        req,
+        [self, handler = std::move(handler)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+          } catch (const client_error& e) {
+            return handler(e);
+          }
+          self->state(attempt_state::ROLLED_BACK);
+          self->hooks_.after_atr_rolled_back(
+            self, [handler = std::move(handler)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return handler(client_error(*ec, "after_atr_rolled_back hook threw error"));
+              }
+              handler({});
+            });
+        });
+    });
+}
+
+auto
+attempt_context_impl::make_atr_rollback_complete_request() -> core::operations::mutate_in_request
+{
+  const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
+  // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  core::operations::mutate_in_request req{ atr_id_.value() };
+  req.specs =
+    couchbase::mutate_in_specs{
+      couchbase::mutate_in_specs::remove(prefix).xattr(),
+    }
+      .specs();
+  wrap_durable_request(req, overall_->config());
+  return req;
 }
 
 void
-attempt_context_impl::rollback()
+attempt_context_impl::handle_atr_rollback_complete_error(const client_error& e)
 {
-  op_list_.wait_and_block_ops();
-  CB_ATTEMPT_CTX_LOG_DEBUG(this, "rolling back {}", id());
-  if (op_list_.get_mode().is_query()) {
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto f = barrier->get_future();
-    rollback_with_query([barrier](const std::exception_ptr& err) {
-      if (err) {
-        barrier->set_exception(err);
-      } else {
-        barrier->set_value();
-      }
-    });
-    return f.get();
-  }
-  // check for expiry
-  check_expiry_during_commit_or_rollback(STAGE_ROLLBACK, std::nullopt);
-  if (!atr_id_ || atr_id_->key().empty() || state() == attempt_state::NOT_STARTED) {
-    // TODO(SA): check this, but if we try to rollback an empty txn, we should
-    // prevent a subsequent commit
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback called on txn with no mutations");
-    is_done_ = true;
-    return;
+  auto ec = e.ec();
+  if (expiry_overtime_mode_.load()) {
+    CB_ATTEMPT_CTX_LOG_DEBUG(
+      this, "atr_rollback_complete error while in overtime mode {}", e.what());
+    throw transaction_operation_failed(
+      FAIL_EXPIRY, std::string("expired in atr_rollback_complete with {} ") + e.what())
+      .no_rollback()
+      .expired();
   }
-  if (is_done()) {
-    std::string msg("Transaction already done, cannot rollback");
-    CB_ATTEMPT_CTX_LOG_ERROR(this, "{}", msg);
-    // need to raise a FAIL_OTHER which is not retryable or rollback-able
-    throw transaction_operation_failed(FAIL_OTHER, msg).no_rollback();
+  CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_rollback_complete got error {}", ec);
+  // FIXME(SA): if atr_id_ is optional, we should report an error somehow
+  // TODO(CXXCBC-549)
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  switch (ec) {
+    case FAIL_DOC_NOT_FOUND:
+    case FAIL_PATH_NOT_FOUND:
+      CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} not found, ignoring", atr_id_->key());
+      is_done_ = true;
+      break;
+    case FAIL_ATR_FULL:
+      CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} full!", atr_id_->key());
+      throw retry_operation(e.what());
+    case FAIL_HARD:
+      throw transaction_operation_failed(ec, e.what()).no_rollback();
+    case FAIL_EXPIRY:
+      CB_ATTEMPT_CTX_LOG_DEBUG(this, "timed out writing atr {}", atr_id_->key());
+      throw transaction_operation_failed(ec, e.what()).no_rollback().expired();
+    default:
+      CB_ATTEMPT_CTX_LOG_DEBUG(this, "retrying atr_rollback_complete");
+      throw retry_operation(e.what());
   }
-  try {
-    // (1) atr_abort
-    retry_op_exp<void>([self = shared_from_this()]() {
-      self->atr_abort();
-    });
-    // (2) rollback staged mutations
-    staged_mutations_->rollback(shared_from_this());
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback completed unstaging docs");
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
 
-    // (3) atr_rollback
-    retry_op_exp<void>([self = shared_from_this()]() {
-      self->atr_rollback_complete();
+void
+attempt_context_impl::rollback(VoidCallback&& cb)
+{
+  op_list_.async_wait_and_block_ops([self = shared_from_this(), cb = std::move(cb)]() mutable {
+    // see commit(VoidCallback&&)
+    asio::post(self->cluster_ref().io_context(), [self, cb = std::move(cb)]() mutable {
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "rolling back {}", self->id());
+      auto done = [cb = std::move(cb)](const std::exception_ptr& err) mutable {
+        if (!err) {
+          return cb({});
+        }
+        try {
+          std::rethrow_exception(err);
+        } catch (const transaction_operation_failed&) {
+          return cb(std::current_exception());
+        } catch (const std::exception& e) {
+          return cb(std::make_exception_ptr(
+            transaction_operation_failed(FAIL_OTHER, e.what()).no_rollback()));
+        } catch (...) {
+          return cb(std::make_exception_ptr(
+            transaction_operation_failed(FAIL_OTHER, "unexpected exception during rollback")));
+        }
+      };
+      try {
+        if (self->op_list_.get_mode().is_query()) {
+          return self->rollback_with_query(std::move(done));
+        }
+        // check for expiry
+        self->check_expiry_during_commit_or_rollback(STAGE_ROLLBACK, std::nullopt);
+        if (!self->atr_id_ || self->atr_id_->key().empty() ||
+            self->state() == attempt_state::NOT_STARTED) {
+          CB_ATTEMPT_CTX_LOG_DEBUG(self, "rollback called on txn with no mutations");
+          self->is_done_ = true;
+          return done({});
+        }
+        if (self->is_done()) {
+          std::string msg("Transaction already done, cannot rollback");
+          CB_ATTEMPT_CTX_LOG_ERROR(self, "{}", msg);
+          // need to raise a FAIL_OTHER which is not retryable or rollback-able
+          throw transaction_operation_failed(FAIL_OTHER, msg).no_rollback();
+        }
+      } catch (...) {
+        return done(std::current_exception());
+      }
+      // (1) atr_abort
+      self->atr_abort(
+        std::make_shared<async_exp_delay>(self->cluster_ref().io_context()),
+        [self, done = std::move(done)](const std::exception_ptr& err) mutable {
+          if (err) {
+            return done(err);
+          }
+          // (2) rollback staged mutations
+          self->staged_mutations_->rollback(
+            self, [self, done = std::move(done)](std::exception_ptr err) mutable {
+              if (err) {
+                return done(err);
+              }
+              CB_ATTEMPT_CTX_LOG_DEBUG(self, "rollback completed unstaging docs");
+              // (3) atr_rollback
+              self->atr_rollback_complete(
+                std::make_shared<async_exp_delay>(self->cluster_ref().io_context()),
+                std::move(done));
+            });
+        });
     });
-  } catch (const client_error& e) {
-    const error_class ec = e.ec();
-    CB_ATTEMPT_CTX_LOG_ERROR(this,
-                             "rollback transaction {}, attempt {} fail with error {}",
-                             transaction_id(),
-                             id(),
-                             e.what());
-    if (ec == FAIL_HARD) {
-      throw transaction_operation_failed(ec, e.what()).no_rollback();
-    }
-  }
+  });
 }
 
 auto
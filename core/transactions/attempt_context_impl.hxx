@@ -66,6 +66,9 @@ enum class forward_compat_stage;
 class staged_mutation_queue;
 class staged_mutation;
 struct attempt_context_testing_hooks;
+struct async_constant_delay;
+struct async_exp_delay;
+struct result;
 
 class attempt_context_impl
   : public attempt_context
@@ -417,14 +420,32 @@ private:
   void check_if_done(Handler& cb);
 
   void atr_commit(bool ambiguity_resolution_mode);
+  void atr_commit(bool ambiguity_resolution_mode,
+                  std::shared_ptr<async_constant_delay> delay,
+                  VoidCallback&& cb);
+  auto make_atr_commit_request() -> core::operations::mutate_in_request;
+  void handle_atr_commit_error(const client_error& e, bool& ambiguity_resolution_mode);
 
   void atr_commit_ambiguity_resolution();
+  void atr_commit_ambiguity_resolution(std::shared_ptr<async_constant_delay> delay,
+                                       VoidCallback&& cb);
+  void check_atr_commit_ambiguity_resolution_result(const result& res);
+  void handle_atr_commit_ambiguity_resolution_error(const client_error& e);
 
   void atr_complete();
+  void atr_complete(VoidCallback&& cb);
+  auto make_atr_complete_request() -> core::operations::mutate_in_request;
+  void handle_atr_complete_error(const client_error& e);
 
   void atr_abort();
+  void atr_abort(std::shared_ptr<async_exp_delay> delay, VoidCallback&& cb);
+  auto make_atr_abort_request() -> core::operations::mutate_in_request;
+  void handle_atr_abort_error(const client_error& e);
 
   void atr_rollback_complete();
+  void atr_rollback_complete(std::shared_ptr<async_exp_delay> delay, VoidCallback&& cb);
+  auto make_atr_rollback_complete_request() -> core::operations::mutate_in_request;
+  void handle_atr_rollback_complete_error(const client_error& e);
 
   void select_atr_if_needed_unlocked(
     const core::document_id& id,
@@ -35,6 +35,7 @@ enum class attempt_state;
 class transactions;
 class transactions_cleanup;
 struct transaction_attempt;
+class transaction_operation_failed;
 
 using txn_complete_callback =
   std::function<void(std::optional<transaction_exception>,
@@ -134,6 +135,8 @@ private:
   transaction_context(transactions& txns,
                       const couchbase::transactions::transaction_options& config);
 
+  void complete_error(const transaction_operation_failed& er, txn_complete_callback&& callback);
+
   std::string transaction_id_;
 
   /** The time this overall transaction started */
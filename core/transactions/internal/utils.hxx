@@ -324,7 +324,9 @@ struct constant_delay {
 };
 
 struct async_exp_delay {
-  std::shared_ptr<asio::steady_timer> timer;
+  // allocated on the first retry, when constructed from the io_context
+  mutable std::shared_ptr<asio::steady_timer> timer;
+  asio::io_context* io{ nullptr };
   std::chrono::microseconds initial_delay;
   std::chrono::microseconds max_delay;
   std::size_t max_retries;
@@ -351,6 +353,12 @@ struct async_exp_delay {
   {
   }
 
+  explicit async_exp_delay(asio::io_context& io)
+    : async_exp_delay(std::shared_ptr<asio::steady_timer>{})
+  {
+    this->io = &io;
+  }
+
   void operator()(utils::movable_function<void(std::exception_ptr)> callback) const
   {
     if (retries++ >= max_retries) {
@@ -362,19 +370,26 @@ struct async_exp_delay {
     if (delay > max_delay) {
       delay = max_delay;
     }
+    if (timer == nullptr) {
+      timer = std::make_shared<asio::steady_timer>(*io);
+    }
     timer->expires_after(delay);
-    timer->async_wait([callback = std::move(callback)](std::error_code ec) mutable {
-      if (ec == asio::error::operation_aborted) {
-        callback(std::make_exception_ptr(retry_operation_retries_exhausted("retry aborted")));
-        return;
-      }
-      callback({});
-    });
+    // the handler keeps the timer alive, the delay might be a temporary copy
+    timer->async_wait(
+      [timer = timer, callback = std::move(callback)](std::error_code ec) mutable {
+        if (ec == asio::error::operation_aborted) {
+          callback(std::make_exception_ptr(retry_operation_retries_exhausted("retry aborted")));
+          return;
+        }
+        callback({});
+      });
   }
 };
 
 struct async_constant_delay {
+  // allocated on the first retry, when constructed from the io_context
   std::shared_ptr<asio::steady_timer> timer;
+  asio::io_context* io{ nullptr };
   std::chrono::microseconds delay;
   std::size_t max_retries;
   std::size_t retries;
@@ -395,20 +410,31 @@ struct async_constant_delay {
   {
   }
 
+  explicit async_constant_delay(asio::io_context& io)
+    : async_constant_delay(std::shared_ptr<asio::steady_timer>{})
+  {
+    this->io = &io;
+  }
+
   void operator()(utils::movable_function<void(std::exception_ptr)> callback)
   {
     if (retries++ >= max_retries) {
       callback(std::make_exception_ptr(retry_operation_retries_exhausted("retries exhausted")));
       return;
     }
+    if (timer == nullptr) {
+      timer = std::make_shared<asio::steady_timer>(*io);
+    }
     timer->expires_after(delay);
-    timer->async_wait([callback = std::move(callback)](std::error_code ec) mutable {
-      if (ec == asio::error::operation_aborted) {
-        callback(std::make_exception_ptr(retry_operation_retries_exhausted("retry aborted")));
-        return;
-      }
-      callback({});
-    });
+    // the handler keeps the timer alive, the delay might be a temporary copy
+    timer->async_wait(
+      [timer = timer, callback = std::move(callback)](std::error_code ec) mutable {
+        if (ec == asio::error::operation_aborted) {
+          callback(std::make_exception_ptr(retry_operation_retries_exhausted("retry aborted")));
+          return;
+        }
+        callback({});
+      });
   }
 };
 
@@ -30,41 +30,137 @@
 #include <asio/bind_executor.hpp>
 #include <asio/post.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
 namespace couchbase::core::transactions
 {
-auto
-unstaging_state::wait_until_unstage_possible() -> bool
+namespace
 {
-  std::unique_lock lock(mutex_);
-  auto success = cv_.wait_for(lock, ctx_->overall()->remaining(), [this] {
-    return (in_flight_count_ < MAX_PARALLELISM) || abort_;
-  });
-  if (!abort_) {
-    if (success) {
-      in_flight_count_++;
-    } else {
-      abort_ = true;
+using unstage_callback = utils::movable_function<void(std::exception_ptr)>;
+
+/**
+ * Unstages the documents of one commit or rollback, keeping at most "window" of them in flight.
+ * Every completion starts the next document, so neither the caller nor the io_context threads wait
+ * for the documents in between.
+ */
+class unstaging_pipeline : public std::enable_shared_from_this<unstaging_pipeline>
+{
+public:
+  using unstage_function = utils::movable_function<void(staged_mutation&, unstage_callback&&)>;
+  using completion_handler = utils::movable_function<void(std::exception_ptr, bool)>;
+
+  unstaging_pipeline(std::shared_ptr<attempt_context_impl> ctx,
+                     std::vector<staged_mutation*> items,
+                     unstage_function&& unstage,
+                     completion_handler&& handler)
+    : ctx_{ std::move(ctx) }
+    , items_{ std::move(items) }
+    , window_{ std::max<std::size_t>(1, ctx_->overall()->config().unstaging_window) }
+    , unstage_{ std::move(unstage) }
+    , handler_{ std::move(handler) }
+  {
+  }
+
+  void start()
+  {
+    dispatch();
+  }
+
+private:
+  void dispatch()
+  {
+    while (true) {
+      staged_mutation* item{ nullptr };
+      {
+        const std::scoped_lock lock(mutex_);
+        if (aborted_ || in_flight_ >= window_ || next_ == items_.size()) {
+          break;
+        }
+        item = items_[next_++];
+        ++in_flight_;
+      }
+      try {
+        unstage_(*item, [self = shared_from_this()](std::exception_ptr exc) {
+          self->complete(std::move(exc));
+        });
+      } catch (...) {
+        // This should not happen, but catching it to ensure that we wait for in-flight operations
+        CB_ATTEMPT_CTX_LOG_ERROR(ctx_,
+                                 "caught exception while trying to initiate unstaging for {}. "
+                                 "Aborting the rest and waiting for in-flight operations to finish",
+                                 item->doc().id());
+        const std::scoped_lock lock(mutex_);
+        --in_flight_;
+        aborted_ = true;
+      }
     }
+    finish_if_done();
   }
-  return !abort_;
-}
 
-void
-unstaging_state::notify_unstage_complete()
-{
-  const std::lock_guard lock(mutex_);
-  in_flight_count_--;
-  cv_.notify_one();
-}
+  void complete(std::exception_ptr exc)
+  {
+    {
+      const std::scoped_lock lock(mutex_);
+      --in_flight_;
+      if (exc) {
+        aborted_ = true;
+        if (!error_) {
+          error_ = std::move(exc);
+        }
+      }
+    }
+    dispatch();
+  }
+
+  void finish_if_done()
+  {
+    std::exception_ptr error{};
+    bool aborted{ false };
+    {
+      const std::scoped_lock lock(mutex_);
+      if (finished_ || in_flight_ > 0 || (!aborted_ && next_ < items_.size())) {
+        return;
+      }
+      finished_ = true;
+      error = error_;
+      aborted = aborted_;
+    }
+    auto handler = std::move(handler_);
+    handler(error, aborted);
+  }
+
+  std::shared_ptr<attempt_context_impl> ctx_;
+  std::vector<staged_mutation*> items_;
+  std::size_t window_;
+  unstage_function unstage_;
+  completion_handler handler_;
+
+  std::mutex mutex_{};
+  std::size_t next_{ 0 };
+  std::size_t in_flight_{ 0 };
+  bool aborted_{ false };
+  bool finished_{ false };
+  std::exception_ptr error_{};
+};
 
 void
-unstaging_state::notify_unstage_error()
+unstage_and_wait(const std::function<void(unstage_callback&&)>& operation)
 {
-  const std::lock_guard lock(mutex_);
-  abort_ = true;
-  in_flight_count_--;
-  cv_.notify_all();
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto future = barrier->get_future();
+  operation([barrier](const std::exception_ptr& exc) {
+    if (exc) {
+      return barrier->set_exception(exc);
+    }
+    barrier->set_value();
+  });
+  future.get();
 }
+} // namespace
 
 auto
 staged_mutation_queue::empty() -> bool
@@ -73,18 +169,41 @@ staged_mutation_queue::empty() -> bool
   return queue_.empty();
 }
 
+auto
+staged_mutation_queue::index_key(const core::document_id& id) -> std::string
+{
+  // bucket, scope and collection names cannot contain '/', so the key can be placed last as is
+  std::string key{};
+  key.reserve(id.bucket().size() + id.scope().size() + id.collection().size() + id.key().size() +
+              3);
+  return key.append(id.bucket())
+    .append("/")
+    .append(id.scope())
+    .append("/")
+    .append(id.collection())
+    .append("/")
+    .append(id.key());
+}
+
+auto
+staged_mutation_queue::find(const core::document_id& id) -> staged_mutation*
+{
+  if (auto it = index_.find(index_key(id)); it != index_.end()) {
+    return &*it->second;
+  }
+  return nullptr;
+}
+
 void
 staged_mutation_queue::add(const staged_mutation& mutation)
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  // Can only have one staged mutation per document.
-  queue_.erase(std::remove_if(queue_.begin(),
-                              queue_.end(),
-                              [&mutation](const staged_mutation& item) {
-                                return document_ids_equal(item.id(), mutation.id());
-                              }),
-               queue_.end());
-  queue_.push_back(mutation);
+  // Can only have one staged mutation per document, the latest one goes to the end of the queue.
+  auto [it, inserted] = index_.try_emplace(index_key(mutation.id()), queue_.end());
+  if (!inserted) {
+    queue_.erase(it->second);
+  }
+  it->second = queue_.insert(queue_.end(), mutation);
 }
 
 void
@@ -137,32 +256,25 @@ void
 staged_mutation_queue::remove_any(const core::document_id& id)
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  auto new_end = std::remove_if(queue_.begin(), queue_.end(), [&id](const staged_mutation& item) {
-    return document_ids_equal(item.id(), id);
-  });
-  queue_.erase(new_end, queue_.end());
+  if (auto it = index_.find(index_key(id)); it != index_.end()) {
+    queue_.erase(it->second);
+    index_.erase(it);
+  }
 }
 
 auto
 staged_mutation_queue::find_any(const core::document_id& id) -> staged_mutation*
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  return find(id);
 }
 
 auto
 staged_mutation_queue::find_replace(const core::document_id& id) -> staged_mutation*
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::REPLACE && document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
+  if (auto* item = find(id); item != nullptr && item->type() == staged_mutation_type::REPLACE) {
+    return item;
   }
   return nullptr;
 }
@@ -171,10 +283,8 @@ auto
 staged_mutation_queue::find_insert(const core::document_id& id) -> staged_mutation*
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::INSERT && document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
+  if (auto* item = find(id); item != nullptr && item->type() == staged_mutation_type::INSERT) {
+    return item;
   }
   return nullptr;
 }
@@ -183,10 +293,8 @@ auto
 staged_mutation_queue::find_remove(const core::document_id& id) -> staged_mutation*
 {
   const std::lock_guard<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::REMOVE && document_ids_equal(item.doc().id(), id)) {
-      return &item;
-    }
+  if (auto* item = find(id); item != nullptr && item->type() == staged_mutation_type::REMOVE) {
+    return item;
   }
   return nullptr;
 }
@@ -199,181 +307,98 @@ staged_mutation_queue::iterate(const std::function<void(staged_mutation&)>& op)
   }
 }
 
-void
-staged_mutation_queue::commit(const std::shared_ptr<attempt_context_impl>& ctx)
+auto
+staged_mutation_queue::snapshot() -> std::vector<staged_mutation*>
 {
-  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "committing staged mutations...");
   const std::lock_guard<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
+  std::vector<staged_mutation*> items{};
+  items.reserve(queue_.size());
   for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not commit any more mutations
-      break;
-    }
-
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
-    try {
-      auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
-      async_constant_delay delay(timer);
+    items.push_back(&item);
+  }
+  return items;
+}
 
+void
+staged_mutation_queue::commit(const std::shared_ptr<attempt_context_impl>& ctx,
+                              utils::movable_function<void(std::exception_ptr)>&& callback)
+{
+  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "committing staged mutations...");
+  std::make_shared<unstaging_pipeline>(
+    ctx,
+    snapshot(),
+    [this, ctx](staged_mutation& item, unstage_callback&& done) {
+      async_constant_delay delay(ctx->cluster_ref().io_context());
       switch (item.type()) {
         case staged_mutation_type::REMOVE:
-          remove_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return remove_doc(ctx, item, delay, std::move(done));
         case staged_mutation_type::INSERT:
         case staged_mutation_type::REPLACE:
-          commit_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return commit_doc(ctx, item, delay, std::move(done));
       }
-    } catch (...) {
-      // This should not happen, but catching it to ensure that we wait for in-flight operations
-      CB_ATTEMPT_CTX_LOG_ERROR(ctx,
-                               "caught exception while trying to initiate commit for {}. Aborting "
-                               "rest of commit and waiting for "
-                               "in-flight rollback operations to finish",
-                               item.doc().id());
-      aborted = true;
-      break;
-    }
-
-    // TODO(CXXCBC-549): clang-tidy reports potential memory leak here
-    // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-    futures.push_back(std::move(future));
-  }
-
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
+    },
+    [callback = std::move(callback)](std::exception_ptr exc, bool aborted) mutable {
+      if (exc) {
+        return callback(std::move(exc));
       }
-    }
-  }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Commit was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "commit aborted")
-      .no_rollback()
-      .failed_post_commit();
-  }
+      if (aborted) {
+        // Commit was aborted while initiating unstaging, but no operation has failed
+        return callback(
+          std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, "commit aborted")
+                                    .no_rollback()
+                                    .failed_post_commit()));
+      }
+      callback({});
+    })
+    ->start();
 }
 
 void
-staged_mutation_queue::rollback(const std::shared_ptr<attempt_context_impl>& ctx)
+staged_mutation_queue::commit(const std::shared_ptr<attempt_context_impl>& ctx)
 {
-  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "rolling back staged mutations...");
-  const std::lock_guard<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
-  for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not roll back any more mutations
-      break;
-    }
-
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
-    try {
-      auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
-      async_exp_delay delay(timer);
+  unstage_and_wait([this, &ctx](unstage_callback&& callback) {
+    commit(ctx, std::move(callback));
+  });
+}
 
+void
+staged_mutation_queue::rollback(const std::shared_ptr<attempt_context_impl>& ctx,
+                                utils::movable_function<void(std::exception_ptr)>&& callback)
+{
+  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "rolling back staged mutations...");
+  std::make_shared<unstaging_pipeline>(
+    ctx,
+    snapshot(),
+    [this, ctx](staged_mutation& item, unstage_callback&& done) {
+      async_exp_delay delay(ctx->cluster_ref().io_context());
       switch (item.type()) {
         case staged_mutation_type::INSERT:
-          rollback_insert(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return rollback_insert(ctx, item, delay, std::move(done));
         case staged_mutation_type::REMOVE:
         case staged_mutation_type::REPLACE:
-          rollback_remove_or_replace(
-            ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-              if (exc) {
-                state.notify_unstage_error();
-                barrier->set_exception(exc);
-              } else {
-                state.notify_unstage_complete();
-                barrier->set_value();
-              }
-            });
-          break;
+          return rollback_remove_or_replace(ctx, item, delay, std::move(done));
       }
-    } catch (...) {
-      // This should not happen, but catching it to ensure that we wait for in-flight operations
-      CB_ATTEMPT_CTX_LOG_ERROR(ctx,
-                               "caught exception while trying to initiate rollback for {}. "
-                               "Aborting rollback and waiting for "
-                               "in-flight rollback operations to finish",
-                               item.doc().id());
-      aborted = true;
-      break;
-    }
-
-    // TODO(CXXCBC-549): clang-tidy reports potential memory leak here
-    // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-    futures.push_back(std::move(future));
-  }
-
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
+    },
+    [callback = std::move(callback)](std::exception_ptr exc, bool aborted) mutable {
+      if (exc) {
+        return callback(std::move(exc));
       }
-    }
-  }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Rollback was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback();
-  }
+      if (aborted) {
+        // Rollback was aborted while initiating unstaging, but no operation has failed
+        return callback(std::make_exception_ptr(
+          transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback()));
+      }
+      callback({});
+    })
+    ->start();
+}
+
+void
+staged_mutation_queue::rollback(const std::shared_ptr<attempt_context_impl>& ctx)
+{
+  unstage_and_wait([this, &ctx](unstage_callback&& callback) {
+    rollback(ctx, std::move(callback));
+  });
 }
 
 void
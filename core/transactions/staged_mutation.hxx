@@ -23,8 +23,10 @@
 #include "transaction_get_result.hxx"
 #include "uid_generator.hxx"
 
+#include <list>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace couchbase::core::transactions
@@ -124,25 +126,18 @@ public:
   }
 };
 
-struct unstaging_state {
-  static const size_t MAX_PARALLELISM = 1000;
-
-  std::shared_ptr<attempt_context_impl> ctx_;
-  std::mutex mutex_{};
-  std::condition_variable cv_{};
-  std::atomic_size_t in_flight_count_{ 0 };
-  bool abort_{ false };
-
-  auto wait_until_unstage_possible() -> bool;
-  void notify_unstage_complete();
-  void notify_unstage_error();
-};
-
 class staged_mutation_queue
 {
 private:
   std::mutex mutex_;
-  std::vector<staged_mutation> queue_;
+  // mutations in the order they were staged, commit and rollback process them in this order
+  std::list<staged_mutation> queue_;
+  // at most one mutation per document, indexed by staged_mutation_queue::index_key()
+  std::unordered_map<std::string, std::list<staged_mutation>::iterator> index_;
+
+  static auto index_key(const core::document_id& id) -> std::string;
+  auto find(const core::document_id& id) -> staged_mutation*;
+  auto snapshot() -> std::vector<staged_mutation*>;
 
   using client_error_handler = utils::movable_function<void(const std::optional<client_error>&)>;
 
@@ -211,6 +206,15 @@ public:
   auto empty() -> bool;
   void add(const staged_mutation& mutation);
   void extract_to(const std::string& prefix, core::operations::mutate_in_request& req);
+  /**
+   * Unstages the mutations on the io_context, keeping at most transactions_config::unstaging_window
+   * of them in flight, and invokes the callback once all of them have completed, or the first one
+   * has failed and the in-flight ones have finished. The queue must not be modified meanwhile.
+   */
+  void commit(const std::shared_ptr<attempt_context_impl>& ctx,
+              utils::movable_function<void(std::exception_ptr)>&& callback);
+  void rollback(const std::shared_ptr<attempt_context_impl>& ctx,
+                utils::movable_function<void(std::exception_ptr)>&& callback);
   void commit(const std::shared_ptr<attempt_context_impl>& ctx);
   void rollback(const std::shared_ptr<attempt_context_impl>& ctx);
   void iterate(const std::function<void(staged_mutation&)>&);
@@ -268,76 +268,96 @@ transaction_context::handle_error(const std::exception_ptr& err, txn_complete_ca
                              er.cause(),
                              er.should_retry(),
                              er.should_rollback());
-    if (er.should_rollback()) {
-      CB_ATTEMPT_CTX_LOG_TRACE(current_attempt_context_,
-                               "got rollback-able exception, rolling back");
-      try {
-        current_attempt_context_->rollback();
-      } catch (const std::exception& er_rollback) {
-        cleanup().add_attempt(current_attempt_context_);
-        CB_ATTEMPT_CTX_LOG_TRACE(
-          current_attempt_context_,
-          "got error \"{}\" while auto rolling back, throwing original error",
-          er_rollback.what(),
-          er.what());
-        auto final = er.get_final_exception(*this);
-        // if you get here, we didn't throw, yet we had an error.  Fall through
-        // in this case.  Note the current logic is such that rollback will not
-        // have a commit ambiguous error, so we should always throw.
-        assert(final);
-        return callback(final, std::nullopt);
-      }
-      if (er.should_retry() && has_expired_client_side()) {
-        CB_ATTEMPT_CTX_LOG_TRACE(current_attempt_context_,
-                                 "auto rollback succeeded, however we are expired so no retry");
-
-        return callback(transaction_operation_failed(FAIL_EXPIRY, "expired in auto rollback")
-                          .no_rollback()
-                          .expired()
-                          .get_final_exception(*this),
-                        {});
-      }
-    }
-    if (er.should_retry()) {
-      CB_ATTEMPT_CTX_LOG_TRACE(current_attempt_context_, "got retryable exception, retrying");
-      cleanup().add_attempt(current_attempt_context_);
-      return callback(std::nullopt, std::nullopt);
+    if (!er.should_rollback()) {
+      return complete_error(er, std::move(callback));
     }
-
-    // throw the expected exception here
-    cleanup().add_attempt(current_attempt_context_);
-    auto final = er.get_final_exception(*this);
-    std::optional<::couchbase::transactions::transaction_result> res;
-    if (!final) {
-      res = get_transaction_result();
-    }
-    return callback(final, res);
+    CB_ATTEMPT_CTX_LOG_TRACE(current_attempt_context_, "got rollback-able exception, rolling back");
+    // the rollback runs on the IO threads, the callback must not block on it
+    return current_attempt_context_->rollback(
+      [self = shared_from_this(), er, callback = std::move(callback)](
+        const std::exception_ptr& rollback_err) mutable {
+        if (rollback_err) {
+          self->cleanup().add_attempt(self->current_attempt_context_);
+          try {
+            std::rethrow_exception(rollback_err);
+          } catch (const std::exception& er_rollback) {
+            CB_ATTEMPT_CTX_LOG_TRACE(
+              self->current_attempt_context_,
+              "got error \"{}\" while auto rolling back, throwing original error",
+              er_rollback.what(),
+              er.what());
+          } catch (...) {
+          }
+          auto final = er.get_final_exception(*self);
+          // if you get here, we didn't throw, yet we had an error.  Fall through
+          // in this case.  Note the current logic is such that rollback will not
+          // have a commit ambiguous error, so we should always throw.
+          assert(final);
+          return callback(final, std::nullopt);
+        }
+        if (er.should_retry() && self->has_expired_client_side()) {
+          CB_ATTEMPT_CTX_LOG_TRACE(self->current_attempt_context_,
+                                   "auto rollback succeeded, however we are expired so no retry");
+
+          return callback(transaction_operation_failed(FAIL_EXPIRY, "expired in auto rollback")
+                            .no_rollback()
+                            .expired()
+                            .get_final_exception(*self),
+                          {});
+        }
+        self->complete_error(er, std::move(callback));
+      });
   } catch (const std::exception& ex) {
     CB_ATTEMPT_CTX_LOG_ERROR(current_attempt_context_, "got runtime error \"{}\"", ex.what());
-    try {
-      current_attempt_context_->rollback();
-    } catch (...) {
-      CB_ATTEMPT_CTX_LOG_ERROR(
-        current_attempt_context_, "got error rolling back \"{}\"", ex.what());
-    }
-    cleanup().add_attempt(current_attempt_context_);
-    // the assumption here is this must come from the logic, not
-    // our operations (which only throw transaction_operation_failed),
-    auto op_failed = transaction_operation_failed(FAIL_OTHER, ex.what());
-    return callback(op_failed.get_final_exception(*this), std::nullopt);
+    return current_attempt_context_->rollback(
+      [self = shared_from_this(), what = std::string(ex.what()), callback = std::move(callback)](
+        const std::exception_ptr& rollback_err) mutable {
+        if (rollback_err) {
+          CB_ATTEMPT_CTX_LOG_ERROR(
+            self->current_attempt_context_, "got error rolling back \"{}\"", what);
+        }
+        self->cleanup().add_attempt(self->current_attempt_context_);
+        // the assumption here is this must come from the logic, not
+        // our operations (which only throw transaction_operation_failed),
+        auto op_failed = transaction_operation_failed(FAIL_OTHER, what);
+        return callback(op_failed.get_final_exception(*self), std::nullopt);
+      });
   } catch (...) {
     CB_ATTEMPT_CTX_LOG_ERROR(current_attempt_context_, "got unexpected error, rolling back");
-    try {
-      current_attempt_context_->rollback();
-    } catch (...) {
-      CB_ATTEMPT_CTX_LOG_ERROR(current_attempt_context_, "got error rolling back unexpected error");
-    }
+    return current_attempt_context_->rollback(
+      [self = shared_from_this(),
+       callback = std::move(callback)](const std::exception_ptr& rollback_err) mutable {
+        if (rollback_err) {
+          CB_ATTEMPT_CTX_LOG_ERROR(self->current_attempt_context_,
+                                   "got error rolling back unexpected error");
+        }
+        self->cleanup().add_attempt(self->current_attempt_context_);
+        // the assumption here is this must come from the logic, not
+        // our operations (which only throw transaction_operation_failed),
+        auto op_failed = transaction_operation_failed(FAIL_OTHER, "Unexpected error");
+        return callback(op_failed.get_final_exception(*self), std::nullopt);
+      });
+  }
+}
+
+void
+transaction_context::complete_error(const transaction_operation_failed& er,
+                                    txn_complete_callback&& callback)
+{
+  if (er.should_retry()) {
+    CB_ATTEMPT_CTX_LOG_TRACE(current_attempt_context_, "got retryable exception, retrying");
     cleanup().add_attempt(current_attempt_context_);
-    // the assumption here is this must come from the logic, not
-    // our operations (which only throw transaction_operation_failed),
-    auto op_failed = transaction_operation_failed(FAIL_OTHER, "Unexpected error");
-    return callback(op_failed.get_final_exception(*this), std::nullopt);
+    return callback(std::nullopt, std::nullopt);
+  }
+
+  // throw the expected exception here
+  cleanup().add_attempt(current_attempt_context_);
+  auto final = er.get_final_exception(*this);
+  std::optional<::couchbase::transactions::transaction_result> res;
+  if (!final) {
+    res = get_transaction_result();
   }
+  return callback(final, res);
 }
 
 void
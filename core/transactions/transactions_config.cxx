@@ -40,6 +40,7 @@ transactions_config::transactions_config(transactions_config&& c) noexcept
   , metadata_collection_(std::move(c.metadata_collection_))
   , query_config_(c.query_config_)
   , cleanup_config_(std::move(c.cleanup_config_))
+  , unstaging_window_(c.unstaging_window_)
 {
 }
 
@@ -53,6 +54,7 @@ transactions_config::transactions_config(const transactions_config& config)
   , metadata_collection_(config.metadata_collection())
   , query_config_(config.query_config())
   , cleanup_config_(config.cleanup_config())
+  , unstaging_window_(config.unstaging_window())
 {
 }
 
@@ -67,6 +69,7 @@ transactions_config::operator=(const transactions_config& c) -> transactions_con
     query_config_ = c.query_config_;
     metadata_collection_ = c.metadata_collection_;
     cleanup_config_ = c.cleanup_config_;
+    unstaging_window_ = c.unstaging_window_;
   }
   return *this;
 }
@@ -80,7 +83,8 @@ transactions_config::build() const -> transactions_config::built
            cleanup_hooks_,
            metadata_collection_,
            query_config_.build(),
-           cleanup_config_.build() };
+           cleanup_config_.build(),
+           unstaging_window_ };
 }
 
 } // namespace couchbase::transactions
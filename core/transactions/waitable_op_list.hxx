@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include "core/utils/movable_function.hxx"
 #include "internal/logging.hxx"
 
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 namespace couchbase::core::transactions
 {
@@ -79,6 +81,23 @@ public:
     // we have the lock.  Block all further ops
     allow_ops_ = false;
   }
+
+  /**
+   * Same as wait_and_block_ops(), but instead of blocking the calling thread, the handler is
+   * invoked once there are no outstanding ops.  It might be invoked from the thread that
+   * completes the last op.
+   */
+  void async_wait_and_block_ops(utils::movable_function<void()>&& handler)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (0 != count_) {
+      ops_waiters_.emplace_back(std::move(handler));
+      return;
+    }
+    allow_ops_ = false;
+    lock.unlock();
+    handler();
+  }
   auto get_mode() -> attempt_mode
   {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -170,7 +189,7 @@ public:
 private:
   void change_count(int32_t val)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     if (allow_ops_) {
       count_ += val;
       if (val > 0) {
@@ -179,12 +198,22 @@ private:
       CB_TXN_LOG_TRACE("op count changed by {} to {}, {} in_flight", val, count_, in_flight_);
       assert(count_ >= 0);
       assert(in_flight_ >= 0);
-      if (0 == count_) {
-        cv_ops_.notify_all();
-      }
       if (0 == in_flight_) {
         cv_in_flight_.notify_all();
       }
+      if (0 == count_) {
+        cv_ops_.notify_all();
+        if (!ops_waiters_.empty()) {
+          // we have the lock.  Block all further ops
+          allow_ops_ = false;
+          auto waiters = std::move(ops_waiters_);
+          ops_waiters_.clear();
+          lock.unlock();
+          for (auto& waiter : waiters) {
+            waiter();
+          }
+        }
+      }
     } else {
       CB_TXN_LOG_ERROR("operation attempted after commit/rollback");
       throw async_operation_conflict("Operation attempted after commit or rollback");
@@ -197,6 +226,7 @@ private:
   attempt_mode mode_;
   int32_t in_flight_;
   std::condition_variable cv_ops_;
+  std::vector<utils::movable_function<void()>> ops_waiters_{};
   std::condition_variable cv_query_;
   std::condition_variable cv_in_flight_;
   std::mutex mutex_;
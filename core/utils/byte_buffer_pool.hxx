@@ -0,0 +1,95 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::utils
+{
+struct byte_buffer_pool_stats {
+  std::uint64_t allocations{ 0 };
+  std::uint64_t reuses{ 0 };
+};
+
+/**
+ * Free list of the buffers for the encoded packets.
+ *
+ * The packet is encoded into the acquired buffer, and the buffer is released as soon as the session
+ * copies it into its socket buffer, so in the steady state the encoding does not touch the heap.
+ * The pools are not synchronized, every thread uses its own pool returned by local().
+ */
+class byte_buffer_pool
+{
+public:
+  static constexpr std::size_t max_buffers{ 64 };
+  // larger buffers are not retained, so that a single huge document does not pin the memory
+  static constexpr std::size_t max_buffer_capacity{ 64 * 1024 };
+
+  static auto local() -> byte_buffer_pool&
+  {
+    thread_local byte_buffer_pool pool{};
+    return pool;
+  }
+
+  /**
+   * Returns buffer of the given size. Its content is zeroed.
+   */
+  auto acquire(std::size_t size) -> std::vector<std::byte>
+  {
+    std::vector<std::byte> buffer{};
+    if (!buffers_.empty()) {
+      buffer = std::move(buffers_.back());
+      buffers_.pop_back();
+    }
+    if (buffer.capacity() < size) {
+      ++stats_.allocations;
+    } else {
+      ++stats_.reuses;
+    }
+    buffer.resize(size);
+    return buffer;
+  }
+
+  void release(std::vector<std::byte>&& buffer)
+  {
+    if (buffer.capacity() == 0 || buffer.capacity() > max_buffer_capacity ||
+        buffers_.size() >= max_buffers) {
+      return;
+    }
+    buffer.clear();
+    buffers_.emplace_back(std::move(buffer));
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return buffers_.size();
+  }
+
+  [[nodiscard]] auto stats() const -> byte_buffer_pool_stats
+  {
+    return stats_;
+  }
+
+private:
+  std::vector<std::vector<std::byte>> buffers_{};
+  byte_buffer_pool_stats stats_{};
+};
+} // namespace couchbase::core::utils
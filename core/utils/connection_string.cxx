@@ -297,6 +297,29 @@ parse_option(std::size_t& receiver,
   }
 }
 
+void
+parse_option(double& receiver,
+             const std::string& name,
+             const std::string& value,
+             std::vector<std::string>& warnings)
+{
+  try {
+    receiver = std::stod(value, nullptr);
+  } catch (const std::invalid_argument& ex1) {
+    warnings.push_back(fmt::format(
+      R"(unable to parse "{}" parameter in connection string (value "{}" is not a number): {})",
+      name,
+      value,
+      ex1.what()));
+  } catch (const std::out_of_range& ex2) {
+    warnings.push_back(fmt::format(
+      R"(unable to parse "{}" parameter in connection string (value "{}" is out of range): {})",
+      name,
+      value,
+      ex2.what()));
+  }
+}
+
 void
 parse_option(std::chrono::milliseconds& receiver,
              const std::string& name,
@@ -324,6 +347,33 @@ parse_option(std::chrono::milliseconds& receiver,
   }
 }
 
+void
+parse_option(std::chrono::microseconds& receiver,
+             const std::string& name,
+             const std::string& value,
+             std::vector<std::string>& warnings)
+{
+  try {
+    receiver = std::chrono::duration_cast<std::chrono::microseconds>(parse_duration(value));
+  } catch (const duration_parse_error&) {
+    try {
+      receiver = std::chrono::microseconds(std::stoull(value, nullptr, 10));
+    } catch (const std::invalid_argument& ex1) {
+      warnings.push_back(fmt::format(
+        R"(unable to parse "{}" parameter in connection string (value "{}" is not a number): {})",
+        name,
+        value,
+        ex1.what()));
+    } catch (const std::out_of_range& ex2) {
+      warnings.push_back(fmt::format(
+        R"(unable to parse "{}" parameter in connection string (value "{}" is out of range): {})",
+        name,
+        value,
+        ex2.what()));
+    }
+  }
+}
+
 void
 extract_options(connection_string& connstr)
 {
@@ -419,6 +469,36 @@ extract_options(connection_string& connstr)
        * indicates an unlimited number of connections are permitted.
        */
       parse_option(connstr.options.max_http_connections, name, value, connstr.warnings);
+    } else if (name == "max_key_value_read_buffer_size") {
+      /**
+       * The upper limit in bytes for the adaptive socket read buffer of the KV connections.
+       */
+      parse_option(connstr.options.max_key_value_read_buffer_size, name, value, connstr.warnings);
+    } else if (name == "key_value_write_coalescing_delay") {
+      /**
+       * How long the KV connections wait for more packets before writing them to the socket
+       * (default 0, every operation is written immediately).
+       */
+      parse_option(connstr.options.key_value_write_coalescing_delay, name, value, connstr.warnings);
+    } else if (name == "key_value_write_coalescing_threshold") {
+      /**
+       * Number of bytes gathered by the KV connection, that triggers the write before the
+       * coalescing delay expires (default 65536).
+       */
+      parse_option(
+        connstr.options.key_value_write_coalescing_threshold, name, value, connstr.warnings);
+    } else if (name == "num_kv_connections") {
+      /**
+       * Number of KV connections opened to each node of the bucket (default 1). Operations are
+       * sent over the connection with the least outstanding bytes.
+       */
+      parse_option(connstr.options.num_kv_connections, name, value, connstr.warnings);
+    } else if (name == "io_threads") {
+      /**
+       * The number of threads serving network sessions. Connections to the nodes are distributed
+       * across the threads.
+       */
+      parse_option(connstr.options.io_threads, name, value, connstr.warnings);
     } else if (name == "idle_http_connection_timeout") {
       /**
        * The period of time an HTTP connection can be idle before it is forcefully disconnected.
@@ -458,6 +538,11 @@ extract_options(connection_string& connstr)
        * Whether to display N1QL, Analytics, Search queries on info level (default false)
        */
       parse_option(connstr.options.show_queries, name, value, connstr.warnings);
+    } else if (name == "query_cache_capacity") {
+      /**
+       * Maximum number of prepared statements kept by the query cache (default 5000)
+       */
+      parse_option(connstr.options.query_cache_capacity, name, value, connstr.warnings);
     } else if (name == "enable_clustermap_notification") {
       /**
        * Allow the server to push configuration updates asynchronously.
@@ -473,6 +558,17 @@ extract_options(connection_string& connstr)
        * Announce support of compression (snappy) to server
        */
       parse_option(connstr.options.enable_compression, name, value, connstr.warnings);
+    } else if (name == "compression_min_size") {
+      /**
+       * Values smaller than this size (in bytes) are sent without compression
+       */
+      parse_option(connstr.options.compression_min_size, name, value, connstr.warnings);
+    } else if (name == "compression_min_ratio") {
+      /**
+       * Compressed value is only sent if its size relative to the original value is below the
+       * ratio
+       */
+      parse_option(connstr.options.compression_min_ratio, name, value, connstr.warnings);
     } else if (name == "enable_tracing") {
       /**
        * true - use threshold_logging_tracer
@@ -493,6 +589,12 @@ extract_options(connection_string& connstr)
       parse_option(connstr.options.tls_disable_deprecated_protocols, name, value, connstr.warnings);
     } else if (name == "tls_disable_v1_2") {
       parse_option(connstr.options.tls_disable_v1_2, name, value, connstr.warnings);
+    } else if (name == "tls_session_resumption") {
+      /**
+       * resume TLS sessions when reconnecting to the same endpoint, instead of performing full
+       * handshake
+       */
+      parse_option(connstr.options.tls_session_resumption, name, value, connstr.warnings);
     } else if (name == "user_agent_extra") {
       /**
        * string, that will be appended to identification fields of the server protocols (key in HELO
@@ -0,0 +1,146 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "thread_index.hxx"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace couchbase::core::utils
+{
+/**
+ * Holds an immutable value, that is read without locks and replaced in read-copy-update fashion.
+ *
+ * Readers announce themselves in per-thread shards of counters, and access the current value only
+ * inside read(). Writers publish new value, and wait for the grace period (until all readers that
+ * might still see the previous value are gone) before destroying it. Writes are expected to be
+ * rare (for example configuration updates), while reads happen for every operation.
+ */
+template<typename T>
+class rcu_cell
+{
+public:
+  rcu_cell() = default;
+  rcu_cell(const rcu_cell&) = delete;
+  rcu_cell(rcu_cell&&) = delete;
+  auto operator=(const rcu_cell&) -> rcu_cell& = delete;
+  auto operator=(rcu_cell&&) -> rcu_cell& = delete;
+
+  ~rcu_cell()
+  {
+    delete current_.load();
+  }
+
+  /**
+   * Invokes the reader with the pointer to the current value, or nullptr if nothing has been
+   * published yet. The pointer must not escape the reader, and the reader must not write to the
+   * cell.
+   */
+  template<typename Reader>
+  auto read(Reader&& reader) const -> std::invoke_result_t<Reader, const T*>
+  {
+    auto& shard = shards_[current_thread_index() % number_of_shards];
+    auto& readers = shard.readers[epoch_.load() & 1U];
+    readers.fetch_add(1);
+    const read_guard guard{ readers };
+    return reader(current_.load());
+  }
+
+  /**
+   * Replaces the value. Returns after the previous value has been destroyed.
+   */
+  void publish(std::unique_ptr<const T> value)
+  {
+    const std::scoped_lock lock(writer_mutex_);
+    retire(current_.exchange(value.release()));
+  }
+
+  /**
+   * Publishes copy of the current value (or default constructed one) modified by the mutator.
+   */
+  template<typename Mutator>
+  void update(Mutator&& mutator)
+  {
+    const std::scoped_lock lock(writer_mutex_);
+    const T* current = current_.load();
+    auto next = (current == nullptr) ? std::make_unique<T>() : std::make_unique<T>(*current);
+    mutator(*next);
+    retire(current_.exchange(next.release()));
+  }
+
+private:
+  static constexpr std::size_t number_of_shards{ 16 };
+
+  struct alignas(64) shard {
+    std::array<std::atomic_int64_t, 2> readers{};
+  };
+
+  struct read_guard {
+    std::atomic_int64_t& readers;
+
+    explicit read_guard(std::atomic_int64_t& counter)
+      : readers{ counter }
+    {
+    }
+    read_guard(const read_guard&) = delete;
+    read_guard(read_guard&&) = delete;
+    auto operator=(const read_guard&) -> read_guard& = delete;
+    auto operator=(read_guard&&) -> read_guard& = delete;
+
+    ~read_guard()
+    {
+      readers.fetch_sub(1, std::memory_order_release);
+    }
+  };
+
+  void retire(const T* previous)
+  {
+    if (previous == nullptr) {
+      return;
+    }
+    // The readers that have registered in the previous epoch, have to leave first, otherwise the
+    // flip below would mix them with the readers of the current epoch.
+    const auto epoch = epoch_.load();
+    wait_for_readers((epoch + 1) & 1U);
+    epoch_.store(epoch + 1);
+    wait_for_readers(epoch & 1U);
+    delete previous;
+  }
+
+  void wait_for_readers(std::uint64_t parity) const
+  {
+    for (const auto& shard : shards_) {
+      while (shard.readers[parity].load() != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  std::atomic<const T*> current_{ nullptr };
+  std::atomic_uint64_t epoch_{ 0 };
+  mutable std::array<shard, number_of_shards> shards_{};
+  std::mutex writer_mutex_{};
+};
+} // namespace couchbase::core::utils
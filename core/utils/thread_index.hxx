@@ -0,0 +1,36 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace couchbase::core::utils
+{
+/**
+ * Assigns sequential index to every thread that asks for it, so that the threads can be spread
+ * evenly across per-thread shards of counters or other state.
+ */
+inline auto
+current_thread_index() -> std::size_t
+{
+  static std::atomic_size_t next_thread_index{ 0 };
+  thread_local const std::size_t thread_index{ next_thread_index++ };
+  return thread_index;
+}
+} // namespace couchbase::core::utils
@@ -23,6 +23,7 @@
 #include <couchbase/common_options.hxx>
 #include <couchbase/error.hxx>
 #include <couchbase/mutation_state.hxx>
+#include <couchbase/stream_control.hxx>
 
 #include <chrono>
 #include <functional>
@@ -382,4 +383,17 @@ private:
  * @uncommitted
  */
 using analytics_handler = std::function<void(error, analytics_result)>;
+
+/**
+ * The signature for the row handler of the streaming @ref cluster#analytics_query() and @ref
+ * scope#analytics_query() operations.
+ *
+ * The handler is invoked on the I/O thread for each row, in order, as soon as it has been parsed
+ * from the response. The connection is not read while the handler runs, so a slow handler applies
+ * backpressure to the server instead of buffering the result in memory.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using analytics_row_handler = std::function<stream_control(codec::binary row)>;
 } // namespace couchbase
@@ -47,6 +47,9 @@
 
 #include <future>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -152,6 +155,37 @@ public:
   [[nodiscard]] auto get(std::string document_id, const get_options& options = {}) const
     -> std::future<std::pair<error, get_result>>;
 
+  /**
+   * Fetches multiple full documents from this collection as one batch.
+   *
+   * The requests are grouped by the node that owns each document, and every group is sent to its
+   * node in a single write. Projections and expiry are fetched document by document.
+   *
+   * @param document_ids the document ids which are used to uniquely identify the documents.
+   * @param options options to customize the get requests, applied to every document.
+   * @param handler the handler that implements @ref get_multi_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void get_multi(std::vector<std::string> document_ids,
+                 const get_options& options,
+                 get_multi_handler&& handler) const;
+
+  /**
+   * Fetches multiple full documents from this collection as one batch.
+   *
+   * @param document_ids the document ids which are used to uniquely identify the documents.
+   * @param options options to customize the get requests, applied to every document.
+   * @return future object that carries the results in the order of document_ids
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto get_multi(std::vector<std::string> document_ids,
+                               const get_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, get_result>>>;
+
   /**
    * Fetches a full document and resets its expiration time to the value provided.
    *
@@ -495,6 +529,81 @@ public:
     return upsert(std::move(document_id), Transcoder::encode(document), options);
   }
 
+  /**
+   * Upserts encoded bodies of multiple documents as one batch.
+   *
+   * The requests are grouped by the node that owns each document, and every group is sent to its
+   * node in a single write. Legacy durability (persist_to/replicate_to) is applied document by
+   * document.
+   *
+   * @param documents pairs of the document id and the encoded content of the document to upsert.
+   * @param options custom options to customize the upsert behavior, applied to every document.
+   * @param handler callable that implements @ref upsert_multi_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const;
+
+  /**
+   * Upserts multiple full documents as one batch.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of the document id and the document content to upsert.
+   * @param options custom options to customize the upsert behavior, applied to every document.
+   * @param handler callable that implements @ref upsert_multi_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  void upsert_multi(const std::vector<std::pair<std::string, Document>>& documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const
+  {
+    return upsert_multi(encode_multi<Transcoder>(documents), options, std::move(handler));
+  }
+
+  /**
+   * Upserts encoded bodies of multiple documents as one batch.
+   *
+   * @param documents pairs of the document id and the encoded content of the document to upsert.
+   * @param options custom options to customize the upsert behavior, applied to every document.
+   * @return future object that carries the results in the order of documents
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto upsert_multi(
+    std::vector<std::pair<std::string, codec::encoded_value>> documents,
+    const upsert_options& options) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>;
+
+  /**
+   * Upserts multiple full documents as one batch.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of the document id and the document content to upsert.
+   * @param options custom options to customize the upsert behavior, applied to every document.
+   * @return future object that carries the results in the order of documents
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  [[nodiscard]] auto upsert_multi(const std::vector<std::pair<std::string, Document>>& documents,
+                                  const upsert_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>
+  {
+    return upsert_multi(encode_multi<Transcoder>(documents), options);
+  }
+
   /**
    * Inserts an encoded body of the document which does not exist yet with custom options.
    *
@@ -738,6 +847,38 @@ public:
   [[nodiscard]] auto remove(std::string document_id, const remove_options& options = {}) const
     -> std::future<std::pair<error, mutation_result>>;
 
+  /**
+   * Removes multiple documents from a collection as one batch.
+   *
+   * The requests are grouped by the node that owns each document, and every group is sent to its
+   * node in a single write. Legacy durability (persist_to/replicate_to) is applied document by
+   * document.
+   *
+   * @param document_ids the document ids which are used to uniquely identify the documents.
+   * @param options custom options to customize the remove behavior, applied to every document.
+   * @param handler callable that implements @ref remove_multi_handler
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void remove_multi(std::vector<std::string> document_ids,
+                    const remove_options& options,
+                    remove_multi_handler&& handler) const;
+
+  /**
+   * Removes multiple documents from a collection as one batch.
+   *
+   * @param document_ids the document ids which are used to uniquely identify the documents.
+   * @param options custom options to customize the remove behavior, applied to every document.
+   * @return future object that carries the results in the order of document_ids
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  [[nodiscard]] auto remove_multi(std::vector<std::string> document_ids,
+                                  const remove_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>;
+
   /**
    * Performs mutations to document fragments
    *
@@ -1074,6 +1215,18 @@ private:
              std::string_view scope_name,
              std::string_view name);
 
+  template<typename Transcoder, typename Document>
+  static auto encode_multi(const std::vector<std::pair<std::string, Document>>& documents)
+    -> std::vector<std::pair<std::string, codec::encoded_value>>
+  {
+    std::vector<std::pair<std::string, codec::encoded_value>> encoded{};
+    encoded.reserve(documents.size());
+    for (const auto& [document_id, document] : documents) {
+      encoded.emplace_back(document_id, Transcoder::encode(document));
+    }
+    return encoded;
+  }
+
   std::shared_ptr<collection_impl> impl_;
 };
 } // namespace couchbase
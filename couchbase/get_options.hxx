@@ -25,6 +25,8 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -109,4 +111,13 @@ private:
  * @uncommitted
  */
 using get_handler = std::function<void(error, get_result)>;
+
+/**
+ * The signature for the handler of the @ref collection#get_multi() operation. The results are
+ * passed in the order of the requested document IDs.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using get_multi_handler = std::function<void(std::vector<std::pair<error, get_result>>)>;
 } // namespace couchbase
@@ -74,6 +74,86 @@ public:
     return *this;
   }
 
+  /**
+   * Limits the size of the socket read buffer of the Key/Value connections.
+   *
+   * The buffer starts small and grows when the connection receives large or pipelined responses,
+   * shrinks back when the traffic calms down, and is released as soon as the connection has no
+   * requests in flight. Larger limit reduces the number of socket reads for bulk workloads at the
+   * cost of the memory held by each busy connection.
+   *
+   * @param size maximum size of the read buffer in bytes
+   * @return this object for chaining purposes.
+   */
+  auto max_key_value_read_buffer_size(std::size_t size) -> network_options&
+  {
+    max_key_value_read_buffer_size_ = size;
+    return *this;
+  }
+
+  /**
+   * Lets the Key/Value connections wait for more outgoing packets before writing them to the
+   * socket.
+   *
+   * When many threads issue operations at the same time, gathering the packets for a few
+   * microseconds replaces many small socket writes with fewer large ones, trading a bit of latency
+   * for throughput. The packets are written earlier, once the coalescing threshold is reached.
+   * By default the delay is zero and every operation is written immediately.
+   *
+   * @param delay how long the first packet might wait for the others
+   * @return this object for chaining purposes.
+   */
+  auto key_value_write_coalescing_delay(std::chrono::microseconds delay) -> network_options&
+  {
+    key_value_write_coalescing_delay_ = delay;
+    return *this;
+  }
+
+  /**
+   * Limits the number of bytes gathered by a Key/Value connection while waiting for the write
+   * coalescing delay.
+   *
+   * @param size number of bytes, that triggers the write immediately
+   * @return this object for chaining purposes.
+   */
+  auto key_value_write_coalescing_threshold(std::size_t size) -> network_options&
+  {
+    key_value_write_coalescing_threshold_ = size;
+    return *this;
+  }
+
+  /**
+   * Sets the number of Key/Value connections opened to each node of the bucket.
+   *
+   * Every operation is sent over the connection to the node, that has the least bytes waiting for
+   * the responses. More connections help to saturate fast network links, and keep small
+   * operations from queueing behind large documents.
+   *
+   * @param number_of_connections number of connections per node (at least one)
+   * @return this object for chaining purposes.
+   */
+  auto num_kv_connections(std::size_t number_of_connections) -> network_options&
+  {
+    num_kv_connections_ = number_of_connections;
+    return *this;
+  }
+
+  /**
+   * Sets the number of threads used for network IO.
+   *
+   * The connections to the cluster nodes and the operations are distributed across the threads,
+   * which allows the library to use more than one CPU core for encoding, decoding and socket
+   * operations. The completion handlers of the operations are invoked on these threads as well.
+   *
+   * @param number_of_threads number of IO threads (at least one)
+   * @return this object for chaining purposes.
+   */
+  auto io_threads(std::size_t number_of_threads) -> network_options&
+  {
+    io_threads_ = number_of_threads;
+    return *this;
+  }
+
   auto force_ip_protocol(ip_protocol protocol) -> network_options&
   {
     ip_protocol_ = protocol;
@@ -113,6 +193,11 @@ public:
     std::chrono::milliseconds config_poll_interval;
     std::chrono::milliseconds idle_http_connection_timeout;
     std::optional<std::size_t> max_http_connections;
+    std::optional<std::size_t> max_key_value_read_buffer_size;
+    std::optional<std::chrono::microseconds> key_value_write_coalescing_delay;
+    std::optional<std::size_t> key_value_write_coalescing_threshold;
+    std::size_t num_kv_connections;
+    std::size_t io_threads;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -126,6 +211,11 @@ public:
       config_poll_interval_,
       idle_http_connection_timeout_,
       max_http_connections_,
+      max_key_value_read_buffer_size_,
+      key_value_write_coalescing_delay_,
+      key_value_write_coalescing_threshold_,
+      num_kv_connections_,
+      io_threads_,
     };
   }
 
@@ -139,5 +229,10 @@ private:
   std::chrono::milliseconds config_poll_floor_{ default_config_poll_floor };
   std::chrono::milliseconds idle_http_connection_timeout_{ default_idle_http_connection_timeout };
   std::optional<std::size_t> max_http_connections_{};
+  std::optional<std::size_t> max_key_value_read_buffer_size_{};
+  std::optional<std::chrono::microseconds> key_value_write_coalescing_delay_{};
+  std::optional<std::size_t> key_value_write_coalescing_threshold_{};
+  std::size_t num_kv_connections_{ 1 };
+  std::size_t io_threads_{ 1 };
 };
 } // namespace couchbase
@@ -24,6 +24,7 @@
 #include <couchbase/query_profile.hxx>
 #include <couchbase/query_result.hxx>
 #include <couchbase/query_scan_consistency.hxx>
+#include <couchbase/stream_control.hxx>
 
 #include <chrono>
 #include <functional>
@@ -593,4 +594,17 @@ private:
  * @uncommitted
  */
 using query_handler = std::function<void(error, query_result)>;
+
+/**
+ * The signature for the row handler of the streaming @ref cluster#query() and @ref scope#query()
+ * operations.
+ *
+ * The handler is invoked on the I/O thread for each row, in order, as soon as it has been parsed
+ * from the response. The connection is not read while the handler runs, so a slow handler applies
+ * backpressure to the server instead of buffering the result in memory.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using query_row_handler = std::function<stream_control(codec::binary row)>;
 } // namespace couchbase
@@ -100,6 +100,29 @@ public:
    */
   void query(std::string statement, const query_options& options, query_handler&& handler) const;
 
+  /**
+   * Performs a query against the query (N1QL) services, and streams the rows to the row handler
+   * while the response is being received.
+   *
+   * The rows are not accumulated, so the memory usage does not depend on the size of the result.
+   * The handler receives the result with the metadata and without rows after the last row.
+   *
+   * @param statement the N1QL query statement.
+   * @param options options to customize the query request.
+   * @param row_handler the handler that implements @ref query_row_handler
+   * @param handler the handler that implements @ref query_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void query(std::string statement,
+             const query_options& options,
+             query_row_handler&& row_handler,
+             query_handler&& handler) const;
+
   /**
    * Performs a query against the query (N1QL) services.
    *
@@ -136,6 +159,32 @@ public:
               const search_options& options,
               search_handler&& handler) const;
 
+  /**
+   * Performs a request against the full text search services, and streams the hits to the row
+   * handler while the response is being received.
+   *
+   * The rows are not accumulated, so the memory usage does not depend on the size of the result.
+   * The handler receives the result with the metadata and facets, and without rows after the last
+   * row.
+   *
+   * @param index_name name of the search index
+   * @param request request object, see @ref search_request for more details.
+   * @param options options to customize the query request.
+   * @param row_handler the handler that implements @ref search_row_handler
+   * @param handler the handler that implements @ref search_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void search(std::string index_name,
+              search_request request,
+              const search_options& options,
+              search_row_handler&& row_handler,
+              search_handler&& handler) const;
+
   /**
    * Performs a request against the full text search services.
    *
@@ -178,6 +227,29 @@ public:
                        const analytics_options& options,
                        analytics_handler&& handler) const;
 
+  /**
+   * Performs a query against the analytics services, and streams the rows to the row handler while
+   * the response is being received.
+   *
+   * The rows are not accumulated, so the memory usage does not depend on the size of the result.
+   * The handler receives the result with the metadata and without rows after the last row.
+   *
+   * @param statement the query statement.
+   * @param options options to customize the query request.
+   * @param row_handler the handler that implements @ref analytics_row_handler
+   * @param handler the handler that implements @ref analytics_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.0.0
+   * @uncommitted
+   */
+  void analytics_query(std::string statement,
+                       const analytics_options& options,
+                       analytics_row_handler&& row_handler,
+                       analytics_handler&& handler) const;
+
   /**
    * Performs a query against the analytics services.
    *
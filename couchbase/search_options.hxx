@@ -26,6 +26,7 @@
 #include <couchbase/search_result.hxx>
 #include <couchbase/search_scan_consistency.hxx>
 #include <couchbase/search_sort.hxx>
+#include <couchbase/stream_control.hxx>
 
 #include <chrono>
 #include <functional>
@@ -520,4 +521,17 @@ private:
  * @uncommitted
  */
 using search_handler = std::function<void(error, search_result)>;
+
+/**
+ * The signature for the row handler of the streaming @ref cluster#search() and @ref scope#search()
+ * operations.
+ *
+ * The handler is invoked on the I/O thread for each row, in order, as soon as it has been parsed
+ * from the response. The connection is not read while the handler runs, so a slow handler applies
+ * backpressure to the server instead of buffering the result in memory.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+using search_row_handler = std::function<stream_control(search_row row)>;
 } // namespace couchbase
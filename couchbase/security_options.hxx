@@ -51,6 +51,16 @@ public:
     return *this;
   }
 
+  /**
+   * Resume the TLS sessions when reconnecting to the same endpoint, instead of performing the full
+   * handshake. Enabled by default.
+   */
+  auto session_resumption(bool enabled) -> security_options&
+  {
+    session_resumption_ = enabled;
+    return *this;
+  }
+
   struct built {
     bool enabled;
     tls_verify_mode tls_verify;
@@ -59,6 +69,7 @@ public:
     bool disable_mozilla_ca_certificates;
     bool disable_deprecated_protocols;
     bool disable_tls_v1_2;
+    bool session_resumption;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -71,6 +82,7 @@ public:
       disable_mozilla_ca_certificates_,
       disable_deprecated_protocols,
       disable_tls_v1_2,
+      session_resumption_,
     };
   }
 
@@ -82,5 +94,6 @@ private:
   bool disable_mozilla_ca_certificates_{ false };
   bool disable_deprecated_protocols{ true };
   bool disable_tls_v1_2{ false };
+  bool session_resumption_{ true };
 };
 } // namespace couchbase
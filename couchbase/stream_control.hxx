@@ -0,0 +1,41 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+namespace couchbase
+{
+/**
+ * Returned by the row handlers of the streaming queries to tell the SDK whether the application
+ * needs more rows.
+ *
+ * @since 1.0.0
+ * @uncommitted
+ */
+enum class stream_control {
+  /**
+   * Deliver the next row.
+   */
+  next_row,
+
+  /**
+   * Do not deliver any more rows. The response is still read until the end to collect the metadata,
+   * but the remaining rows are discarded without being copied.
+   */
+  stop,
+};
+} // namespace couchbase
@@ -22,6 +22,7 @@
 #include <couchbase/transactions/transactions_query_config.hxx>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
 
@@ -104,6 +105,32 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Get the maximum number of documents unstaged concurrently
+   *
+   * When a transaction commits or rolls back, its staged documents are unstaged in parallel. At
+   * most this many of them are in flight at any time.
+   *
+   * @return maximum number of concurrent unstaging operations.
+   */
+  [[nodiscard]] auto unstaging_window() const -> std::size_t
+  {
+    return unstaging_window_;
+  }
+
+  /**
+   * @brief Set the maximum number of documents unstaged concurrently
+   *
+   * @param window maximum number of concurrent unstaging operations, values below 1 are treated
+   * as 1.
+   * @return reference to this, so calls can be chained.
+   */
+  auto unstaging_window(std::size_t window) -> transactions_config&
+  {
+    unstaging_window_ = window;
+    return *this;
+  }
+
   /**
    * Set the transaction's metadata collection.
    *
@@ -219,6 +246,7 @@ public:
     std::optional<couchbase::transactions::transaction_keyspace> metadata_collection;
     transactions_query_config::built query_config;
     transactions_cleanup_config::built cleanup_config;
+    std::size_t unstaging_window;
   };
 
   /** @internal */
@@ -232,5 +260,6 @@ private:
   std::optional<couchbase::transactions::transaction_keyspace> metadata_collection_;
   transactions_query_config query_config_{};
   transactions_cleanup_config cleanup_config_{};
+  std::size_t unstaging_window_{ 1'000 };
 };
 } // namespace couchbase::transactions
@@ -0,0 +1,119 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "utils/allocation_counter.hxx"
+
+#include "core/protocol/client_request.hxx"
+#include "core/protocol/cmd_upsert.hxx"
+#include "core/utils/byte_buffer_pool.hxx"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+namespace
+{
+using upsert_request =
+  couchbase::core::protocol::client_request<couchbase::core::protocol::upsert_request_body>;
+
+constexpr std::size_t number_of_operations{ 10'000 };
+
+auto
+make_upsert(std::size_t value_size) -> upsert_request
+{
+  upsert_request req;
+  req.opaque(42);
+  req.body().id({ "bucket", "_default", "_default", "foo" });
+  req.body().content(std::vector<std::byte>(value_size, std::byte{ 'a' }));
+  return req;
+}
+
+/**
+ * Encodes the request and copies the packet into the socket buffer, the way mcbp_session does.
+ * Without recycling, the packet buffer is freed after the copy, as it used to be.
+ */
+auto
+encode_and_write(upsert_request& req, std::vector<std::byte>& socket_buffer, bool recycle)
+  -> std::size_t
+{
+  auto packet = req.data();
+  socket_buffer.clear();
+  socket_buffer.insert(socket_buffer.end(), packet.begin(), packet.end());
+  if (recycle) {
+    couchbase::core::utils::byte_buffer_pool::local().release(std::move(packet));
+  }
+  return socket_buffer.size();
+}
+
+auto
+allocations_per_operation(std::size_t value_size, bool recycle) -> double
+{
+  auto req = make_upsert(value_size);
+  std::vector<std::byte> socket_buffer{};
+  // warm up, so that the socket buffer and the pool are populated
+  encode_and_write(req, socket_buffer, recycle);
+
+  const auto before = test::utils::number_of_allocations();
+  for (std::size_t i = 0; i < number_of_operations; ++i) {
+    encode_and_write(req, socket_buffer, recycle);
+  }
+  return static_cast<double>(test::utils::number_of_allocations() - before) /
+         static_cast<double>(number_of_operations);
+}
+} // namespace
+
+TEST_CASE("benchmark: per-operation allocations of KV packet encoding", "[benchmark]")
+{
+  for (const std::size_t value_size : { 128, 4096 }) {
+    auto allocating = allocations_per_operation(value_size, false);
+    auto pooled = allocations_per_operation(value_size, true);
+
+    WARN(fmt::format("allocations per {}-byte upsert: new buffer per packet: {:.2f}, "
+                     "byte_buffer_pool: {:.2f}",
+                     value_size,
+                     allocating,
+                     pooled));
+    REQUIRE(pooled == 0);
+    REQUIRE(allocating > pooled);
+  }
+}
+
+TEST_CASE("benchmark: encode KV packets", "[benchmark]")
+{
+  auto req = make_upsert(4096);
+  std::vector<std::byte> socket_buffer{};
+
+  BENCHMARK("new buffer per packet")
+  {
+    std::size_t bytes{ 0 };
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      bytes += encode_and_write(req, socket_buffer, false);
+    }
+    return bytes;
+  };
+
+  BENCHMARK("byte_buffer_pool")
+  {
+    std::size_t bytes{ 0 };
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      bytes += encode_and_write(req, socket_buffer, true);
+    }
+    return bytes;
+  };
+}
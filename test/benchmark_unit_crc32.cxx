@@ -0,0 +1,73 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/utils/crc32.hxx"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+auto
+make_keys(std::size_t key_size) -> std::vector<std::string>
+{
+  std::vector<std::string> keys{};
+  for (std::size_t i = 0; i < 1'000; ++i) {
+    auto key = "tenant::" + std::to_string(i) + "::order::";
+    key.resize(key_size, 'x');
+    keys.emplace_back(std::move(key));
+  }
+  return keys;
+}
+
+template<typename Function>
+auto
+hash_all(const std::vector<std::string>& keys, Function&& function) -> std::uint32_t
+{
+  std::uint32_t result{ 0 };
+  for (const auto& key : keys) {
+    result ^= function(key.data(), key.size());
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("benchmark: map keys to vbuckets", "[benchmark]")
+{
+  for (const std::size_t key_size : { 16, 80, 200 }) {
+    const auto keys = make_keys(key_size);
+
+    BENCHMARK("bytewise, key_size=" + std::to_string(key_size))
+    {
+      return hash_all(keys, couchbase::core::utils::detail::crc32_bytewise);
+    };
+
+    BENCHMARK("slice-by-8, key_size=" + std::to_string(key_size))
+    {
+      return hash_all(keys, couchbase::core::utils::detail::crc32_slice_by_8);
+    };
+
+    if (couchbase::core::utils::detail::crc32_hardware_supported()) {
+      BENCHMARK("hardware, key_size=" + std::to_string(key_size))
+      {
+        return hash_all(keys, couchbase::core::utils::detail::crc32_hardware);
+      };
+    }
+  }
+}
@@ -0,0 +1,81 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/mcbp_parser.hxx"
+#include "core/utils/byteswap.hxx"
+
+#include <array>
+#include <cstring>
+
+TEST_CASE("benchmark: parse pipelined GET responses", "[benchmark]")
+{
+  static constexpr std::size_t read_size = 16384;
+  static constexpr std::size_t value_size = 64;
+  static constexpr std::uint8_t extlen = 4;
+
+  // fill the buffer with as many complete frames as fit into single socket read
+  std::vector<std::byte> input;
+  std::uint32_t opaque = 0;
+  for (;;) {
+    const auto bodylen = static_cast<std::uint32_t>(extlen + value_size);
+    if (input.size() + sizeof(couchbase::core::io::binary_header) + bodylen > read_size) {
+      break;
+    }
+    couchbase::core::io::binary_header header{};
+    header.magic = 0x81;
+    header.extlen = extlen;
+    header.bodylen = couchbase::core::utils::byte_swap(bodylen);
+    header.opaque = couchbase::core::utils::byte_swap(++opaque);
+    const auto offset = input.size();
+    input.resize(offset + sizeof(header) + bodylen, std::byte{ 'x' });
+    std::memcpy(input.data() + offset, &header, sizeof(header));
+  }
+  const std::size_t number_of_frames = opaque;
+
+  BENCHMARK("parse 16KiB of pipelined frames")
+  {
+    couchbase::core::io::mcbp_parser parser;
+    parser.feed(input.begin(), input.end());
+    std::size_t parsed = 0;
+    couchbase::core::io::mcbp_message msg{};
+    while (parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok) {
+      ++parsed;
+    }
+    REQUIRE(parsed == number_of_frames);
+    return parsed;
+  };
+
+  BENCHMARK("parse pipelined frames split across reads")
+  {
+    couchbase::core::io::mcbp_parser parser;
+    std::size_t parsed = 0;
+    couchbase::core::io::mcbp_message msg{};
+    static constexpr std::size_t chunk_size = 1000;
+    for (std::size_t pos = 0; pos < input.size(); pos += chunk_size) {
+      auto end = std::min(pos + chunk_size, input.size());
+      parser.feed(input.begin() + static_cast<std::ptrdiff_t>(pos),
+                  input.begin() + static_cast<std::ptrdiff_t>(end));
+      while (parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok) {
+        ++parsed;
+      }
+    }
+    REQUIRE(parsed == number_of_frames);
+    return parsed;
+  };
+}
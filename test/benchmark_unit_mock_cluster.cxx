@@ -0,0 +1,207 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "utils/allocation_counter.hxx"
+#include "utils/mock_cluster.hxx"
+
+#include <couchbase/cluster.hxx>
+#include <couchbase/lookup_in_specs.hxx>
+#include <couchbase/match_all_query.hxx>
+#include <couchbase/mutate_in_specs.hxx>
+
+#include <fmt/format.h>
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t number_of_operations{ 5'000 };
+
+struct profile {
+  double operations_per_second{};
+  double allocations_per_operation{};
+  std::chrono::nanoseconds p50{};
+  std::chrono::nanoseconds p99{};
+  std::size_t failures{ 0 };
+};
+
+/**
+ * Runs the operation sequentially, so that every sample is the latency of the whole round trip
+ * through the SDK and the loopback, and the allocations are not mixed between the operations.
+ */
+template<typename Operation>
+auto
+run_profile(Operation&& operation) -> profile
+{
+  std::vector<std::chrono::nanoseconds> latencies(number_of_operations);
+  profile result{};
+
+  // warm up the connections, the buffers and the caches
+  for (std::size_t i = 0; i < 100; ++i) {
+    operation(i);
+  }
+
+  const auto allocations_before = test::utils::number_of_allocations();
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < number_of_operations; ++i) {
+    const auto operation_start = std::chrono::steady_clock::now();
+    if (!operation(i)) {
+      ++result.failures;
+    }
+    latencies[i] = std::chrono::steady_clock::now() - operation_start;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto allocations = test::utils::number_of_allocations() - allocations_before;
+
+  std::sort(latencies.begin(), latencies.end());
+  result.operations_per_second = static_cast<double>(number_of_operations) /
+                                 std::chrono::duration<double>(elapsed).count();
+  result.allocations_per_operation =
+    static_cast<double>(allocations) / static_cast<double>(number_of_operations);
+  result.p50 = latencies[latencies.size() / 2];
+  result.p99 = latencies[latencies.size() * 99 / 100];
+  return result;
+}
+
+void
+report(const std::string& name, const profile& p)
+{
+  WARN(fmt::format("{:<10} {:>9.0f} ops/s, {:>6.1f} allocations/op, p50 {:>6} us, p99 {:>6} us",
+                   name,
+                   p.operations_per_second,
+                   p.allocations_per_operation,
+                   std::chrono::duration_cast<std::chrono::microseconds>(p.p50).count(),
+                   std::chrono::duration_cast<std::chrono::microseconds>(p.p99).count()));
+}
+
+auto
+document_id(std::size_t index) -> std::string
+{
+  return fmt::format("doc_{}", index % 100);
+}
+} // namespace
+
+TEST_CASE("benchmark: collection operations against mock cluster", "[benchmark]")
+{
+  test::utils::mock_cluster_options options{};
+  options.on_thread_start = []() {
+    test::utils::ignore_allocations_on_this_thread();
+  };
+  test::utils::mock_cluster mock(options);
+
+  auto [err, cluster] =
+    couchbase::cluster::connect(mock.connection_string(), mock.build_options()).get();
+  REQUIRE_SUCCESS(err.ec());
+  auto collection = cluster.bucket(mock.bucket_name()).default_collection();
+
+  const tao::json::value document = {
+    { "name", "mock" },
+    { "counter", 0 },
+    { "tags", tao::json::value::array({ "a", "b", "c" }) },
+  };
+
+  auto upsert = run_profile([&](std::size_t i) {
+    auto [e, res] = collection.upsert(document_id(i), document).get();
+    return !e.ec();
+  });
+  report("upsert", upsert);
+
+  auto get = run_profile([&](std::size_t i) {
+    auto [e, res] = collection.get(document_id(i)).get();
+    return !e.ec();
+  });
+  report("get", get);
+
+  auto lookup_in = run_profile([&](std::size_t i) {
+    auto [e, res] = collection
+                      .lookup_in(document_id(i),
+                                 couchbase::lookup_in_specs{
+                                   couchbase::lookup_in_specs::get("name"),
+                                   couchbase::lookup_in_specs::exists("tags"),
+                                 })
+                      .get();
+    return !e.ec();
+  });
+  report("lookup_in", lookup_in);
+
+  auto mutate_in = run_profile([&](std::size_t i) {
+    auto [e, res] = collection
+                      .mutate_in(document_id(i),
+                                 couchbase::mutate_in_specs{
+                                   couchbase::mutate_in_specs::increment("counter", 1),
+                                   couchbase::mutate_in_specs::upsert("name", "updated"),
+                                 })
+                      .get();
+    return !e.ec();
+  });
+  report("mutate_in", mutate_in);
+
+  auto query = run_profile([&](std::size_t /* i */) {
+    auto [e, res] = cluster.query("SELECT 1", {}).get();
+    return !e.ec() && res.rows_as_binary().size() == 1;
+  });
+  report("query", query);
+
+  auto search = run_profile([&](std::size_t /* i */) {
+    auto [e, res] =
+      cluster.search("index", couchbase::search_request(couchbase::match_all_query{})).get();
+    return !e.ec() && res.rows().size() == 1;
+  });
+  report("search", search);
+
+  // the second pass misses the documents, which exercises the error path as well
+  std::size_t unexpected_remove_results{ 0 };
+  for (std::size_t i = 0; i < 200; ++i) {
+    auto [e, res] = collection.remove(document_id(i)).get();
+    if (static_cast<bool>(e.ec()) != (i >= 100)) {
+      ++unexpected_remove_results;
+    }
+  }
+
+  auto stats = mock.stats();
+  WARN(fmt::format("mock handled {} KV requests over {} connections, and {} HTTP requests",
+                   stats.kv_requests,
+                   stats.kv_connections,
+                   stats.http_requests));
+
+  REQUIRE(upsert.failures == 0);
+  REQUIRE(get.failures == 0);
+  REQUIRE(lookup_in.failures == 0);
+  REQUIRE(mutate_in.failures == 0);
+  REQUIRE(query.failures == 0);
+  REQUIRE(search.failures == 0);
+  REQUIRE(unexpected_remove_results == 0);
+  REQUIRE(stats.number_of_documents == 0);
+
+  BENCHMARK("upsert")
+  {
+    return collection.upsert("benchmark", document).get();
+  };
+
+  BENCHMARK("get")
+  {
+    return collection.get("benchmark").get();
+  };
+
+  cluster.close().get();
+}
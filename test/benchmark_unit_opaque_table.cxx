@@ -0,0 +1,82 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/opaque_table.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <map>
+#include <mutex>
+
+namespace
+{
+using handler_type = couchbase::core::utils::movable_function<void(std::uint32_t)>;
+
+// the number of requests kept in flight, while the next batch is being registered
+constexpr std::uint32_t in_flight{ 512 };
+constexpr std::uint32_t number_of_operations{ 100'000 };
+
+auto
+make_handler(std::uint64_t& counter) -> handler_type
+{
+  return [&counter](std::uint32_t opaque) {
+    counter += opaque;
+  };
+}
+} // namespace
+
+TEST_CASE("benchmark: register and complete in-flight KV handlers", "[benchmark]")
+{
+  BENCHMARK("std::map with mutex")
+  {
+    std::uint64_t counter{ 0 };
+    std::mutex mutex{};
+    std::map<std::uint32_t, handler_type> handlers{};
+    for (std::uint32_t opaque = 0; opaque < number_of_operations; ++opaque) {
+      {
+        const std::scoped_lock lock(mutex);
+        handlers.try_emplace(opaque, make_handler(counter));
+      }
+      if (opaque >= in_flight) {
+        handler_type fun{};
+        {
+          const std::scoped_lock lock(mutex);
+          if (auto it = handlers.find(opaque - in_flight); it != handlers.end()) {
+            fun = std::move(it->second);
+            handlers.erase(it);
+          }
+        }
+        fun(opaque);
+      }
+    }
+    return counter;
+  };
+
+  BENCHMARK("opaque_table")
+  {
+    std::uint64_t counter{ 0 };
+    couchbase::core::io::opaque_table<handler_type> handlers{};
+    for (std::uint32_t opaque = 0; opaque < number_of_operations; ++opaque) {
+      handlers.insert(opaque, make_handler(counter));
+      if (opaque >= in_flight) {
+        handlers.take(opaque - in_flight)(opaque);
+      }
+    }
+    return counter;
+  };
+}
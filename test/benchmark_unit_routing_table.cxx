@@ -0,0 +1,161 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/topology/configuration.hxx"
+#include "core/topology/routing_table.hxx"
+#include "core/utils/rcu_cell.hxx"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using session_type = std::shared_ptr<std::string>;
+using routing_table = couchbase::core::topology::routing_table<session_type>;
+
+constexpr std::size_t number_of_keys{ 1'000 };
+constexpr std::size_t operations_per_thread{ 50'000 };
+
+auto
+make_configuration() -> couchbase::core::topology::configuration
+{
+  couchbase::core::topology::configuration config{};
+  config.epoch = 1;
+  config.rev = 1;
+  couchbase::core::topology::configuration::vbucket_map vbmap(1024);
+  for (std::size_t vbucket = 0; vbucket < vbmap.size(); ++vbucket) {
+    vbmap[vbucket] = { static_cast<std::int16_t>(vbucket % 4) };
+  }
+  config.vbmap = vbmap;
+  return config;
+}
+
+auto
+make_sessions() -> std::map<std::size_t, session_type>
+{
+  std::map<std::size_t, session_type> sessions{};
+  for (std::size_t index = 0; index < 4; ++index) {
+    sessions.try_emplace(index, std::make_shared<std::string>(std::to_string(index)));
+  }
+  return sessions;
+}
+
+auto
+make_keys() -> std::vector<std::string>
+{
+  std::vector<std::string> keys{};
+  keys.reserve(number_of_keys);
+  for (std::size_t i = 0; i < number_of_keys; ++i) {
+    keys.emplace_back("key_" + std::to_string(i));
+  }
+  return keys;
+}
+
+/**
+ * Reproduces the dispatch path of the bucket before the routing snapshot: the key is mapped under
+ * the configuration lock, and the session is looked up under the sessions lock.
+ */
+struct locked_router {
+  std::optional<couchbase::core::topology::configuration> config{ make_configuration() };
+  std::mutex config_mutex{};
+  std::map<std::size_t, session_type> sessions{ make_sessions() };
+  std::mutex sessions_mutex{};
+
+  auto route(const std::string& key) -> session_type
+  {
+    std::optional<std::size_t> server{};
+    {
+      const std::scoped_lock lock(config_mutex);
+      server = config->map_key(key, 0).second;
+    }
+    const std::scoped_lock lock(sessions_mutex);
+    if (auto ptr = sessions.find(server.value()); ptr != sessions.end()) {
+      return ptr->second;
+    }
+    return {};
+  }
+};
+
+struct rcu_router {
+  couchbase::core::utils::rcu_cell<routing_table> routing{};
+
+  rcu_router()
+  {
+    routing.publish(std::make_unique<const routing_table>(make_configuration(), make_sessions()));
+  }
+
+  auto route(const std::string& key) -> session_type
+  {
+    return routing.read([&key](const routing_table* table) -> session_type {
+      if (auto server = table->map_key(key, 0).second; server) {
+        return table->find_session(server.value()).value_or(nullptr);
+      }
+      return {};
+    });
+  }
+};
+
+template<typename Router>
+auto
+dispatch(Router& router, const std::vector<std::string>& keys, std::size_t number_of_threads)
+  -> std::size_t
+{
+  std::vector<std::size_t> routed(number_of_threads);
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&router, &keys, &routed, t]() {
+      for (std::size_t i = 0; i < operations_per_thread; ++i) {
+        if (router.route(keys[(i + t) % keys.size()]) != nullptr) {
+          ++routed[t];
+        }
+      }
+    });
+  }
+  std::size_t total{ 0 };
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads[t].join();
+    total += routed[t];
+  }
+  return total;
+}
+} // namespace
+
+TEST_CASE("benchmark: route KV operations from multiple threads", "[benchmark]")
+{
+  const auto keys = make_keys();
+  const auto number_of_threads = std::max(4U, std::thread::hardware_concurrency());
+
+  locked_router locked{};
+  BENCHMARK("config_mutex_ and sessions_mutex_")
+  {
+    return dispatch(locked, keys, number_of_threads);
+  };
+
+  rcu_router rcu{};
+  BENCHMARK("rcu_cell<routing_table>")
+  {
+    return dispatch(rcu, keys, number_of_threads);
+  };
+}
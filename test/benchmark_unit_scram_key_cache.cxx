@@ -0,0 +1,97 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/platform/base64.h"
+#include "core/sasl/client.h"
+#include "core/sasl/scram-sha/key_cache.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t number_of_sessions{ 64 };
+
+/**
+ * Runs the client side of the SCRAM exchange for all sessions at once, like the reconnection of
+ * every session after failover. Returns the number of sessions that produced the client proof.
+ *
+ * When the sessions use distinct users, none of them finds the keys in the cache, which is the
+ * cost of the exchange without the cache.
+ */
+auto
+reconnect_sessions(const std::string& server_first_message, bool distinct_users) -> std::size_t
+{
+  const auto number_of_threads = std::max(4U, std::thread::hardware_concurrency());
+  std::vector<std::size_t> authenticated(number_of_threads);
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&server_first_message,
+                          &authenticated,
+                          distinct_users,
+                          number_of_threads,
+                          t]() {
+      for (std::size_t i = t; i < number_of_sessions; i += number_of_threads) {
+        const auto username = distinct_users ? "user_" + std::to_string(i) : "Administrator";
+        couchbase::core::sasl::ClientContext client(
+          [&username]() { return username; },
+          []() { return std::string{ "password" }; },
+          { "SCRAM-SHA512" });
+        client.start();
+        if (client.step(server_first_message).first == couchbase::core::sasl::error::CONTINUE) {
+          ++authenticated[t];
+        }
+      }
+    });
+  }
+  std::size_t total{ 0 };
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads[t].join();
+    total += authenticated[t];
+  }
+  return total;
+}
+} // namespace
+
+TEST_CASE("benchmark: SCRAM exchange of reconnecting sessions", "[benchmark]")
+{
+  using couchbase::core::sasl::mechanism::scram::KeyCache;
+
+  const std::string server_first_message =
+    "r=nonce,s=" + couchbase::core::base64::encode(std::string_view{ "0123456789abcdef" }) +
+    ",i=15000";
+
+  BENCHMARK("derive keys for every session")
+  {
+    KeyCache::instance().clear();
+    return reconnect_sessions(server_first_message, true);
+  };
+
+  BENCHMARK("derive keys once")
+  {
+    KeyCache::instance().clear();
+    return reconnect_sessions(server_first_message, false);
+  };
+
+  const auto stats = KeyCache::instance().stats();
+  WARN(fmt::format("SCRAM key cache: {} misses, {} hits", stats.misses, stats.hits));
+}
@@ -0,0 +1,79 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/transactions/staged_mutation.hxx"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+using couchbase::core::transactions::staged_mutation;
+using couchbase::core::transactions::staged_mutation_queue;
+using couchbase::core::transactions::staged_mutation_type;
+
+auto
+make_mutations(std::size_t number_of_documents) -> std::vector<staged_mutation>
+{
+  std::vector<staged_mutation> mutations{};
+  mutations.reserve(number_of_documents);
+  for (std::size_t i = 0; i < number_of_documents; ++i) {
+    couchbase::core::document_id id{ "bucket", "scope", "collection", "doc_" + std::to_string(i) };
+    mutations.emplace_back(
+      couchbase::core::transactions::transaction_get_result{ id, {}, 0, {}, {} },
+      couchbase::codec::encoded_value{},
+      staged_mutation_type::INSERT,
+      std::to_string(i));
+  }
+  return mutations;
+}
+
+/**
+ * Stages every document, then looks it up the same way attempt_context_impl does before staging
+ * the next operation on it.
+ */
+auto
+stage(const std::vector<staged_mutation>& mutations) -> std::size_t
+{
+  staged_mutation_queue queue{};
+  std::size_t found{ 0 };
+  for (const auto& mutation : mutations) {
+    queue.add(mutation);
+  }
+  for (const auto& mutation : mutations) {
+    if (queue.find_insert(mutation.id()) != nullptr) {
+      ++found;
+    }
+  }
+  return found;
+}
+} // namespace
+
+TEST_CASE("benchmark: stage mutations of a large transaction", "[benchmark]")
+{
+  for (std::size_t number_of_documents : { 12'500, 25'000, 50'000 }) {
+    const auto mutations = make_mutations(number_of_documents);
+    REQUIRE(stage(mutations) == number_of_documents);
+
+    BENCHMARK("staged_mutation_queue with " + std::to_string(number_of_documents) + " documents")
+    {
+      return stage(mutations);
+    };
+  }
+}
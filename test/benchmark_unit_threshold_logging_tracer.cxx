@@ -0,0 +1,167 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "utils/allocation_counter.hxx"
+
+#include "core/tracing/constants.hxx"
+#include "core/tracing/threshold_logging_tracer.hxx"
+
+#include <asio/io_context.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t number_of_operations{ 10'000 };
+
+/**
+ * Tags and names are prepared upfront, so that only the cost of the span itself is measured.
+ */
+struct kv_operation_tags {
+  std::string name{ couchbase::core::tracing::operation::mcbp_get };
+  std::string service{ couchbase::core::tracing::attributes::service };
+  std::string key_value{ couchbase::core::tracing::service::key_value };
+  std::string instance{ couchbase::core::tracing::attributes::instance };
+  std::string bucket{ "travel-sample" };
+  std::string operation_id{ couchbase::core::tracing::attributes::operation_id };
+  std::string opaque{ "0x2a" };
+  std::string remote_socket{ couchbase::core::tracing::attributes::remote_socket };
+  std::string remote_address{ "192.168.1.101:11210" };
+  std::string local_socket{ couchbase::core::tracing::attributes::local_socket };
+  std::string local_address{ "192.168.1.1:51234" };
+  std::string local_id{ couchbase::core::tracing::attributes::local_id };
+  std::string session_id{ "8f3c3b3a6ad0a4b5/0e4d2d6c8c1b41f3" };
+  std::string server_duration{ couchbase::core::tracing::attributes::server_duration };
+};
+
+/**
+ * Traces the KV operation with the same tags as mcbp_command.
+ */
+auto
+trace_operation(couchbase::core::tracing::threshold_logging_tracer& tracer,
+                const kv_operation_tags& tags) -> std::size_t
+{
+  auto span = tracer.start_span(tags.name, nullptr);
+  span->add_tag(tags.service, tags.key_value);
+  span->add_tag(tags.instance, tags.bucket);
+  span->add_tag(tags.operation_id, tags.opaque);
+  span->add_tag(tags.remote_socket, tags.remote_address);
+  span->add_tag(tags.local_socket, tags.local_address);
+  span->add_tag(tags.local_id, tags.session_id);
+  span->add_tag(tags.server_duration, 42);
+  span->end();
+  return span.use_count();
+}
+
+/**
+ * Traces the KV operation that takes a few microseconds, so that it exceeds the zero threshold.
+ */
+auto
+trace_slow_operation(couchbase::core::tracing::threshold_logging_tracer& tracer,
+                     const kv_operation_tags& tags) -> std::size_t
+{
+  auto span = tracer.start_span(tags.name, nullptr);
+  span->add_tag(tags.service, tags.key_value);
+  span->add_tag(tags.operation_id, tags.opaque);
+  span->add_tag(tags.remote_socket, tags.remote_address);
+  span->add_tag(tags.local_socket, tags.local_address);
+  span->add_tag(tags.local_id, tags.session_id);
+  const auto deadline = std::chrono::system_clock::now() + std::chrono::microseconds(2);
+  while (std::chrono::system_clock::now() < deadline) {
+    // busy wait
+  }
+  span->end();
+  return span.use_count();
+}
+
+auto
+make_tracer(asio::io_context& ctx,
+            couchbase::core::tracing::threshold_logging_options options = {})
+  -> std::shared_ptr<couchbase::core::tracing::threshold_logging_tracer>
+{
+  return std::make_shared<couchbase::core::tracing::threshold_logging_tracer>(ctx, options);
+}
+} // namespace
+
+TEST_CASE("benchmark: per-operation allocations of threshold logging tracer", "[benchmark]")
+{
+  asio::io_context ctx{};
+  auto tracer = make_tracer(ctx);
+  const kv_operation_tags tags{};
+
+  const auto before = test::utils::number_of_allocations();
+  for (std::size_t i = 0; i < number_of_operations; ++i) {
+    trace_operation(*tracer, tags);
+  }
+  const auto allocations = static_cast<double>(test::utils::number_of_allocations() - before) /
+                           static_cast<double>(number_of_operations);
+
+  WARN(fmt::format("allocations per KV operation under threshold: {:.2f}", allocations));
+}
+
+TEST_CASE("benchmark: trace KV operations", "[benchmark]")
+{
+  asio::io_context ctx{};
+  auto tracer = make_tracer(ctx);
+  const kv_operation_tags tags{};
+
+  BENCHMARK("threshold_logging_span under threshold")
+  {
+    std::size_t references{ 0 };
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      references += trace_operation(*tracer, tags);
+    }
+    return references;
+  };
+}
+
+TEST_CASE("benchmark: report slow KV operations from multiple threads", "[benchmark]")
+{
+  asio::io_context ctx{};
+  couchbase::core::tracing::threshold_logging_options options{};
+  options.key_value_threshold = std::chrono::milliseconds::zero();
+  auto tracer = make_tracer(ctx, options);
+  const kv_operation_tags tags{};
+  const auto number_of_threads = std::max(4U, std::thread::hardware_concurrency());
+
+  BENCHMARK("every operation over threshold")
+  {
+    std::vector<std::thread> threads{};
+    threads.reserve(number_of_threads);
+    std::atomic_size_t references{ 0 };
+    for (std::size_t t = 0; t < number_of_threads; ++t) {
+      threads.emplace_back([&tracer, &tags, &references]() {
+        for (std::size_t i = 0; i < number_of_operations; ++i) {
+          references += trace_slow_operation(*tracer, tags);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return references.load();
+  };
+}
@@ -0,0 +1,170 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "utils/allocation_counter.hxx"
+
+#include "core/io/timing_wheel.hxx"
+#include "core/platform/uuid.h"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace
+{
+constexpr std::uint8_t opcode{ 0x01 };
+constexpr std::chrono::milliseconds timeout{ 2'500 };
+constexpr std::size_t number_of_operations{ 10'000 };
+
+/**
+ * The way mcbp_command used to prepare its identifier and timers before dispatching the request.
+ */
+struct asio_timer_command : std::enable_shared_from_this<asio_timer_command> {
+  explicit asio_timer_command(asio::io_context& ctx)
+    : ctx_{ ctx }
+    , deadline{ ctx }
+    , retry_backoff{ ctx }
+  {
+  }
+
+  void start()
+  {
+    id_ = fmt::format("{:02x}/{}",
+                      opcode,
+                      couchbase::core::uuid::to_string(couchbase::core::uuid::random()));
+    deadline.expires_after(timeout);
+    deadline.async_wait([self = shared_from_this()](std::error_code /* ec */) {
+    });
+  }
+
+  void complete()
+  {
+    retry_backoff.cancel();
+    deadline.cancel();
+    // let the cancelled handler run, as it would in the IO thread
+    ctx_.restart();
+    ctx_.poll();
+  }
+
+  asio::io_context& ctx_;
+  asio::steady_timer deadline;
+  asio::steady_timer retry_backoff;
+  std::string id_{};
+};
+
+struct wheel_timer_command : std::enable_shared_from_this<wheel_timer_command> {
+  explicit wheel_timer_command(couchbase::core::io::timing_wheel& wheel)
+    : deadline{ wheel }
+    , retry_backoff{ wheel }
+  {
+  }
+
+  void start(std::uint64_t command_id)
+  {
+    command_id_ = command_id;
+    deadline.expires_after(timeout);
+    deadline.async_wait<&wheel_timer_command::on_deadline>(shared_from_this());
+  }
+
+  void on_deadline()
+  {
+  }
+
+  void complete()
+  {
+    retry_backoff.cancel();
+    deadline.cancel();
+  }
+
+  couchbase::core::io::wheel_timer deadline;
+  couchbase::core::io::wheel_timer retry_backoff;
+  std::uint64_t command_id_{};
+};
+
+template<typename Command, typename Operation>
+auto
+allocations_per_operation(const std::shared_ptr<Command>& command, Operation&& operation)
+  -> double
+{
+  // warm up, so that lazily created state is not accounted
+  operation(command, 0);
+  command->complete();
+
+  const auto before = test::utils::number_of_allocations();
+  for (std::size_t i = 1; i <= number_of_operations; ++i) {
+    operation(command, i);
+    command->complete();
+  }
+  return static_cast<double>(test::utils::number_of_allocations() - before) /
+         static_cast<double>(number_of_operations);
+}
+} // namespace
+
+TEST_CASE("benchmark: per-operation allocations of KV command deadlines", "[benchmark]")
+{
+  asio::io_context io{};
+
+  auto asio_command = std::make_shared<asio_timer_command>(io);
+  auto asio_allocations = allocations_per_operation(asio_command, [](auto& cmd, std::size_t) {
+    cmd->start();
+  });
+
+  auto& wheel = asio::use_service<couchbase::core::io::timing_wheel>(io);
+  auto wheel_command = std::make_shared<wheel_timer_command>(wheel);
+  auto wheel_allocations = allocations_per_operation(wheel_command, [](auto& cmd, std::size_t i) {
+    cmd->start(i);
+  });
+
+  WARN(fmt::format("allocations per operation: asio::steady_timer with UUID id: {:.2f}, "
+                   "wheel_timer with counter id: {:.2f}",
+                   asio_allocations,
+                   wheel_allocations));
+  REQUIRE(wheel_allocations == 0);
+  REQUIRE(asio_allocations > wheel_allocations);
+}
+
+TEST_CASE("benchmark: arm and cancel KV command deadlines", "[benchmark]")
+{
+  asio::io_context io{};
+  auto& wheel = asio::use_service<couchbase::core::io::timing_wheel>(io);
+
+  BENCHMARK("asio::steady_timer with UUID id")
+  {
+    auto command = std::make_shared<asio_timer_command>(io);
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      command->start();
+      command->complete();
+    }
+    return command->id_.size();
+  };
+
+  BENCHMARK("wheel_timer with counter id")
+  {
+    auto command = std::make_shared<wheel_timer_command>(wheel);
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      command->start(i);
+      command->complete();
+    }
+    return command->command_id_;
+  };
+}
@@ -1093,3 +1093,62 @@ TEST_CASE("integration: get with expiry with public API", "[integration]")
     }
   }
 }
+
+TEST_CASE("integration: multi-document operations with public API", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto test_ctx = integration.ctx;
+  auto [e, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(e.ec());
+
+  auto collection = cluster.bucket(integration.ctx.bucket)
+                      .scope(couchbase::scope::default_name)
+                      .collection(couchbase::collection::default_name);
+
+  std::vector<std::pair<std::string, tao::json::value>> documents{};
+  std::vector<std::string> ids{};
+  for (int i = 0; i < 100; ++i) {
+    auto id = test::utils::uniq_id("multi");
+    auto doc = basic_doc;
+    doc["index"] = i;
+    documents.emplace_back(id, doc);
+    ids.emplace_back(id);
+  }
+
+  {
+    auto results = collection.upsert_multi(documents).get();
+    REQUIRE(results.size() == documents.size());
+    for (const auto& [err, resp] : results) {
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE_FALSE(resp.cas().empty());
+    }
+  }
+
+  {
+    auto missing_ids = ids;
+    missing_ids.emplace_back(test::utils::uniq_id("missing"));
+    auto results = collection.get_multi(missing_ids).get();
+    REQUIRE(results.size() == missing_ids.size());
+    for (std::size_t i = 0; i < documents.size(); ++i) {
+      const auto& [err, resp] = results[i];
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE(resp.content_as<tao::json::value>() == documents[i].second);
+    }
+    REQUIRE(results.back().first.ec() == couchbase::errc::key_value::document_not_found);
+  }
+
+  {
+    auto results = collection.remove_multi(ids).get();
+    REQUIRE(results.size() == ids.size());
+    for (const auto& [err, resp] : results) {
+      REQUIRE_SUCCESS(err.ec());
+    }
+  }
+
+  {
+    auto results = collection.get_multi({}).get();
+    REQUIRE(results.empty());
+  }
+}
@@ -611,6 +611,49 @@ TEST_CASE("integration: query with public API", "[integration]")
   }
 }
 
+TEST_CASE("integration: streaming query results with public API", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  if (!integration.cluster_version().supports_query()) {
+    SKIP("cluster does not support query");
+  }
+
+  if (!integration.cluster_version().supports_gcccp()) {
+    test::utils::open_bucket(integration.cluster, integration.ctx.bucket);
+  }
+
+  auto test_ctx = integration.ctx;
+  auto [err, cluster] =
+    couchbase::cluster::connect(test_ctx.connection_string, test_ctx.build_options()).get();
+  REQUIRE_SUCCESS(err.ec());
+
+  std::vector<std::string> rows{};
+  auto barrier =
+    std::make_shared<std::promise<std::pair<couchbase::error, couchbase::query_result>>>();
+  auto f = barrier->get_future();
+  cluster.query(
+    R"(SELECT * FROM  [{"tech": "C++"}, {"tech": "Ruby"}, {"tech": "Couchbase"}] AS data)",
+    {},
+    [&rows](couchbase::codec::binary row) {
+      rows.emplace_back(reinterpret_cast<const char*>(row.data()), row.size());
+      if (rows.back().find("Ruby") != std::string::npos) {
+        return couchbase::stream_control::stop;
+      }
+      return couchbase::stream_control::next_row;
+    },
+    [barrier](auto ctx, auto result) {
+      barrier->set_value({ std::move(ctx), std::move(result) });
+    });
+  auto [ctx, resp] = f.get();
+  REQUIRE_SUCCESS(ctx.ec());
+  REQUIRE(resp.rows_as_binary().empty());
+  REQUIRE(resp.meta_data().status() == couchbase::query_status::success);
+  REQUIRE(rows.size() == 2);
+  REQUIRE(rows[0] == R"({"data":{"tech":"C++"}})");
+  REQUIRE(rows[1] == R"({"data":{"tech":"Ruby"}})");
+}
+
 TEST_CASE("integration: query from scope with public API", "[integration]")
 {
   test::utils::integration_test_guard integration;
@@ -0,0 +1,97 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/adaptive_read_buffer.hxx"
+
+using couchbase::core::io::adaptive_read_buffer;
+
+TEST_CASE("unit: read buffer grows up to the limit when reads fill it", "[unit]")
+{
+  adaptive_read_buffer buffer{};
+  REQUIRE(buffer.size() == adaptive_read_buffer::min_size);
+
+  const std::size_t max_size = adaptive_read_buffer::min_size * 4;
+  REQUIRE(buffer.on_read(buffer.size(), max_size));
+  REQUIRE(buffer.size() == adaptive_read_buffer::min_size * 2);
+  REQUIRE(buffer.on_read(buffer.size(), max_size));
+  REQUIRE(buffer.size() == max_size);
+  REQUIRE_FALSE(buffer.on_read(buffer.size(), max_size));
+  REQUIRE(buffer.size() == max_size);
+
+  // the limit below the minimal size does not shrink the buffer
+  adaptive_read_buffer small{};
+  REQUIRE_FALSE(small.on_read(small.size(), 1024));
+  REQUIRE(small.size() == adaptive_read_buffer::min_size);
+}
+
+TEST_CASE("unit: read buffer shrinks after series of small reads", "[unit]")
+{
+  adaptive_read_buffer buffer{};
+  const std::size_t max_size = adaptive_read_buffer::min_size * 4;
+  buffer.on_read(buffer.size(), max_size);
+  buffer.on_read(buffer.size(), max_size);
+  REQUIRE(buffer.size() == max_size);
+
+  for (std::size_t i = 1; i < adaptive_read_buffer::shrink_threshold; ++i) {
+    REQUIRE_FALSE(buffer.on_read(100, max_size));
+  }
+  // read that uses the buffer well resets the series
+  REQUIRE_FALSE(buffer.on_read(max_size / 2, max_size));
+  for (std::size_t i = 1; i < adaptive_read_buffer::shrink_threshold; ++i) {
+    REQUIRE_FALSE(buffer.on_read(100, max_size));
+  }
+  REQUIRE(buffer.on_read(100, max_size));
+  REQUIRE(buffer.size() == max_size / 2);
+}
+
+TEST_CASE("unit: read buffer is released when connection stays idle", "[unit]")
+{
+  adaptive_read_buffer buffer{};
+  const std::size_t max_size = adaptive_read_buffer::min_size * 16;
+  while (buffer.size() < max_size) {
+    buffer.on_read(buffer.size(), max_size);
+  }
+
+  REQUIRE(buffer.on_idle());
+  // the read of the idle connection uses the minimal buffer, but the grown one is still held
+  REQUIRE(buffer.size() == adaptive_read_buffer::min_size);
+  REQUIRE(buffer.capacity() == max_size);
+
+  REQUIRE(buffer.release());
+  REQUIRE(buffer.size() == adaptive_read_buffer::min_size);
+  REQUIRE(buffer.capacity() == adaptive_read_buffer::min_size);
+  REQUIRE_FALSE(buffer.on_idle());
+  REQUIRE_FALSE(buffer.release());
+}
+
+TEST_CASE("unit: read buffer is kept when traffic resumes after idle point", "[unit]")
+{
+  adaptive_read_buffer buffer{};
+  const std::size_t max_size = adaptive_read_buffer::min_size * 16;
+  while (buffer.size() < max_size) {
+    buffer.on_read(buffer.size(), max_size);
+  }
+
+  REQUIRE(buffer.on_idle());
+  // the read has completed before the release
+  REQUIRE_FALSE(buffer.on_read(100, max_size));
+  REQUIRE(buffer.size() == max_size);
+  REQUIRE_FALSE(buffer.release());
+  REQUIRE(buffer.capacity() == max_size);
+}
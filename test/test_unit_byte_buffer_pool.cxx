@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/protocol/client_request.hxx"
+#include "core/protocol/cmd_upsert.hxx"
+#include "core/utils/byte_buffer_pool.hxx"
+
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("unit: byte buffer pool reuses released buffers", "[unit]")
+{
+  couchbase::core::utils::byte_buffer_pool pool{};
+
+  auto buffer = pool.acquire(128);
+  REQUIRE(buffer.size() == 128);
+  std::fill(buffer.begin(), buffer.end(), std::byte{ 0xff });
+  const auto* storage = buffer.data();
+  pool.release(std::move(buffer));
+  REQUIRE(pool.size() == 1);
+
+  buffer = pool.acquire(64);
+  REQUIRE(buffer.data() == storage);
+  REQUIRE(buffer.size() == 64);
+  REQUIRE(std::all_of(buffer.begin(), buffer.end(), [](auto b) {
+    return b == std::byte{ 0 };
+  }));
+  REQUIRE(pool.size() == 0);
+
+  auto stats = pool.stats();
+  REQUIRE(stats.allocations == 1);
+  REQUIRE(stats.reuses == 1);
+}
+
+TEST_CASE("unit: byte buffer pool does not retain large or excess buffers", "[unit]")
+{
+  using couchbase::core::utils::byte_buffer_pool;
+  byte_buffer_pool pool{};
+
+  pool.release(std::vector<std::byte>(byte_buffer_pool::max_buffer_capacity + 1));
+  pool.release(std::vector<std::byte>{});
+  REQUIRE(pool.size() == 0);
+
+  for (std::size_t i = 0; i < byte_buffer_pool::max_buffers + 10; ++i) {
+    pool.release(std::vector<std::byte>(16));
+  }
+  REQUIRE(pool.size() == byte_buffer_pool::max_buffers);
+
+  // the buffer is too small, so it has to grow
+  auto buffer = pool.acquire(1024);
+  REQUIRE(buffer.size() == 1024);
+  REQUIRE(pool.stats().allocations == 1);
+}
+
+TEST_CASE("unit: encoded requests use buffers of the thread-local pool", "[unit]")
+{
+  auto& pool = couchbase::core::utils::byte_buffer_pool::local();
+
+  couchbase::core::protocol::client_request<couchbase::core::protocol::upsert_request_body> req;
+  req.opaque(42);
+  req.body().id({ "bucket", "_default", "_default", "foo" });
+  req.body().content(std::vector<std::byte>(512, std::byte{ 'a' }));
+
+  auto first = req.data();
+  const auto* storage = first.data();
+  pool.release(std::move(first));
+  const auto reuses = pool.stats().reuses;
+
+  auto second = req.data();
+  REQUIRE(second.data() == storage);
+  REQUIRE(pool.stats().reuses == reuses + 1);
+}
@@ -417,6 +417,32 @@ TEST_CASE("unit: connection string", "[unit]")
       "couchbase://127.0.0.1?key_value_timeout=42&query_timeout=123");
     CHECK(spec.options.key_value_timeout == std::chrono::milliseconds(42));
     CHECK(spec.options.query_timeout == std::chrono::milliseconds(123));
+    CHECK(couchbase::core::utils::parse_connection_string(
+            "couchbase://127.0.0.1?max_key_value_read_buffer_size=1048576")
+            .options.max_key_value_read_buffer_size == 1048576);
+    CHECK(couchbase::core::utils::parse_connection_string("couchbase://127.0.0.1?io_threads=4")
+            .options.io_threads == 4);
+    CHECK(couchbase::core::utils::parse_connection_string(
+            "couchbase://127.0.0.1?query_cache_capacity=100")
+            .options.query_cache_capacity == 100);
+    auto coalescing = couchbase::core::utils::parse_connection_string(
+      "couchbase://127.0.0.1?key_value_write_coalescing_delay=50us&"
+      "key_value_write_coalescing_threshold=16384");
+    CHECK(coalescing.options.key_value_write_coalescing_delay == std::chrono::microseconds(50));
+    CHECK(coalescing.options.key_value_write_coalescing_threshold == 16384);
+    CHECK(couchbase::core::utils::parse_connection_string(
+            "couchbase://127.0.0.1?key_value_write_coalescing_delay=100")
+            .options.key_value_write_coalescing_delay == std::chrono::microseconds(100));
+    CHECK(couchbase::core::utils::parse_connection_string(
+            "couchbase://127.0.0.1?num_kv_connections=4")
+            .options.num_kv_connections == 4);
+    CHECK(couchbase::core::utils::parse_connection_string(
+            "couchbase://127.0.0.1?tls_session_resumption=false")
+            .options.tls_session_resumption == false);
+    auto compression = couchbase::core::utils::parse_connection_string(
+      "couchbase://127.0.0.1?compression_min_size=1024&compression_min_ratio=0.5");
+    CHECK(compression.options.compression_min_size == 1024);
+    CHECK(compression.options.compression_min_ratio == 0.5);
 
     SECTION("parameters")
     {
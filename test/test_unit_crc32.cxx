@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/utils/crc32.hxx"
+
+#include <random>
+#include <string>
+
+TEST_CASE("unit: crc32 matches the check value of CRC-32/ISO-HDLC", "[unit]")
+{
+  const std::string input{ "123456789" };
+
+  REQUIRE(couchbase::core::utils::detail::crc32_bytewise(input.data(), input.size()) ==
+          0xcbf43926);
+  REQUIRE(couchbase::core::utils::detail::crc32_slice_by_8(input.data(), input.size()) ==
+          0xcbf43926);
+  REQUIRE(couchbase::core::utils::crc32(input.data(), input.size()) == 0xcbf43926);
+  if (couchbase::core::utils::detail::crc32_hardware_supported()) {
+    REQUIRE(couchbase::core::utils::detail::crc32_hardware(input.data(), input.size()) ==
+            0xcbf43926);
+  }
+}
+
+TEST_CASE("unit: all crc32 implementations produce identical checksums", "[unit]")
+{
+  std::mt19937 gen{ 42 };
+  std::string buffer(512, '\0');
+  for (auto& c : buffer) {
+    c = static_cast<char>(gen());
+  }
+
+  // every length up to the buffer size at every alignment within the 8-byte block
+  for (std::size_t offset = 0; offset < 8; ++offset) {
+    for (std::size_t size = 0; size + offset <= buffer.size(); ++size) {
+      const char* data = buffer.data() + offset;
+      const auto expected = couchbase::core::utils::detail::crc32_bytewise(data, size);
+      REQUIRE(couchbase::core::utils::detail::crc32_slice_by_8(data, size) == expected);
+      REQUIRE(couchbase::core::utils::crc32(data, size) == expected);
+      if (couchbase::core::utils::detail::crc32_hardware_supported()) {
+        REQUIRE(couchbase::core::utils::detail::crc32_hardware(data, size) == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("unit: vbucket hash is stable", "[unit]")
+{
+  // values computed with the byte-at-a-time implementation, that was used before
+  REQUIRE(couchbase::core::utils::hash_crc32("", 0) == 0);
+  REQUIRE(couchbase::core::utils::hash_crc32("foo", 3) % 1024 == 115);
+  REQUIRE(couchbase::core::utils::hash_crc32("123456789", 9) == 0x4bf4);
+}
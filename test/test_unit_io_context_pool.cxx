@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/io_context_pool.hxx"
+#include "core/io/timing_wheel.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+
+#include <atomic>
+#include <set>
+
+TEST_CASE("unit: io_context_pool spreads timing wheels across contexts", "[unit]")
+{
+  asio::io_context primary{};
+  couchbase::core::io::io_context_pool pool{ primary };
+  pool.start(3);
+  REQUIRE(pool.size() == 3);
+
+  std::set<asio::io_context*> contexts{};
+  for (std::size_t i = 0; i < 6; ++i) {
+    auto& wheel = pool.next_timing_wheel();
+    contexts.insert(&wheel.get_io_context());
+  }
+  REQUIRE(contexts.size() == 3);
+  REQUIRE(contexts.count(&primary) == 1);
+
+  pool.stop();
+  // after stop, everything goes to the primary context
+  REQUIRE(&pool.next_timing_wheel().get_io_context() == &primary);
+}
+
+TEST_CASE("unit: io_context_pool runs queued handlers before stopping", "[unit]")
+{
+  asio::io_context primary{};
+  couchbase::core::io::io_context_pool pool{ primary };
+  pool.start(2);
+
+  std::atomic_int invoked{ 0 };
+  for (int i = 0; i < 100; ++i) {
+    auto& ctx = pool.next();
+    if (&ctx == &primary) {
+      continue;
+    }
+    asio::post(ctx, [&invoked]() {
+      ++invoked;
+    });
+  }
+  pool.stop();
+
+  REQUIRE(invoked == 50);
+}
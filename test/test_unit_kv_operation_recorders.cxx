@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/metrics/kv_operation_recorders.hxx"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+class counting_value_recorder : public couchbase::metrics::value_recorder
+{
+public:
+  void record_value(std::int64_t value) override
+  {
+    values.push_back(value);
+  }
+
+  std::vector<std::int64_t> values{};
+};
+
+class counting_meter : public couchbase::metrics::meter
+{
+public:
+  auto get_value_recorder(const std::string& name, const std::map<std::string, std::string>& tags)
+    -> std::shared_ptr<couchbase::metrics::value_recorder> override
+  {
+    const std::scoped_lock lock(mutex_);
+    requests.emplace_back(name, tags);
+    auto& recorder = recorders[tags.at("db.operation")];
+    if (recorder == nullptr) {
+      recorder = std::make_shared<counting_value_recorder>();
+    }
+    return recorder;
+  }
+
+  std::vector<std::pair<std::string, std::map<std::string, std::string>>> requests{};
+  std::map<std::string, std::shared_ptr<counting_value_recorder>> recorders{};
+
+private:
+  std::mutex mutex_{};
+};
+} // namespace
+
+TEST_CASE("unit: KV operation recorders are resolved once per opcode", "[unit]")
+{
+  auto meter = std::make_shared<counting_meter>();
+  couchbase::core::metrics::kv_operation_recorders recorders{ meter };
+
+  recorders.recorder_for(couchbase::core::protocol::client_opcode::get).record_value(1);
+  recorders.recorder_for(couchbase::core::protocol::client_opcode::upsert).record_value(2);
+  recorders.recorder_for(couchbase::core::protocol::client_opcode::get).record_value(3);
+
+  REQUIRE(meter->requests.size() == 2);
+  REQUIRE(meter->requests[0].first == "db.couchbase.operations");
+  REQUIRE(meter->requests[0].second.at("db.couchbase.service") == "kv");
+  REQUIRE(meter->requests[0].second.at("db.operation").find("get") == 0);
+  REQUIRE(meter->requests[1].second.at("db.operation").find("upsert") == 0);
+
+  auto get_recorder = meter->recorders[meter->requests[0].second.at("db.operation")];
+  REQUIRE(get_recorder->values == std::vector<std::int64_t>{ 1, 3 });
+}
+
+TEST_CASE("unit: KV operation recorders work without meter", "[unit]")
+{
+  couchbase::core::metrics::kv_operation_recorders recorders{ nullptr };
+  auto& recorder = recorders.recorder_for(couchbase::core::protocol::client_opcode::get);
+  recorder.record_value(42);
+  REQUIRE(&recorder == &recorders.recorder_for(couchbase::core::protocol::client_opcode::get));
+}
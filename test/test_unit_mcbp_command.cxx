@@ -0,0 +1,182 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/mcbp_command.hxx"
+#include "core/metrics/noop_meter.hxx"
+#include "core/operations/document_get.hxx"
+#include "core/protocol/value_compressor.hxx"
+#include "core/tracing/noop_tracer.hxx"
+
+#include <couchbase/best_effort_retry_strategy.hxx>
+
+#include <asio/dispatch.hpp>
+#include <asio/io_context.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * Implements the part of the bucket interface, that mcbp_command uses.
+ */
+class fake_manager
+{
+public:
+  using command_type = couchbase::core::operations::
+    mcbp_command<fake_manager, couchbase::core::operations::get_request>;
+
+  [[nodiscard]] auto next_command_id() -> std::uint64_t
+  {
+    return ++command_id_;
+  }
+
+  [[nodiscard]] auto log_prefix() const -> const std::string&
+  {
+    return log_prefix_;
+  }
+
+  [[nodiscard]] auto tracer() const -> std::shared_ptr<couchbase::tracing::request_tracer>
+  {
+    return tracer_;
+  }
+
+  [[nodiscard]] auto operation_recorder(couchbase::core::protocol::client_opcode /* opcode */)
+    const -> couchbase::metrics::value_recorder&
+  {
+    return *recorder_;
+  }
+
+  [[nodiscard]] auto compressor() -> couchbase::core::protocol::value_compressor&
+  {
+    return compressor_;
+  }
+
+  [[nodiscard]] auto default_retry_strategy() const
+    -> std::shared_ptr<couchbase::retry_strategy>
+  {
+    return couchbase::make_best_effort_retry_strategy();
+  }
+
+  void fetch_config()
+  {
+    ++config_requests;
+  }
+
+  void map_and_send(std::shared_ptr<command_type> /* cmd */)
+  {
+    ++dispatched;
+  }
+
+  void schedule_for_retry(std::shared_ptr<command_type> /* cmd */,
+                          std::chrono::milliseconds /* duration */)
+  {
+    ++retried;
+  }
+
+  int config_requests{ 0 };
+  int dispatched{ 0 };
+  int retried{ 0 };
+
+private:
+  std::uint64_t command_id_{ 0 };
+  std::string log_prefix_{ "[fake]" };
+  std::shared_ptr<couchbase::tracing::request_tracer> tracer_{
+    std::make_shared<couchbase::core::tracing::noop_tracer>()
+  };
+  std::shared_ptr<couchbase::metrics::value_recorder> recorder_{
+    std::make_shared<couchbase::core::metrics::noop_value_recorder>()
+  };
+  couchbase::core::protocol::value_compressor compressor_{};
+};
+
+auto
+make_request() -> couchbase::core::operations::get_request
+{
+  couchbase::core::operations::get_request request{};
+  request.id = couchbase::core::document_id{ "default", "_default", "_default", "foo" };
+  return request;
+}
+} // namespace
+
+TEST_CASE("unit: mcbp_command ignores response posted before the deadline completed it", "[unit]")
+{
+  asio::io_context io{};
+  auto& wheel = asio::use_service<couchbase::core::io::timing_wheel>(io);
+  auto manager = std::make_shared<fake_manager>();
+
+  auto cmd = std::make_shared<fake_manager::command_type>(
+    wheel, manager, make_request(), std::chrono::milliseconds{ 1'000 });
+
+  std::vector<std::error_code> completions{};
+  cmd->start([&completions](std::error_code ec,
+                            std::optional<couchbase::core::io::mcbp_message>&& /* msg */) {
+    completions.push_back(ec);
+  });
+
+  // the session thread hands the response over to the IO context of the command, which is not
+  // running on this thread, so the handler is queued
+  asio::dispatch(cmd->context(), [cmd]() mutable {
+    cmd->on_response(asio::error::operation_aborted,
+                     couchbase::retry_reason::do_not_retry,
+                     couchbase::core::io::mcbp_message{});
+  });
+
+  // the deadline fires before the queued response
+  cmd->on_deadline();
+  REQUIRE(completions.size() == 1);
+  REQUIRE(completions.front() == couchbase::errc::common::unambiguous_timeout);
+
+  io.run();
+
+  REQUIRE(completions.size() == 1);
+  REQUIRE(manager->retried == 0);
+  REQUIRE(manager->dispatched == 0);
+  REQUIRE(manager->config_requests == 0);
+  REQUIRE(wheel.size() == 0);
+}
+
+TEST_CASE("unit: mcbp_command ignores collection id response posted after the deadline", "[unit]")
+{
+  asio::io_context io{};
+  auto& wheel = asio::use_service<couchbase::core::io::timing_wheel>(io);
+  auto manager = std::make_shared<fake_manager>();
+
+  auto cmd = std::make_shared<fake_manager::command_type>(
+    wheel, manager, make_request(), std::chrono::milliseconds{ 1'000 });
+
+  std::vector<std::error_code> completions{};
+  cmd->start([&completions](std::error_code ec,
+                            std::optional<couchbase::core::io::mcbp_message>&& /* msg */) {
+    completions.push_back(ec);
+  });
+
+  asio::dispatch(cmd->context(), [cmd]() mutable {
+    cmd->on_collection_id_response(couchbase::errc::common::collection_not_found,
+                                   couchbase::core::io::mcbp_message{});
+  });
+
+  cmd->on_deadline();
+  io.run();
+
+  REQUIRE(completions.size() == 1);
+  REQUIRE(completions.front() == couchbase::errc::common::unambiguous_timeout);
+  REQUIRE(wheel.size() == 0);
+}
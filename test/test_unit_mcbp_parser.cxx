@@ -0,0 +1,298 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/mcbp_parser.hxx"
+#include "core/protocol/client_response.hxx"
+#include "core/protocol/cmd_get.hxx"
+#include "core/protocol/datatype.hxx"
+#include "core/utils/byteswap.hxx"
+
+#include <snappy.h>
+
+#include <string>
+
+namespace
+{
+auto
+make_get_response(std::uint32_t opaque,
+                  const std::string& value,
+                  std::uint8_t datatype = 0,
+                  std::uint8_t opcode = 0x00) -> std::vector<std::byte>
+{
+  const std::uint8_t extlen = 4;
+  const auto bodylen = static_cast<std::uint32_t>(extlen + value.size());
+
+  couchbase::core::io::binary_header header{};
+  header.magic = 0x81;
+  header.opcode = opcode;
+  header.extlen = extlen;
+  header.datatype = datatype;
+  header.bodylen = couchbase::core::utils::byte_swap(bodylen);
+  header.opaque = couchbase::core::utils::byte_swap(opaque);
+
+  std::vector<std::byte> frame(sizeof(header) + bodylen);
+  std::memcpy(frame.data(), &header, sizeof(header));
+  std::memcpy(frame.data() + sizeof(header) + extlen, value.data(), value.size());
+  return frame;
+}
+
+auto
+body_value(const couchbase::core::io::mcbp_message& msg) -> std::string
+{
+  if (msg.value) {
+    return { reinterpret_cast<const char*>(msg.value->data()), msg.value->size() };
+  }
+  return { reinterpret_cast<const char*>(msg.body.data()) + msg.header.extlen,
+           msg.body.size() - msg.header.extlen };
+}
+} // namespace
+
+TEST_CASE("unit: mcbp parser decodes pipelined frames", "[unit]")
+{
+  std::vector<std::byte> input;
+  for (std::uint32_t opaque = 1; opaque <= 10; ++opaque) {
+    auto frame = make_get_response(opaque, "value-" + std::to_string(opaque));
+    input.insert(input.end(), frame.begin(), frame.end());
+  }
+
+  couchbase::core::io::mcbp_parser parser;
+  parser.feed(input.begin(), input.end());
+  for (std::uint32_t opaque = 1; opaque <= 10; ++opaque) {
+    couchbase::core::io::mcbp_message msg{};
+    REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+    REQUIRE(couchbase::core::utils::byte_swap(msg.header.opaque) == opaque);
+    REQUIRE(body_value(msg) == "value-" + std::to_string(opaque));
+  }
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::need_data);
+  REQUIRE(parser.pending_bytes() == 0);
+}
+
+TEST_CASE("unit: mcbp parser handles frames split between reads", "[unit]")
+{
+  std::vector<std::byte> input;
+  for (std::uint32_t opaque = 1; opaque <= 3; ++opaque) {
+    auto frame = make_get_response(opaque, std::string(100, static_cast<char>('a' + opaque)));
+    input.insert(input.end(), frame.begin(), frame.end());
+  }
+
+  for (std::size_t chunk_size : { 1, 7, 24, 50, 128 }) {
+    couchbase::core::io::mcbp_parser parser;
+    std::uint32_t expected_opaque = 1;
+    for (std::size_t pos = 0; pos < input.size(); pos += chunk_size) {
+      auto end = std::min(pos + chunk_size, input.size());
+      parser.feed(input.begin() + static_cast<std::ptrdiff_t>(pos),
+                  input.begin() + static_cast<std::ptrdiff_t>(end));
+      for (;;) {
+        couchbase::core::io::mcbp_message msg{};
+        if (parser.next(msg) != couchbase::core::io::mcbp_parser::result::ok) {
+          break;
+        }
+        REQUIRE(couchbase::core::utils::byte_swap(msg.header.opaque) == expected_opaque);
+        REQUIRE(body_value(msg) == std::string(100, static_cast<char>('a' + expected_opaque)));
+        ++expected_opaque;
+      }
+    }
+    REQUIRE(expected_opaque == 4);
+    REQUIRE(parser.pending_bytes() == 0);
+  }
+}
+
+TEST_CASE("unit: mcbp parser decompresses snappy values", "[unit]")
+{
+  const std::string value(1024, 'x');
+  std::string compressed;
+  snappy::Compress(value.data(), value.size(), &compressed);
+
+  auto frame = make_get_response(
+    42, compressed, static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy));
+
+  couchbase::core::io::mcbp_parser parser;
+  parser.feed(frame.begin(), frame.end());
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+  REQUIRE(couchbase::core::utils::byte_swap(msg.header.bodylen) == 4 + value.size());
+  REQUIRE(body_value(msg) == value);
+}
+
+TEST_CASE("unit: mcbp parser drops buffer on invalid magic", "[unit]")
+{
+  auto input = make_get_response(1, "value");
+  input.push_back(std::byte{ 0xff });
+  input.resize(input.size() + 30);
+
+  couchbase::core::io::mcbp_parser parser;
+  parser.feed(input.begin(), input.end());
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+  REQUIRE(body_value(msg) == "value");
+  REQUIRE(parser.pending_bytes() == 0);
+}
+
+TEST_CASE("unit: mcbp parser receives large values directly into the message", "[unit]")
+{
+  const std::string value(couchbase::core::io::mcbp_parser::direct_body_threshold * 4, 'z');
+  auto input = make_get_response(1, value);
+  auto next_frame = make_get_response(2, "next");
+  input.insert(input.end(), next_frame.begin(), next_frame.end());
+
+  couchbase::core::io::mcbp_parser parser;
+  REQUIRE(parser.body_receive_buffer().empty());
+
+  // the first read contains only the beginning of the frame
+  std::size_t position = 16384;
+  parser.feed(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(position));
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::need_data);
+
+  auto window = parser.body_receive_buffer();
+  REQUIRE_FALSE(window.empty());
+  // extras have been left in the body, the window points into the separate value
+  const std::byte* value_start = window.data() - (position - sizeof(msg.header) - 4);
+
+  // the socket writes into the body of the message
+  while (!parser.body_receive_buffer().empty()) {
+    window = parser.body_receive_buffer();
+    auto size = std::min<std::size_t>(window.size(), 65536);
+    std::memcpy(window.data(), input.data() + position, size);
+    parser.commit_body(size);
+    position += size;
+  }
+  // the rest is fed as usual
+  parser.feed(input.begin() + static_cast<std::ptrdiff_t>(position), input.end());
+
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+  REQUIRE(couchbase::core::utils::byte_swap(msg.header.opaque) == 1);
+  REQUIRE(msg.body.size() == 4);
+  REQUIRE(msg.value.has_value());
+  REQUIRE(msg.value->data() == value_start);
+  REQUIRE(body_value(msg) == value);
+
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+  REQUIRE(couchbase::core::utils::byte_swap(msg.header.opaque) == 2);
+  REQUIRE(body_value(msg) == "next");
+  REQUIRE(parser.pending_bytes() == 0);
+}
+
+TEST_CASE("unit: mcbp parser keeps large frames without document value whole", "[unit]")
+{
+  // lookup_in response carries sub-document results, that are parsed from the whole body
+  const std::string value(couchbase::core::io::mcbp_parser::direct_body_threshold * 2, 'l');
+  auto input = make_get_response(1, value, 0, 0xd0);
+
+  couchbase::core::io::mcbp_parser parser;
+  parser.feed(input.begin(), input.begin() + 1024);
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::need_data);
+  auto window = parser.body_receive_buffer();
+  REQUIRE(window.size() == input.size() - 1024);
+  std::memcpy(window.data(), input.data() + 1024, window.size());
+  parser.commit_body(window.size());
+
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+  REQUIRE_FALSE(msg.value.has_value());
+  REQUIRE(msg.body.size() == 4 + value.size());
+  REQUIRE(body_value(msg) == value);
+}
+
+TEST_CASE("unit: mcbp parser rejects corrupted header of large frame", "[unit]")
+{
+  const std::string value(1024, 'c');
+  auto input = make_get_response(1, value);
+
+  SECTION("body is larger than any document")
+  {
+    const auto bodylen = static_cast<std::uint32_t>(0xfffffff0);
+    std::memcpy(input.data() + 8, &bodylen, sizeof(bodylen));
+  }
+
+  SECTION("invalid magic")
+  {
+    const auto bodylen = couchbase::core::utils::byte_swap(
+      static_cast<std::uint32_t>(couchbase::core::io::mcbp_parser::direct_body_threshold));
+    std::memcpy(input.data() + 8, &bodylen, sizeof(bodylen));
+    input[0] = std::byte{ 0x42 };
+  }
+
+  SECTION("invalid opcode")
+  {
+    const auto bodylen = couchbase::core::utils::byte_swap(
+      static_cast<std::uint32_t>(couchbase::core::io::mcbp_parser::direct_body_threshold));
+    std::memcpy(input.data() + 8, &bodylen, sizeof(bodylen));
+    input[1] = std::byte{ 0xee };
+  }
+
+  couchbase::core::io::mcbp_parser parser;
+  parser.feed(input.begin(), input.end());
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::failure);
+  REQUIRE(parser.body_receive_buffer().empty());
+  REQUIRE(parser.pending_bytes() == 0);
+}
+
+TEST_CASE("unit: mcbp parser uncompresses large values separately", "[unit]")
+{
+  const std::string value(couchbase::core::io::mcbp_parser::direct_body_threshold * 2, 'x');
+  std::string compressed;
+  snappy::Compress(value.data(), value.size(), &compressed);
+  auto frame = make_get_response(
+    1, compressed, static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy));
+
+  couchbase::core::io::mcbp_parser parser;
+  parser.feed(frame.begin(), frame.end());
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+  REQUIRE(msg.body.size() == 4);
+  REQUIRE(msg.value.has_value());
+  REQUIRE(body_value(msg) == value);
+  REQUIRE(couchbase::core::utils::byte_swap(msg.header.bodylen) == 4 + value.size());
+}
+
+TEST_CASE("unit: get response adopts separately received value", "[unit]")
+{
+  const std::string value(couchbase::core::io::mcbp_parser::direct_body_threshold * 2, 'v');
+  auto input = make_get_response(1, value);
+
+  couchbase::core::io::mcbp_parser parser;
+  parser.feed(input.begin(), input.begin() + 1024);
+  couchbase::core::io::mcbp_message msg{};
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::need_data);
+  auto window = parser.body_receive_buffer();
+  std::memcpy(window.data(), input.data() + 1024, window.size());
+  parser.commit_body(window.size());
+  REQUIRE(parser.next(msg) == couchbase::core::io::mcbp_parser::result::ok);
+  const std::byte* received = msg.value->data();
+
+  {
+    couchbase::core::io::mcbp_message copy{};
+    copy.header = msg.header;
+    copy.body = msg.body;
+    copy.value = msg.value;
+    // the consumers of the whole frame see the value behind the extras
+    copy.join_value();
+    REQUIRE_FALSE(copy.value.has_value());
+    REQUIRE(body_value(copy) == value);
+  }
+
+  couchbase::core::protocol::client_response<couchbase::core::protocol::get_response_body> resp(
+    std::move(msg));
+  REQUIRE(resp.status() == couchbase::core::key_value_status_code::success);
+  REQUIRE(resp.body().value().data() == received);
+  REQUIRE(resp.body().value().size() == value.size());
+}
@@ -0,0 +1,131 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/opaque_table.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <thread>
+
+using handler_type = couchbase::core::utils::movable_function<void(std::uint32_t)>;
+
+TEST_CASE("unit: opaque table returns handler only once", "[unit]")
+{
+  couchbase::core::io::opaque_table<handler_type> table{ 8 };
+
+  std::uint32_t invoked_with{ 0 };
+  table.insert(42, [&invoked_with](std::uint32_t opaque) {
+    invoked_with = opaque;
+  });
+
+  REQUIRE_FALSE(table.take(43));
+  auto handler = table.take(42);
+  REQUIRE(handler);
+  handler(42);
+  REQUIRE(invoked_with == 42);
+  REQUIRE_FALSE(table.take(42));
+}
+
+TEST_CASE("unit: opaque table keeps colliding opaques in overflow", "[unit]")
+{
+  couchbase::core::io::opaque_table<handler_type> table{ 4 };
+
+  std::vector<std::uint32_t> invoked{};
+  for (std::uint32_t opaque = 1; opaque <= 10; ++opaque) {
+    table.insert(opaque, [&invoked](std::uint32_t o) {
+      invoked.push_back(o);
+    });
+  }
+
+  // opaques 5 and 9 share the slot with 1
+  table.take(9)(9);
+  table.take(1)(1);
+  table.take(5)(5);
+  REQUIRE(invoked == std::vector<std::uint32_t>{ 9, 1, 5 });
+  REQUIRE_FALSE(table.take(5));
+
+  // the slot is free again
+  table.insert(13, [&invoked](std::uint32_t o) {
+    invoked.push_back(o);
+  });
+
+  invoked.clear();
+  for (auto& [opaque, handler] : table.take_all()) {
+    handler(opaque);
+  }
+  REQUIRE(invoked == std::vector<std::uint32_t>{ 2, 3, 4, 6, 7, 8, 10, 13 });
+  REQUIRE(table.take_all().empty());
+}
+
+TEST_CASE("unit: opaque table rejects second handler for the same opaque", "[unit]")
+{
+  couchbase::core::io::opaque_table<handler_type> table{ 4 };
+
+  std::vector<std::uint32_t> invoked{};
+  REQUIRE(table.insert(1, [&invoked](std::uint32_t /* opaque */) {
+    invoked.push_back(1);
+  }));
+  REQUIRE(table.insert(5, [&invoked](std::uint32_t /* opaque */) {
+    invoked.push_back(5);
+  }));
+
+  // the slot is held by the opaque
+  handler_type duplicate = [&invoked](std::uint32_t /* opaque */) {
+    invoked.push_back(0);
+  };
+  REQUIRE_FALSE(table.insert(1, std::move(duplicate)));
+  // the opaque is in the overflow map
+  REQUIRE_FALSE(table.insert(5, [&invoked](std::uint32_t /* opaque */) {
+    invoked.push_back(0);
+  }));
+  // the rejected handler still belongs to the caller
+  REQUIRE(duplicate);
+
+  for (auto& [opaque, handler] : table.take_all()) {
+    handler(opaque);
+  }
+  REQUIRE(invoked == std::vector<std::uint32_t>{ 1, 5 });
+}
+
+TEST_CASE("unit: opaque table hands handler to exactly one of concurrent takers", "[unit]")
+{
+  static constexpr std::uint32_t number_of_operations{ 10'000 };
+  couchbase::core::io::opaque_table<handler_type> table{};
+
+  std::atomic<std::uint32_t> invocations{ 0 };
+  for (std::uint32_t opaque = 0; opaque < number_of_operations; ++opaque) {
+    table.insert(opaque, [&invocations](std::uint32_t /* opaque */) {
+      ++invocations;
+    });
+  }
+
+  auto taker = [&table]() {
+    for (std::uint32_t opaque = 0; opaque < number_of_operations; ++opaque) {
+      if (auto handler = table.take(opaque); handler) {
+        handler(opaque);
+      }
+    }
+  };
+  std::thread first(taker);
+  std::thread second(taker);
+  first.join();
+  second.join();
+
+  REQUIRE(invocations == number_of_operations);
+  REQUIRE(table.take_all().empty());
+}
@@ -21,6 +21,9 @@
 
 #include "core/operations/document_query.hxx"
 
+#include <string>
+#include <vector>
+
 couchbase::core::http_context
 make_http_context(couchbase::core::topology::configuration& config)
 {
@@ -73,3 +76,65 @@ TEST_CASE("unit: query with read from replica", "[unit]")
     REQUIRE_FALSE(body.get_object().count("use_replica"));
   }
 }
+
+TEST_CASE("unit: query keeps row callback when request is encoded again", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  auto ctx = make_http_context(config);
+
+  std::vector<std::string> rows{};
+  couchbase::core::operations::query_request req{};
+  req.statement = "SELECT 1";
+  req.row_callback = [&rows](std::string row) {
+    rows.emplace_back(std::move(row));
+    return couchbase::core::utils::json::stream_control::next_row;
+  };
+
+  // the request is encoded once more, when the HTTP command retries it
+  for (const auto* row : { "1", "2" }) {
+    couchbase::core::io::http_request http_req;
+    auto ec = req.encode_to(http_req, ctx);
+    REQUIRE_SUCCESS(ec);
+    REQUIRE(http_req.streaming.has_value());
+    REQUIRE(http_req.streaming->pointer_expression == "/results/^");
+    REQUIRE(http_req.streaming->row_handler);
+    http_req.streaming->row_handler(row);
+  }
+  REQUIRE(rows == std::vector<std::string>{ "1", "2" });
+}
+
+TEST_CASE("unit: query does not stream rows of legacy PREPARE", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  auto ctx = make_http_context(config);
+
+  couchbase::core::operations::query_request req{};
+  req.statement = "SELECT 'legacy prepare streaming'";
+  req.adhoc = false;
+  req.row_callback = [](std::string /* row */) {
+    return couchbase::core::utils::json::stream_control::next_row;
+  };
+
+  SECTION("plan is not cached yet")
+  {
+    couchbase::core::io::http_request http_req;
+    auto ec = req.encode_to(http_req, ctx);
+    REQUIRE_SUCCESS(ec);
+    auto body = couchbase::core::utils::json::parse(http_req.body);
+    REQUIRE(body.get_object().at("statement").get_string() == "PREPARE " + req.statement);
+    REQUIRE_FALSE(body.get_object().count("auto_execute"));
+    // the plan row has to end up in response.rows
+    REQUIRE_FALSE(http_req.streaming.has_value());
+  }
+
+  SECTION("plan is cached")
+  {
+    ctx.cache.put(req.statement, "p1", "encoded-plan");
+    couchbase::core::io::http_request http_req;
+    auto ec = req.encode_to(http_req, ctx);
+    REQUIRE_SUCCESS(ec);
+    auto body = couchbase::core::utils::json::parse(http_req.body);
+    REQUIRE(body.get_object().at("prepared").get_string() == "p1");
+    REQUIRE(http_req.streaming.has_value());
+  }
+}
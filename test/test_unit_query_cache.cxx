@@ -0,0 +1,186 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/query_cache.hxx"
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+class counting_recorder : public couchbase::metrics::value_recorder
+{
+public:
+  void record_value(std::int64_t value) override
+  {
+    total_ += value;
+  }
+
+  [[nodiscard]] auto total() const -> std::int64_t
+  {
+    return total_;
+  }
+
+private:
+  std::atomic_int64_t total_{ 0 };
+};
+
+class counting_meter : public couchbase::metrics::meter
+{
+public:
+  auto get_value_recorder(const std::string& name, const std::map<std::string, std::string>& tags)
+    -> std::shared_ptr<couchbase::metrics::value_recorder> override
+  {
+    auto& recorder = recorders_[name + ":" + tags.at("outcome")];
+    if (recorder == nullptr) {
+      recorder = std::make_shared<counting_recorder>();
+    }
+    return recorder;
+  }
+
+  [[nodiscard]] auto total(const std::string& outcome) const -> std::int64_t
+  {
+    if (auto it = recorders_.find("db.couchbase.query_cache:" + outcome); it != recorders_.end()) {
+      return it->second->total();
+    }
+    return 0;
+  }
+
+private:
+  std::map<std::string, std::shared_ptr<counting_recorder>> recorders_{};
+};
+} // namespace
+
+TEST_CASE("unit: query cache stores prepared statements", "[unit]")
+{
+  couchbase::core::query_cache cache{};
+
+  REQUIRE(cache.capacity() == couchbase::core::query_cache::default_capacity);
+  REQUIRE_FALSE(cache.get("SELECT 1").has_value());
+
+  cache.put("SELECT 1", "p1");
+  cache.put("SELECT 2", "p2", "plan2");
+  cache.put("SELECT 1", "other");
+
+  auto first = cache.get("SELECT 1");
+  REQUIRE(first.has_value());
+  REQUIRE(first->name == "p1");
+  REQUIRE_FALSE(first->plan.has_value());
+
+  auto second = cache.get("SELECT 2");
+  REQUIRE(second.has_value());
+  REQUIRE(second->name == "p2");
+  REQUIRE(second->plan == "plan2");
+
+  cache.erase("SELECT 1");
+  REQUIRE_FALSE(cache.get("SELECT 1").has_value());
+
+  auto stats = cache.stats();
+  REQUIRE(stats.hits == 2);
+  REQUIRE(stats.misses == 2);
+  REQUIRE(stats.evictions == 0);
+  REQUIRE(stats.size == 1);
+}
+
+TEST_CASE("unit: query cache evicts least recently used statements", "[unit]")
+{
+  couchbase::core::query_cache cache{ 160 };
+  REQUIRE(cache.capacity() == 160);
+
+  std::vector<std::string> statements{};
+  for (int i = 0; i < 1'000; ++i) {
+    statements.emplace_back("SELECT " + std::to_string(i));
+  }
+
+  cache.put(statements[0], "hot");
+  for (std::size_t i = 1; i < statements.size(); ++i) {
+    cache.put(statements[i], "cold");
+    // keep the first statement at the head of its shard
+    REQUIRE(cache.get(statements[0]).has_value());
+  }
+
+  auto stats = cache.stats();
+  REQUIRE(stats.size <= 160);
+  REQUIRE(stats.evictions == statements.size() - stats.size);
+  REQUIRE(cache.get(statements[0])->name == "hot");
+  REQUIRE(cache.get(statements.back()).has_value());
+
+  cache.set_capacity(16);
+  for (std::size_t i = 0; i < statements.size(); ++i) {
+    cache.put(statements[i], "trim");
+  }
+  REQUIRE(cache.stats().size <= 16);
+}
+
+TEST_CASE("unit: query cache reports hits, misses and evictions to the meter", "[unit]")
+{
+  auto meter = std::make_shared<counting_meter>();
+  couchbase::core::query_cache cache{ 1 };
+  cache.set_meter(meter);
+
+  for (int i = 0; i < 100; ++i) {
+    cache.put("SELECT " + std::to_string(i), "p");
+  }
+  for (int i = 0; i < 100; ++i) {
+    std::ignore = cache.get("SELECT " + std::to_string(i));
+  }
+
+  auto stats = cache.stats();
+  REQUIRE(stats.size <= 1);
+  REQUIRE(stats.hits + stats.misses == 100);
+  REQUIRE(stats.hits == stats.size);
+  REQUIRE(stats.evictions == 100 - stats.size);
+  REQUIRE(meter->total("hit") == static_cast<std::int64_t>(stats.hits));
+  REQUIRE(meter->total("miss") == static_cast<std::int64_t>(stats.misses));
+  REQUIRE(meter->total("eviction") == static_cast<std::int64_t>(stats.evictions));
+}
+
+TEST_CASE("unit: query cache can be used from multiple threads", "[unit]")
+{
+  couchbase::core::query_cache cache{ 64 };
+
+  std::atomic_int failures{ 0 };
+  std::vector<std::thread> threads{};
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&cache, &failures, t]() {
+      for (int i = 0; i < 5'000; ++i) {
+        auto statement = "SELECT " + std::to_string((i * 7 + t) % 256);
+        if (auto entry = cache.get(statement); entry) {
+          if (entry->name != statement) {
+            failures.fetch_add(1);
+          }
+        } else {
+          cache.put(statement, statement);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(failures == 0);
+  auto stats = cache.stats();
+  REQUIRE(stats.hits + stats.misses == 8 * 5'000);
+  REQUIRE(stats.size <= 64);
+}
@@ -0,0 +1,199 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/topology/configuration.hxx"
+#include "core/topology/routing_table.hxx"
+#include "core/utils/rcu_cell.hxx"
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+auto
+make_configuration(std::int64_t rev, std::size_t number_of_vbuckets)
+  -> couchbase::core::topology::configuration
+{
+  couchbase::core::topology::configuration config{};
+  config.epoch = 1;
+  config.rev = rev;
+  config.num_replicas = 1;
+  couchbase::core::topology::configuration::vbucket_map vbmap(number_of_vbuckets);
+  for (std::size_t vbucket = 0; vbucket < number_of_vbuckets; ++vbucket) {
+    vbmap[vbucket] = {
+      static_cast<std::int16_t>(vbucket % 3),
+      static_cast<std::int16_t>(vbucket % 5 == 0 ? -1 : (vbucket + 1) % 3),
+    };
+  }
+  config.vbmap = vbmap;
+  return config;
+}
+} // namespace
+
+TEST_CASE("unit: routing table maps keys the same way as configuration", "[unit]")
+{
+  const auto config = make_configuration(42, 1024);
+  const std::map<std::size_t, std::string> sessions{ { 0, "a" }, { 1, "b" }, { 2, "c" } };
+  const couchbase::core::topology::routing_table<std::string> table{ config, sessions };
+
+  REQUIRE(table.rev_str() == config.rev_str());
+  REQUIRE(table.number_of_sessions() == 3);
+
+  for (std::size_t i = 0; i < 10'000; ++i) {
+    const auto key = "key_" + std::to_string(i);
+    for (std::size_t replica = 0; replica < 2; ++replica) {
+      REQUIRE(table.map_key(key, replica) == config.map_key(key, replica));
+    }
+  }
+  for (std::uint16_t vbucket = 0; vbucket < 1024; ++vbucket) {
+    REQUIRE(table.server_by_vbucket(vbucket, 0) == config.server_by_vbucket(vbucket, 0));
+    REQUIRE(table.server_by_vbucket(vbucket, 1) == config.server_by_vbucket(vbucket, 1));
+  }
+
+  REQUIRE_FALSE(table.server_by_vbucket(1024, 0).has_value());
+  REQUIRE_FALSE(table.server_by_vbucket(0, 5).has_value());
+  REQUIRE(table.find_session(1) == "b");
+  REQUIRE_FALSE(table.find_session(3).has_value());
+}
+
+TEST_CASE("unit: routing table without configuration does not route", "[unit]")
+{
+  const couchbase::core::topology::routing_table<std::string> table{ std::nullopt, {} };
+
+  REQUIRE(table.rev_str() == "<no-config>");
+  REQUIRE(table.number_of_sessions() == 0);
+  REQUIRE(table.map_key(std::string{ "foo" }, 0) ==
+          std::pair<std::uint16_t, std::optional<std::size_t>>{ 0, {} });
+  REQUIRE_FALSE(table.find_session(0).has_value());
+}
+
+TEST_CASE("unit: routing table selects connection of the node by score", "[unit]")
+{
+  const auto config = make_configuration(1, 64);
+  const std::map<std::size_t, std::string> sessions{ { 0, "a" }, { 1, "b" }, { 2, "c" } };
+  const std::map<std::size_t, std::vector<std::string>> extra_sessions{
+    { 0, { "aa", "aaa" } },
+    { 2, { "cc" } },
+  };
+  const couchbase::core::topology::routing_table<std::string> table{ config,
+                                                                     sessions,
+                                                                     extra_sessions };
+
+  REQUIRE(table.number_of_sessions() == 3);
+  REQUIRE(table.find_session(0) == "a");
+  REQUIRE(table.find_sessions(0) == std::vector<std::string>{ "a", "aa", "aaa" });
+  REQUIRE(table.find_sessions(1) == std::vector<std::string>{ "b" });
+  REQUIRE(table.find_sessions(3).empty());
+
+  const std::map<std::string, std::size_t> load{
+    { "a", 300 }, { "aa", 100 }, { "aaa", 200 }, { "b", 10 }, { "c", 0 }, { "cc", 0 },
+  };
+  auto by_load = [&load](const std::string& session) {
+    return load.at(session);
+  };
+  REQUIRE(table.select_session(0, by_load) == "aa");
+  REQUIRE(table.select_session(1, by_load) == "b");
+  // the first connection wins the ties
+  REQUIRE(table.select_session(2, by_load) == "c");
+  REQUIRE_FALSE(table.select_session(3, by_load).has_value());
+}
+
+TEST_CASE("unit: rcu cell publishes and updates values", "[unit]")
+{
+  couchbase::core::utils::rcu_cell<std::map<std::string, int>> cell{};
+
+  REQUIRE(cell.read([](const auto* value) {
+    return value == nullptr;
+  }));
+
+  cell.update([](auto& value) {
+    value.try_emplace("foo", 1);
+  });
+  cell.update([](auto& value) {
+    value.try_emplace("bar", 2);
+  });
+  REQUIRE(cell.read([](const auto* value) {
+    return value->size();
+  }) == 2);
+
+  cell.publish(std::make_unique<const std::map<std::string, int>>());
+  REQUIRE(cell.read([](const auto* value) {
+    return value->empty();
+  }));
+}
+
+TEST_CASE("unit: rcu cell readers never observe retired values", "[unit]")
+{
+  struct value {
+    std::uint64_t version;
+    std::uint64_t check;
+    std::atomic_bool* destroyed;
+
+    value(std::uint64_t v, std::atomic_bool* d)
+      : version{ v }
+      , check{ ~v }
+      , destroyed{ d }
+    {
+    }
+    value(const value&) = delete;
+    value(value&&) = delete;
+    auto operator=(const value&) -> value& = delete;
+    auto operator=(value&&) -> value& = delete;
+    ~value()
+    {
+      check = 0;
+      destroyed->store(true);
+    }
+  };
+
+  constexpr std::uint64_t number_of_versions{ 2'000 };
+  std::vector<std::atomic_bool> destroyed(number_of_versions + 1);
+  couchbase::core::utils::rcu_cell<value> cell{};
+  cell.publish(std::make_unique<const value>(0, &destroyed[0]));
+
+  std::atomic_bool done{ false };
+  std::atomic_uint64_t failures{ 0 };
+  std::vector<std::thread> readers{};
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&cell, &done, &failures]() {
+      std::uint64_t last_seen{ 0 };
+      while (!done) {
+        cell.read([&failures, &last_seen](const value* v) {
+          if (v->check != ~v->version || v->destroyed->load() || v->version < last_seen) {
+            failures.fetch_add(1);
+          }
+          last_seen = v->version;
+        });
+      }
+    });
+  }
+
+  for (std::uint64_t version = 1; version <= number_of_versions; ++version) {
+    cell.publish(std::make_unique<const value>(version, &destroyed[version]));
+    REQUIRE(destroyed[version - 1]);
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  REQUIRE(failures == 0);
+}
@@ -0,0 +1,191 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "utils/binary.hxx"
+#include "utils/logger.hxx"
+
+#include "core/impl/row_streaming.hxx"
+#include "core/io/http_message.hxx"
+#include "core/utils/json.hxx"
+
+#include <couchbase/search_row.hxx>
+
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+/**
+ * Feeds the body in small chunks, the same way the HTTP session passes the data read from the
+ * socket.
+ */
+void
+feed(couchbase::core::io::http_response_body& body,
+     std::string_view payload,
+     std::size_t chunk_size = 7)
+{
+  while (!payload.empty()) {
+    const auto size = std::min(chunk_size, payload.size());
+    body.append(payload.substr(0, size));
+    payload.remove_prefix(size);
+  }
+}
+
+auto
+make_body(std::string pointer_expression,
+          couchbase::core::impl::row_callback_type&& row_callback)
+  -> couchbase::core::io::http_response_body
+{
+  couchbase::core::io::http_response_body body{};
+  body.use_json_streaming(couchbase::core::io::streaming_settings{
+    std::move(pointer_expression),
+    4,
+    std::move(row_callback),
+  });
+  return body;
+}
+} // namespace
+
+TEST_CASE("unit: row streaming delivers analytics rows and keeps metadata", "[unit]")
+{
+  test::utils::init_logger();
+
+  const std::string payload =
+    R"({"requestID":"0a2d6f1e","signature":{"*":"*"},"results":[{"name":"a"},"b",3,null],)"
+    R"("plans":{},"status":"success","metrics":{"resultCount":4,"processedObjects":4}})";
+
+  std::vector<std::string> rows{};
+  auto body = make_body("/results/^",
+                        couchbase::core::impl::build_row_callback([&rows](auto row) {
+                          rows.emplace_back(test::utils::to_string(row));
+                          return couchbase::stream_control::next_row;
+                        }));
+  feed(body, payload);
+
+  REQUIRE_SUCCESS(body.ec());
+  REQUIRE(rows == std::vector<std::string>{ R"({"name":"a"})", R"("b")", "3", "null" });
+  REQUIRE(body.number_of_rows() == 4);
+
+  auto meta = couchbase::core::utils::json::parse(body.data());
+  REQUIRE(meta["requestID"].get_string() == "0a2d6f1e");
+  REQUIRE(meta["results"].get_array().empty());
+  REQUIRE(meta["status"].get_string() == "success");
+  REQUIRE(meta["metrics"]["processedObjects"].as<std::uint64_t>() == 4);
+}
+
+TEST_CASE("unit: row streaming stops delivering rows when handler returns stop", "[unit]")
+{
+  test::utils::init_logger();
+
+  const std::string payload =
+    R"({"requestID":"5c1f0b46","signature":{"*":"*"},)"
+    R"("results":[{"id":1},{"id":2},{"id":3},{"id":4}],)"
+    R"("status":"success","metrics":{"resultCount":4,"resultSize":36}})";
+
+  std::vector<std::string> rows{};
+  auto body = make_body("/results/^",
+                        couchbase::core::impl::build_row_callback([&rows](auto row) {
+                          rows.emplace_back(test::utils::to_string(row));
+                          return rows.size() < 2 ? couchbase::stream_control::next_row
+                                                 : couchbase::stream_control::stop;
+                        }));
+  feed(body, payload);
+
+  REQUIRE_SUCCESS(body.ec());
+  REQUIRE(rows == std::vector<std::string>{ R"({"id":1})", R"({"id":2})" });
+  // the remaining rows are skipped, but still counted, and the trailing metadata is collected
+  REQUIRE(body.number_of_rows() == 4);
+
+  auto meta = couchbase::core::utils::json::parse(body.data());
+  REQUIRE(meta["requestID"].get_string() == "5c1f0b46");
+  REQUIRE(meta["results"].get_array().empty());
+  REQUIRE(meta["status"].get_string() == "success");
+  REQUIRE(meta["metrics"]["resultCount"].as<std::uint64_t>() == 4);
+}
+
+TEST_CASE("unit: row streaming parses search hits", "[unit]")
+{
+  test::utils::init_logger();
+
+  const std::string payload =
+    R"({"status":{"total":1,"failed":0,"successful":1},"hits":[)"
+    R"({"index":"idx_1","id":"doc_1","score":0.5,"fields":{"name":"first"}},)"
+    R"({"index":"idx_1","id":"doc_2","score":0.25,)"
+    R"("locations":{"name":{"second":[{"pos":1,"start":0,"end":6}]}}}],)"
+    R"("total_hits":2,"max_score":0.5,"took":1000,"facets":{}})";
+
+  std::vector<std::string> ids{};
+  std::vector<std::string> fields{};
+  std::vector<bool> has_locations{};
+  auto body = make_body(
+    "/hits/^",
+    couchbase::core::impl::build_search_row_callback([&](couchbase::search_row row) {
+      ids.emplace_back(row.id());
+      fields.emplace_back(test::utils::to_string(row.fields()));
+      has_locations.emplace_back(row.locations().has_value());
+      return couchbase::stream_control::next_row;
+    }));
+  feed(body, payload);
+
+  REQUIRE_SUCCESS(body.ec());
+  REQUIRE(ids == std::vector<std::string>{ "doc_1", "doc_2" });
+  REQUIRE(fields == std::vector<std::string>{ R"({"name":"first"})", "" });
+  REQUIRE(has_locations == std::vector<bool>{ false, true });
+  REQUIRE(body.number_of_rows() == 2);
+
+  auto meta = couchbase::core::utils::json::parse(body.data());
+  REQUIRE(meta["hits"].get_array().empty());
+  REQUIRE(meta["total_hits"].as<std::uint64_t>() == 2);
+  REQUIRE(meta["status"]["successful"].as<std::uint64_t>() == 1);
+}
+
+TEST_CASE("unit: row streaming stops on search hit that cannot be parsed", "[unit]")
+{
+  test::utils::init_logger();
+
+  // the location of the second hit does not have the position
+  const std::string payload =
+    R"({"status":{"total":1,"failed":0,"successful":1},"hits":[)"
+    R"({"index":"idx_1","id":"doc_1","score":0.5},)"
+    R"({"index":"idx_1","id":"doc_2","score":0.25,)"
+    R"("locations":{"name":{"second":[{"start":0,"end":6}]}}},)"
+    R"({"index":"idx_1","id":"doc_3","score":0.125}],)"
+    R"("total_hits":3,"max_score":0.5,"took":1000})";
+
+  std::vector<std::string> ids{};
+  auto body = make_body(
+    "/hits/^",
+    couchbase::core::impl::build_search_row_callback([&ids](couchbase::search_row row) {
+      ids.emplace_back(row.id());
+      return couchbase::stream_control::next_row;
+    }));
+  feed(body, payload);
+
+  REQUIRE_SUCCESS(body.ec());
+  REQUIRE(ids == std::vector<std::string>{ "doc_1" });
+  REQUIRE(body.number_of_rows() == 3);
+
+  auto meta = couchbase::core::utils::json::parse(body.data());
+  REQUIRE(meta["hits"].get_array().empty());
+  REQUIRE(meta["total_hits"].as<std::uint64_t>() == 3);
+}
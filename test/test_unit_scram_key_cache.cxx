@@ -0,0 +1,171 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/crypto/cbcrypto.h"
+#include "core/platform/base64.h"
+#include "core/sasl/client.h"
+#include "core/sasl/scram-sha/key_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using couchbase::core::crypto::Algorithm;
+using couchbase::core::sasl::Mechanism;
+using couchbase::core::sasl::mechanism::scram::KeyCache;
+
+const std::string salt{ "0123456789abcdef" };
+constexpr unsigned int iteration_count{ 4096 };
+} // namespace
+
+TEST_CASE("unit: SCRAM key cache derives keys once", "[unit]")
+{
+  auto& cache = KeyCache::instance();
+  cache.clear();
+  const auto before = cache.stats();
+
+  auto first = cache.get(
+    Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "user", "pencil", salt, iteration_count);
+  auto second = cache.get(
+    Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "user", "pencil", salt, iteration_count);
+
+  const auto salted_password =
+    couchbase::core::crypto::PBKDF2_HMAC(Algorithm::ALG_SHA256, "pencil", salt, iteration_count);
+  REQUIRE(first.saltedPassword == salted_password);
+  REQUIRE(first.clientKey ==
+          couchbase::core::crypto::CBC_HMAC(Algorithm::ALG_SHA256, salted_password, "Client Key"));
+  REQUIRE(first.serverKey ==
+          couchbase::core::crypto::CBC_HMAC(Algorithm::ALG_SHA256, salted_password, "Server Key"));
+  REQUIRE(second.saltedPassword == first.saltedPassword);
+
+  const auto after = cache.stats();
+  REQUIRE(after.misses - before.misses == 1);
+  REQUIRE(after.hits - before.hits == 1);
+  REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("unit: SCRAM key cache derives keys again when credentials change", "[unit]")
+{
+  auto& cache = KeyCache::instance();
+  cache.clear();
+
+  auto old_keys = cache.get(
+    Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "user", "pencil", salt, iteration_count);
+  const auto before = cache.stats();
+  auto new_keys = cache.get(
+    Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "user", "crayon", salt, iteration_count);
+
+  REQUIRE(new_keys.saltedPassword != old_keys.saltedPassword);
+  REQUIRE(new_keys.saltedPassword == couchbase::core::crypto::PBKDF2_HMAC(
+                                       Algorithm::ALG_SHA256, "crayon", salt, iteration_count));
+  REQUIRE(cache.stats().misses - before.misses == 1);
+  // the entry with the old password has been replaced
+  REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("unit: SCRAM key cache derives keys once for concurrent callers", "[unit]")
+{
+  auto& cache = KeyCache::instance();
+  cache.clear();
+  const auto before = cache.stats();
+
+  constexpr std::size_t number_of_threads{ 8 };
+  std::vector<std::string> salted_passwords(number_of_threads);
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t i = 0; i < number_of_threads; ++i) {
+    threads.emplace_back([&cache, &salted_passwords, i]() {
+      salted_passwords[i] = cache
+                              .get(Mechanism::SCRAM_SHA256,
+                                   Algorithm::ALG_SHA256,
+                                   "user",
+                                   "pencil",
+                                   salt,
+                                   iteration_count)
+                              .saltedPassword;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto salted_password =
+    couchbase::core::crypto::PBKDF2_HMAC(Algorithm::ALG_SHA256, "pencil", salt, iteration_count);
+  for (const auto& value : salted_passwords) {
+    REQUIRE(value == salted_password);
+  }
+  const auto after = cache.stats();
+  REQUIRE(after.misses - before.misses == 1);
+  REQUIRE(after.hits - before.hits == number_of_threads - 1);
+  REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("unit: SCRAM key cache keeps entries apart", "[unit]")
+{
+  auto& cache = KeyCache::instance();
+  cache.clear();
+
+  auto sha256 = cache.get(
+    Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "user", "pencil", salt, iteration_count);
+  auto sha512 = cache.get(
+    Mechanism::SCRAM_SHA512, Algorithm::ALG_SHA512, "user", "pencil", salt, iteration_count);
+  auto other_user = cache.get(
+    Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "admin", "pencil", salt, iteration_count);
+  auto other_salt = cache.get(
+    Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "user", "pencil", "fedcba9876543210", 4096);
+  auto other_iterations =
+    cache.get(Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "user", "pencil", salt, 8192);
+
+  REQUIRE(cache.size() == 5);
+  REQUIRE(sha256.saltedPassword != sha512.saltedPassword);
+  REQUIRE(sha256.saltedPassword == other_user.saltedPassword);
+  REQUIRE(sha256.saltedPassword != other_salt.saltedPassword);
+  REQUIRE(sha256.saltedPassword != other_iterations.saltedPassword);
+
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("unit: SCRAM client reuses keys of the previous exchange", "[unit]")
+{
+  auto& cache = KeyCache::instance();
+  cache.clear();
+  const auto before = cache.stats();
+
+  const std::string server_first_message =
+    "r=nonce,s=" + couchbase::core::base64::encode(salt) + ",i=" + std::to_string(iteration_count);
+  std::string client_final_message{};
+  for (int i = 0; i < 2; ++i) {
+    couchbase::core::sasl::ClientContext client(
+      []() { return std::string{ "user" }; },
+      []() { return std::string{ "pencil" }; },
+      { "SCRAM-SHA256" });
+    REQUIRE(client.start().first == couchbase::core::sasl::error::OK);
+    auto [error, message] = client.step(server_first_message);
+    REQUIRE(error == couchbase::core::sasl::error::CONTINUE);
+    client_final_message = message;
+  }
+  REQUIRE(client_final_message.find(",p=") != std::string::npos);
+
+  const auto after = cache.stats();
+  REQUIRE(after.misses - before.misses == 1);
+  REQUIRE(after.hits - before.hits == 1);
+}
@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/transactions/staged_mutation.hxx"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+using couchbase::core::transactions::staged_mutation;
+using couchbase::core::transactions::staged_mutation_queue;
+using couchbase::core::transactions::staged_mutation_type;
+
+auto
+make_mutation(const couchbase::core::document_id& id, staged_mutation_type type) -> staged_mutation
+{
+  return { couchbase::core::transactions::transaction_get_result{ id, {}, 0, {}, {} },
+           couchbase::codec::encoded_value{},
+           type };
+}
+
+auto
+staged_keys(staged_mutation_queue& queue) -> std::vector<std::string>
+{
+  std::vector<std::string> keys{};
+  queue.iterate([&keys](staged_mutation& mutation) {
+    keys.emplace_back(mutation.id().key());
+  });
+  return keys;
+}
+} // namespace
+
+TEST_CASE("unit: staged mutation queue keeps one mutation per document in staging order", "[unit]")
+{
+  const couchbase::core::document_id a{ "bucket", "scope", "collection", "a" };
+  const couchbase::core::document_id b{ "bucket", "scope", "collection", "b" };
+  const couchbase::core::document_id c{ "bucket", "scope", "collection", "c" };
+
+  staged_mutation_queue queue{};
+  REQUIRE(queue.empty());
+
+  queue.add(make_mutation(a, staged_mutation_type::INSERT));
+  queue.add(make_mutation(b, staged_mutation_type::REPLACE));
+  queue.add(make_mutation(c, staged_mutation_type::REMOVE));
+  REQUIRE(staged_keys(queue) == std::vector<std::string>{ "a", "b", "c" });
+
+  REQUIRE(queue.find_insert(a) != nullptr);
+  REQUIRE(queue.find_replace(a) == nullptr);
+  REQUIRE(queue.find_replace(b) != nullptr);
+  REQUIRE(queue.find_remove(c) != nullptr);
+  REQUIRE(queue.find_any(c)->type() == staged_mutation_type::REMOVE);
+
+  // staging the document again replaces the mutation and moves it to the end
+  queue.add(make_mutation(a, staged_mutation_type::REPLACE));
+  REQUIRE(staged_keys(queue) == std::vector<std::string>{ "b", "c", "a" });
+  REQUIRE(queue.find_insert(a) == nullptr);
+  REQUIRE(queue.find_replace(a) != nullptr);
+
+  queue.remove_any(b);
+  queue.remove_any(b);
+  REQUIRE(staged_keys(queue) == std::vector<std::string>{ "c", "a" });
+  REQUIRE(queue.find_any(b) == nullptr);
+
+  queue.remove_any(c);
+  queue.remove_any(a);
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("unit: staged mutation queue distinguishes collections", "[unit]")
+{
+  const couchbase::core::document_id first{ "bucket", "scope", "first", "key" };
+  const couchbase::core::document_id second{ "bucket", "scope", "second", "key" };
+  const couchbase::core::document_id other_bucket{ "other", "scope", "first", "key" };
+
+  staged_mutation_queue queue{};
+  queue.add(make_mutation(first, staged_mutation_type::INSERT));
+  queue.add(make_mutation(second, staged_mutation_type::REMOVE));
+
+  REQUIRE(queue.find_insert(first) != nullptr);
+  REQUIRE(queue.find_remove(second) != nullptr);
+  REQUIRE(queue.find_any(other_bucket) == nullptr);
+  REQUIRE(staged_keys(queue).size() == 2);
+}
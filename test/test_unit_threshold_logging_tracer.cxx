@@ -0,0 +1,137 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/utils/wait_until.hxx"
+#include "test_helper.hxx"
+
+#include "core/logger/configuration.hxx"
+#include "core/logger/logger.hxx"
+#include "core/tracing/constants.hxx"
+#include "core/tracing/threshold_logging_tracer.hxx"
+
+#include <asio/io_context.hpp>
+#include <spdlog/sinks/base_sink.h>
+
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+class capturing_sink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+  auto output() -> std::string
+  {
+    const std::scoped_lock lock(output_mutex_);
+    return output_.str();
+  }
+
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    spdlog::memory_buf_t formatted;
+    formatter_->format(msg, formatted);
+    const std::scoped_lock lock(output_mutex_);
+    output_ << std::string_view{ formatted.data(), formatted.size() };
+  }
+
+  void flush_() override
+  {
+  }
+
+private:
+  std::stringstream output_{};
+  std::mutex output_mutex_{};
+};
+
+/**
+ * Every thread ends single span, that lasts (thread + 1) * 10 milliseconds, and has operation ID
+ * "thread-<thread>". The spans of the last thread are orphaned.
+ */
+void
+trace_from_threads(couchbase::core::tracing::threshold_logging_tracer& tracer,
+                   std::size_t number_of_threads)
+{
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&tracer, number_of_threads, t]() {
+      auto span = tracer.start_span(couchbase::core::tracing::operation::mcbp_get, nullptr);
+      span->add_tag(couchbase::core::tracing::attributes::service,
+                    couchbase::core::tracing::service::key_value);
+      span->add_tag(couchbase::core::tracing::attributes::operation_id,
+                    "thread-" + std::to_string(t));
+      if (t == number_of_threads - 1) {
+        span->add_tag(couchbase::core::tracing::attributes::orphan, "aborted");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds((t + 1) * 10));
+      span->end();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
+TEST_CASE("unit: threshold logging tracer reports the longest spans of all threads", "[unit]")
+{
+  auto sink = std::make_shared<capturing_sink>();
+  couchbase::core::logger::configuration conf{};
+  conf.log_level = couchbase::core::logger::level::trace;
+  conf.sink = sink;
+  conf.console = false;
+  couchbase::core::logger::create_file_logger(conf);
+
+  {
+    asio::io_context ctx{};
+    couchbase::core::tracing::threshold_logging_options options{};
+    options.key_value_threshold = std::chrono::milliseconds{ 1 };
+    options.threshold_sample_size = 2;
+    auto tracer =
+      std::make_shared<couchbase::core::tracing::threshold_logging_tracer>(ctx, options);
+    trace_from_threads(*tracer, 5);
+    // the reports are emitted when the tracer is destroyed
+  }
+  couchbase::core::logger::flush();
+  REQUIRE(test::utils::wait_until(
+    [&sink]() {
+      return sink->output().find("Operations over threshold") != std::string::npos;
+    },
+    std::chrono::seconds(2),
+    std::chrono::milliseconds(100)));
+  const auto output = sink->output();
+
+  const auto threshold_report = output.substr(output.find("Operations over threshold"));
+  INFO(threshold_report);
+  REQUIRE(threshold_report.find(R"("count":2)") != std::string::npos);
+  // the longest span of the threads, that are not orphaned, goes first
+  const auto longest = threshold_report.find(R"("last_operation_id":"thread-3")");
+  const auto second = threshold_report.find(R"("last_operation_id":"thread-2")");
+  REQUIRE(longest != std::string::npos);
+  REQUIRE(second != std::string::npos);
+  REQUIRE(longest < second);
+  REQUIRE(threshold_report.find(R"("last_operation_id":"thread-1")") == std::string::npos);
+
+  const auto orphan_report = output.substr(output.find("Orphan responses observed"));
+  INFO(orphan_report);
+  REQUIRE(orphan_report.find(R"("count":1)") != std::string::npos);
+  REQUIRE(orphan_report.find(R"("last_operation_id":"thread-4")") != std::string::npos);
+}
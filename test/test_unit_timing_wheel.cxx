@@ -0,0 +1,108 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/timing_wheel.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+struct deadline_owner : std::enable_shared_from_this<deadline_owner> {
+  explicit deadline_owner(couchbase::core::io::timing_wheel& wheel, std::vector<int>& fired, int id)
+    : deadline{ wheel }
+    , fired_{ fired }
+    , id_{ id }
+  {
+  }
+
+  void start(std::chrono::milliseconds timeout)
+  {
+    deadline.expires_after(timeout);
+    deadline.async_wait<&deadline_owner::on_deadline>(shared_from_this());
+  }
+
+  void on_deadline()
+  {
+    fired_.push_back(id_);
+    expired_at = std::chrono::steady_clock::now();
+  }
+
+  couchbase::core::io::wheel_timer deadline;
+  std::chrono::steady_clock::time_point expired_at{};
+
+private:
+  std::vector<int>& fired_;
+  int id_;
+};
+} // namespace
+
+TEST_CASE("unit: timing wheel fires timers in order of their deadlines", "[unit]")
+{
+  asio::io_context io{};
+  auto& wheel = asio::use_service<couchbase::core::io::timing_wheel>(io);
+
+  std::vector<int> fired{};
+  auto first = std::make_shared<deadline_owner>(wheel, fired, 1);
+  auto second = std::make_shared<deadline_owner>(wheel, fired, 2);
+  // longer than a single revolution of the wheel
+  auto third = std::make_shared<deadline_owner>(wheel, fired, 3);
+
+  second->start(std::chrono::milliseconds{ 20 });
+  first->start(std::chrono::milliseconds{ 5 });
+  third->start(std::chrono::milliseconds{ 700 });
+  REQUIRE(wheel.size() == 3);
+
+  io.run();
+
+  REQUIRE(fired == std::vector<int>{ 1, 2, 3 });
+  REQUIRE(wheel.size() == 0);
+  for (const auto& owner : { first, second, third }) {
+    REQUIRE(owner->expired_at >= owner->deadline.expiry());
+  }
+}
+
+TEST_CASE("unit: timing wheel does not fire cancelled timers and releases their owners", "[unit]")
+{
+  asio::io_context io{};
+  auto& wheel = asio::use_service<couchbase::core::io::timing_wheel>(io);
+
+  std::vector<int> fired{};
+  std::weak_ptr<deadline_owner> weak_owner{};
+  {
+    auto owner = std::make_shared<deadline_owner>(wheel, fired, 1);
+    weak_owner = owner;
+    owner->start(std::chrono::milliseconds{ 10 });
+  }
+  // the wheel keeps the owner alive until the timer fires or is cancelled
+  REQUIRE_FALSE(weak_owner.expired());
+  REQUIRE(weak_owner.lock()->deadline.cancel());
+  REQUIRE(weak_owner.expired());
+
+  auto other = std::make_shared<deadline_owner>(wheel, fired, 2);
+  other->start(std::chrono::milliseconds{ 10 });
+  REQUIRE(other->deadline.cancel());
+  REQUIRE_FALSE(other->deadline.cancel());
+
+  io.run();
+  REQUIRE(fired.empty());
+}
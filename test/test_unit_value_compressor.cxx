@@ -0,0 +1,134 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/protocol/client_request.hxx"
+#include "core/protocol/cmd_upsert.hxx"
+#include "core/protocol/datatype.hxx"
+#include "core/protocol/value_compressor.hxx"
+
+#include <snappy.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+auto
+make_upsert(std::vector<std::byte> value)
+  -> couchbase::core::protocol::client_request<couchbase::core::protocol::upsert_request_body>
+{
+  couchbase::core::protocol::client_request<couchbase::core::protocol::upsert_request_body> req;
+  req.opaque(42);
+  req.body().id({ "bucket", "_default", "_default", "foo" });
+  req.body().content(value);
+  return req;
+}
+
+auto
+datatype_of(const std::vector<std::byte>& payload) -> std::uint8_t
+{
+  return std::to_integer<std::uint8_t>(payload[5]);
+}
+
+auto
+body_size_of(const std::vector<std::byte>& payload) -> std::uint32_t
+{
+  std::uint32_t size{};
+  std::memcpy(&size, payload.data() + 8, sizeof(size));
+  return couchbase::core::utils::byte_swap(size);
+}
+
+auto
+value_of(const std::vector<std::byte>& payload, std::size_t value_size) -> std::string
+{
+  return { reinterpret_cast<const char*>(payload.data() + payload.size() - value_size),
+           value_size };
+}
+} // namespace
+
+TEST_CASE("unit: value compressor skips values smaller than min_size", "[unit]")
+{
+  couchbase::core::protocol::value_compressor compressor{ 1024, 0.83 };
+  auto req = make_upsert(std::vector<std::byte>(512, std::byte{ 'a' }));
+  auto payload = req.data(compressor);
+
+  REQUIRE((datatype_of(payload) &
+           static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy)) == 0);
+  REQUIRE(payload.size() == couchbase::core::protocol::header_size + body_size_of(payload));
+  REQUIRE(value_of(payload, 512) == std::string(512, 'a'));
+
+  auto stats = compressor.stats();
+  REQUIRE(stats.skipped_values == 1);
+  REQUIRE(stats.compressed_values == 0);
+  REQUIRE(stats.input_bytes == 0);
+}
+
+TEST_CASE("unit: value compressor writes compressed value into the payload", "[unit]")
+{
+  couchbase::core::protocol::value_compressor compressor{ 32, 0.83 };
+  const std::string original(4096, 'a');
+  std::vector<std::byte> value(original.size());
+  std::memcpy(value.data(), original.data(), original.size());
+
+  auto req = make_upsert(value);
+  auto uncompressed_body_size = req.body().size();
+  auto payload = req.data(compressor);
+
+  REQUIRE((datatype_of(payload) &
+           static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy)) != 0);
+  REQUIRE(payload.size() == couchbase::core::protocol::header_size + body_size_of(payload));
+  auto compressed_size = value.size() - (uncompressed_body_size - body_size_of(payload));
+
+  std::string decompressed{};
+  REQUIRE(snappy::Uncompress(reinterpret_cast<const char*>(payload.data()) + payload.size() -
+                               compressed_size,
+                             compressed_size,
+                             &decompressed));
+  REQUIRE(decompressed == original);
+
+  auto stats = compressor.stats();
+  REQUIRE(stats.compressed_values == 1);
+  REQUIRE(stats.input_bytes == original.size());
+  REQUIRE(stats.saved_bytes == original.size() - compressed_size);
+}
+
+TEST_CASE("unit: value compressor sends original value if the ratio is not satisfied", "[unit]")
+{
+  couchbase::core::protocol::value_compressor compressor{ 32, 0.83 };
+  std::vector<std::byte> value(4096);
+  std::mt19937 gen{ 42 };
+  for (auto& byte : value) {
+    byte = static_cast<std::byte>(gen());
+  }
+
+  auto req = make_upsert(value);
+  auto payload = req.data(compressor);
+
+  REQUIRE((datatype_of(payload) &
+           static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy)) == 0);
+  REQUIRE(payload.size() == couchbase::core::protocol::header_size + body_size_of(payload));
+  REQUIRE(std::equal(value.begin(), value.end(), payload.end() - 4096));
+
+  auto stats = compressor.stats();
+  REQUIRE(stats.rejected_values == 1);
+  REQUIRE(stats.compressed_values == 0);
+  REQUIRE(stats.saved_bytes == 0);
+}
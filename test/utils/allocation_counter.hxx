@@ -0,0 +1,41 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * The test_allocation_counter library replaces global operator new and delete, and counts the
+ * allocations of the process. It is linked only into the benchmarks that report allocations per
+ * operation.
+ */
+namespace test::utils
+{
+/**
+ * Returns the number of calls to global operator new since the start of the process.
+ */
+auto
+number_of_allocations() -> std::size_t;
+
+/**
+ * Excludes the allocations of the calling thread from the counter, for example the thread of the
+ * mock server, so that only the allocations of the SDK and the caller are counted.
+ */
+void
+ignore_allocations_on_this_thread(bool ignore = true);
+} // namespace test::utils
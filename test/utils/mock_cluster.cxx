@@ -0,0 +1,1410 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "mock_cluster.hxx"
+
+#include "core/error_context/key_value_status_code.hxx"
+#include "core/impl/subdoc/path_flags.hxx"
+#include "core/protocol/client_opcode.hxx"
+#include "core/protocol/cmd_mutate_in.hxx"
+#include "core/protocol/datatype.hxx"
+#include "core/protocol/hello_feature.hxx"
+#include "core/protocol/magic.hxx"
+#include "core/utils/byteswap.hxx"
+#include "core/utils/json.hxx"
+
+#include <couchbase/password_authenticator.hxx>
+
+#include <asio.hpp>
+#include <fmt/core.h>
+#include <tao/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace test::utils
+{
+namespace
+{
+namespace protocol = couchbase::core::protocol;
+namespace subdoc = couchbase::core::impl::subdoc;
+using couchbase::core::key_value_status_code;
+
+constexpr std::size_t header_size{ 24 };
+constexpr std::uint64_t partition_uuid{ 0xc0ffee };
+const std::string loopback_address{ "127.0.0.1" };
+
+const std::set<protocol::hello_feature> supported_features{
+  protocol::hello_feature::tcp_nodelay,         protocol::hello_feature::mutation_seqno,
+  protocol::hello_feature::xattr,               protocol::hello_feature::select_bucket,
+  protocol::hello_feature::json,                protocol::hello_feature::unordered_execution,
+  protocol::hello_feature::alt_request_support, protocol::hello_feature::sync_replication,
+  protocol::hello_feature::collections,
+};
+
+template<typename T>
+auto
+read_number(const char* data) -> T
+{
+  T value{};
+  std::memcpy(&value, data, sizeof(value));
+  return couchbase::core::utils::byte_swap(value);
+}
+
+template<typename T>
+void
+append_number(std::string& output, T value)
+{
+  value = couchbase::core::utils::byte_swap(value);
+  output.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename Flag>
+auto
+has_flag(std::uint8_t flags, Flag flag) -> bool
+{
+  return (flags & std::to_integer<std::uint8_t>(flag)) != 0;
+}
+
+struct document {
+  std::string value{};
+  tao::json::value xattrs{ tao::json::empty_object };
+  std::uint64_t cas{ 0 };
+  std::uint32_t flags{ 0 };
+  std::uint32_t expiry{ 0 };
+  std::uint8_t datatype{ 0 };
+};
+
+/**
+ * State of the cluster, that is only accessed from the thread of the mock.
+ */
+struct cluster_state {
+  mock_cluster_options options;
+  std::string cluster_configuration{};
+  std::string bucket_configuration{};
+  std::unordered_map<std::string, document> documents{};
+  std::vector<std::uint64_t> sequence_numbers{};
+  std::uint64_t last_cas{ 0 };
+  std::uint64_t last_request_id{ 0 };
+
+  std::atomic_uint64_t kv_connections{ 0 };
+  std::atomic_uint64_t kv_requests{ 0 };
+  std::atomic_uint64_t http_requests{ 0 };
+  std::atomic_size_t number_of_documents{ 0 };
+
+  auto next_cas() -> std::uint64_t
+  {
+    return ++last_cas;
+  }
+};
+
+auto
+make_configuration(const mock_cluster_options& options,
+                   std::uint16_t kv_port,
+                   std::uint16_t http_port,
+                   bool with_bucket) -> std::string
+{
+  tao::json::value node{
+    { "hostname", loopback_address },
+    { "thisNode", true },
+    { "services",
+      {
+        { "kv", kv_port },
+        { "mgmt", http_port },
+        { "n1ql", http_port },
+        { "fts", http_port },
+      } },
+  };
+  tao::json::value nodes = tao::json::empty_array;
+  nodes.get_array().emplace_back(std::move(node));
+
+  tao::json::value config{
+    { "rev", 1 },
+    { "revEpoch", 1 },
+    { "nodesExt", std::move(nodes) },
+  };
+  if (!with_bucket) {
+    return couchbase::core::utils::json::generate(config);
+  }
+
+  tao::json::value server_list = tao::json::empty_array;
+  server_list.get_array().emplace_back(fmt::format("{}:{}", loopback_address, kv_port));
+  tao::json::value vbucket_map = tao::json::empty_array;
+  for (std::size_t i = 0; i < options.number_of_vbuckets; ++i) {
+    tao::json::value owners = tao::json::empty_array;
+    owners.get_array().emplace_back(0);
+    vbucket_map.get_array().emplace_back(std::move(owners));
+  }
+  tao::json::value capabilities = tao::json::empty_array;
+  for (const auto* capability :
+       { "cbhello", "touch", "cccp", "nodesExt", "xattr", "collections", "durableWrite" }) {
+    capabilities.get_array().emplace_back(capability);
+  }
+
+  config["name"] = options.bucket;
+  config["uuid"] = "6d6f636b5f636c75737465725f627563";
+  config["nodeLocator"] = "vbucket";
+  config["collectionsManifestUid"] = "0";
+  config["bucketCapabilitiesVer"] = "";
+  config["bucketCapabilities"] = std::move(capabilities);
+  tao::json::value vbucket_server_map{
+    { "hashAlgorithm", "CRC" },
+    { "numReplicas", 0 },
+    { "serverList", std::move(server_list) },
+    { "vBucketMap", std::move(vbucket_map) },
+  };
+  config["vBucketServerMap"] = std::move(vbucket_server_map);
+  return couchbase::core::utils::json::generate(config);
+}
+
+/**
+ * Element of the sub-document path, either the key of the object, or the index of the array.
+ */
+struct path_element {
+  std::string key{};
+  std::optional<std::int64_t> index{};
+};
+
+auto
+parse_path(std::string_view path) -> std::optional<std::vector<path_element>>
+{
+  std::vector<path_element> elements{};
+  std::size_t i = 0;
+  while (i < path.size()) {
+    if (path[i] == '[') {
+      auto close = path.find(']', i);
+      if (close == std::string_view::npos) {
+        return {};
+      }
+      std::int64_t index{};
+      if (auto [end, ec] = std::from_chars(path.data() + i + 1, path.data() + close, index);
+          ec != std::errc{} || end != path.data() + close) {
+        return {};
+      }
+      elements.push_back({ {}, index });
+      i = close + 1;
+    } else {
+      std::string key{};
+      if (path[i] == '`') {
+        for (++i; i < path.size(); ++i) {
+          if (path[i] == '`') {
+            if (i + 1 < path.size() && path[i + 1] == '`') {
+              ++i;
+            } else {
+              break;
+            }
+          }
+          key += path[i];
+        }
+        if (i == path.size()) {
+          return {};
+        }
+        ++i;
+      } else {
+        while (i < path.size() && path[i] != '.' && path[i] != '[') {
+          key += path[i++];
+        }
+      }
+      if (key.empty()) {
+        return {};
+      }
+      elements.push_back({ std::move(key), {} });
+    }
+    if (i < path.size() && path[i] == '.') {
+      if (++i == path.size()) {
+        return {};
+      }
+    }
+  }
+  return elements;
+}
+
+struct path_lookup {
+  tao::json::value* value{ nullptr };
+  key_value_status_code status{ key_value_status_code::success };
+};
+
+/**
+ * Walks the first @p depth elements of the path. Missing keys are created as objects, when
+ * @p create_parents is set.
+ */
+auto
+resolve_path(tao::json::value& root,
+             const std::vector<path_element>& path,
+             std::size_t depth,
+             bool create_parents = false) -> path_lookup
+{
+  tao::json::value* current = &root;
+  for (std::size_t i = 0; i < depth; ++i) {
+    const auto& element = path[i];
+    if (element.index) {
+      if (!current->is_array()) {
+        return { nullptr, key_value_status_code::subdoc_path_mismatch };
+      }
+      auto& array = current->get_array();
+      auto index = element.index.value();
+      if (index < 0) {
+        index += static_cast<std::int64_t>(array.size());
+      }
+      if (index < 0 || index >= static_cast<std::int64_t>(array.size())) {
+        return { nullptr, key_value_status_code::subdoc_path_not_found };
+      }
+      current = &array[static_cast<std::size_t>(index)];
+    } else {
+      if (!current->is_object()) {
+        return { nullptr, key_value_status_code::subdoc_path_mismatch };
+      }
+      auto* next = current->find(element.key);
+      if (next == nullptr) {
+        if (!create_parents) {
+          return { nullptr, key_value_status_code::subdoc_path_not_found };
+        }
+        next = &current->get_object()
+                  .try_emplace(element.key, tao::json::empty_object)
+                  .first->second;
+      }
+      current = next;
+    }
+  }
+  return { current, key_value_status_code::success };
+}
+
+auto
+parse_value(std::string_view value) -> std::optional<tao::json::value>
+{
+  try {
+    return couchbase::core::utils::json::parse(value);
+  } catch (const std::exception&) {
+    return {};
+  }
+}
+
+/**
+ * Virtual attribute "$document" with the metadata of the document.
+ */
+auto
+document_attributes(const document& doc) -> tao::json::value
+{
+  tao::json::value datatype = tao::json::empty_array;
+  datatype.get_array().emplace_back(
+    (doc.datatype & static_cast<std::uint8_t>(protocol::datatype::json)) != 0 ? "json" : "raw");
+  tao::json::value attributes{
+    { "CAS", fmt::format("0x{:016x}", doc.cas) },
+    { "exptime", doc.expiry },
+    { "flags", doc.flags },
+    { "value_bytes", doc.value.size() },
+    { "deleted", false },
+  };
+  attributes["datatype"] = std::move(datatype);
+  return tao::json::value{ { "$document", std::move(attributes) } };
+}
+
+struct subdoc_spec {
+  std::uint8_t opcode{};
+  std::uint8_t flags{};
+  std::string_view path{};
+  std::string_view value{};
+};
+
+struct subdoc_result {
+  key_value_status_code status{ key_value_status_code::success };
+  std::string value{};
+};
+
+/**
+ * Applies single lookup to the document. The body is parsed by the caller, and it is empty when
+ * the document is not a JSON.
+ */
+auto
+lookup_path(const document& doc, std::optional<tao::json::value>& body, const subdoc_spec& spec)
+  -> subdoc_result
+{
+  const auto opcode = static_cast<protocol::subdoc_opcode>(spec.opcode);
+  if (opcode == protocol::subdoc_opcode::get_doc) {
+    return { key_value_status_code::success, doc.value };
+  }
+  if (opcode != protocol::subdoc_opcode::get && opcode != protocol::subdoc_opcode::exists &&
+      opcode != protocol::subdoc_opcode::get_count) {
+    return { key_value_status_code::subdoc_invalid_combo };
+  }
+
+  auto path = parse_path(spec.path);
+  if (!path || path->empty()) {
+    return { key_value_status_code::subdoc_path_invalid };
+  }
+  tao::json::value attributes{};
+  tao::json::value* root = nullptr;
+  if (has_flag(spec.flags, subdoc::path_flag_xattr)) {
+    if (const auto& name = path->front().key; !name.empty() && name.front() == '$') {
+      if (name != "$document") {
+        return { key_value_status_code::subdoc_xattr_unknown_vattr };
+      }
+      attributes = document_attributes(doc);
+      root = &attributes;
+    } else {
+      // the user attributes are stored separately, the copy of the document is not modified
+      attributes = doc.xattrs;
+      root = &attributes;
+    }
+  } else {
+    if (!body) {
+      return { key_value_status_code::subdoc_doc_not_json };
+    }
+    root = &body.value();
+  }
+
+  auto [value, status] = resolve_path(*root, path.value(), path->size());
+  if (status != key_value_status_code::success) {
+    return { status };
+  }
+  switch (opcode) {
+    case protocol::subdoc_opcode::exists:
+      return { key_value_status_code::success };
+    case protocol::subdoc_opcode::get_count:
+      if (value->is_array()) {
+        return { key_value_status_code::success, std::to_string(value->get_array().size()) };
+      }
+      if (value->is_object()) {
+        return { key_value_status_code::success, std::to_string(value->get_object().size()) };
+      }
+      return { key_value_status_code::subdoc_path_mismatch };
+    default:
+      break;
+  }
+  return { key_value_status_code::success, couchbase::core::utils::json::generate(*value) };
+}
+
+/**
+ * Applies single mutation to the root, that is either the body or the extended attributes of the
+ * document.
+ */
+auto
+mutate_path(tao::json::value& root, const subdoc_spec& spec) -> subdoc_result
+{
+  const auto opcode = static_cast<protocol::subdoc_opcode>(spec.opcode);
+  const bool create_parents = has_flag(spec.flags, subdoc::path_flag_create_parents);
+
+  auto path = parse_path(spec.path);
+  if (!path) {
+    return { key_value_status_code::subdoc_path_invalid };
+  }
+
+  switch (opcode) {
+    case protocol::subdoc_opcode::dict_add:
+    case protocol::subdoc_opcode::dict_upsert:
+    case protocol::subdoc_opcode::replace:
+    case protocol::subdoc_opcode::remove: {
+      if (path->empty()) {
+        return { key_value_status_code::subdoc_path_invalid };
+      }
+      const auto& last = path->back();
+      if (last.index && opcode != protocol::subdoc_opcode::replace &&
+          opcode != protocol::subdoc_opcode::remove) {
+        return { key_value_status_code::subdoc_path_invalid };
+      }
+      auto parent = resolve_path(root,
+                                 path.value(),
+                                 path->size() - 1,
+                                 create_parents && opcode != protocol::subdoc_opcode::replace);
+      if (parent.status != key_value_status_code::success) {
+        return { parent.status };
+      }
+      std::optional<tao::json::value> value{};
+      if (opcode != protocol::subdoc_opcode::remove) {
+        value = parse_value(spec.value);
+        if (!value) {
+          return { key_value_status_code::subdoc_value_cannot_insert };
+        }
+      }
+      if (last.index) {
+        if (!parent.value->is_array()) {
+          return { key_value_status_code::subdoc_path_mismatch };
+        }
+        auto& array = parent.value->get_array();
+        auto index = last.index.value() < 0
+                       ? last.index.value() + static_cast<std::int64_t>(array.size())
+                       : last.index.value();
+        if (index < 0 || index >= static_cast<std::int64_t>(array.size())) {
+          return { key_value_status_code::subdoc_path_not_found };
+        }
+        if (value) {
+          array[static_cast<std::size_t>(index)] = std::move(value.value());
+        } else {
+          array.erase(array.begin() + index);
+        }
+        return {};
+      }
+      if (!parent.value->is_object()) {
+        return { key_value_status_code::subdoc_path_mismatch };
+      }
+      auto& object = parent.value->get_object();
+      auto existing = object.find(last.key);
+      if (opcode == protocol::subdoc_opcode::dict_add && existing != object.end()) {
+        return { key_value_status_code::subdoc_path_exists };
+      }
+      if ((opcode == protocol::subdoc_opcode::replace ||
+           opcode == protocol::subdoc_opcode::remove) &&
+          existing == object.end()) {
+        return { key_value_status_code::subdoc_path_not_found };
+      }
+      if (value) {
+        object.insert_or_assign(last.key, std::move(value.value()));
+      } else {
+        object.erase(existing);
+      }
+      return {};
+    }
+
+    case protocol::subdoc_opcode::array_push_last:
+    case protocol::subdoc_opcode::array_push_first:
+    case protocol::subdoc_opcode::array_add_unique: {
+      auto values = parse_value(fmt::format("[{}]", spec.value));
+      if (!values || values->get_array().empty() ||
+          (opcode == protocol::subdoc_opcode::array_add_unique &&
+           values->get_array().size() != 1)) {
+        return { key_value_status_code::subdoc_value_cannot_insert };
+      }
+      auto target = resolve_path(root, path.value(), path->size());
+      if (target.status == key_value_status_code::subdoc_path_not_found && create_parents &&
+          !path->back().index) {
+        auto parent = resolve_path(root, path.value(), path->size() - 1, true);
+        if (parent.status != key_value_status_code::success) {
+          return { parent.status };
+        }
+        if (!parent.value->is_object()) {
+          return { key_value_status_code::subdoc_path_mismatch };
+        }
+        target.value = &parent.value->get_object()
+                          .insert_or_assign(path->back().key, tao::json::empty_array)
+                          .first->second;
+        target.status = key_value_status_code::success;
+      }
+      if (target.status != key_value_status_code::success) {
+        return { target.status };
+      }
+      if (!target.value->is_array()) {
+        return { key_value_status_code::subdoc_path_mismatch };
+      }
+      auto& array = target.value->get_array();
+      auto& new_values = values->get_array();
+      if (opcode == protocol::subdoc_opcode::array_add_unique) {
+        if (std::find(array.begin(), array.end(), new_values.front()) != array.end()) {
+          return { key_value_status_code::subdoc_path_exists };
+        }
+      }
+      auto position =
+        opcode == protocol::subdoc_opcode::array_push_first ? array.begin() : array.end();
+      array.insert(position,
+                   std::make_move_iterator(new_values.begin()),
+                   std::make_move_iterator(new_values.end()));
+      return {};
+    }
+
+    case protocol::subdoc_opcode::array_insert: {
+      if (path->empty() || !path->back().index) {
+        return { key_value_status_code::subdoc_path_invalid };
+      }
+      auto values = parse_value(fmt::format("[{}]", spec.value));
+      if (!values || values->get_array().empty()) {
+        return { key_value_status_code::subdoc_value_cannot_insert };
+      }
+      auto parent = resolve_path(root, path.value(), path->size() - 1);
+      if (parent.status != key_value_status_code::success) {
+        return { parent.status };
+      }
+      if (!parent.value->is_array()) {
+        return { key_value_status_code::subdoc_path_mismatch };
+      }
+      auto& array = parent.value->get_array();
+      auto index = path->back().index.value();
+      if (index < 0 || index > static_cast<std::int64_t>(array.size())) {
+        return { key_value_status_code::subdoc_path_not_found };
+      }
+      auto& new_values = values->get_array();
+      array.insert(array.begin() + index,
+                   std::make_move_iterator(new_values.begin()),
+                   std::make_move_iterator(new_values.end()));
+      return {};
+    }
+
+    case protocol::subdoc_opcode::counter: {
+      std::int64_t delta{};
+      if (auto [end, ec] =
+            std::from_chars(spec.value.data(), spec.value.data() + spec.value.size(), delta);
+          ec != std::errc{} || end != spec.value.data() + spec.value.size() || delta == 0) {
+        return { key_value_status_code::subdoc_delta_invalid };
+      }
+      if (path->empty() || path->back().index) {
+        return { key_value_status_code::subdoc_path_invalid };
+      }
+      auto parent = resolve_path(root, path.value(), path->size() - 1, create_parents);
+      if (parent.status != key_value_status_code::success) {
+        return { parent.status };
+      }
+      if (!parent.value->is_object()) {
+        return { key_value_status_code::subdoc_path_mismatch };
+      }
+      auto& object = parent.value->get_object();
+      std::int64_t current{ 0 };
+      if (auto existing = object.find(path->back().key); existing != object.end()) {
+        if (!existing->second.is_integer()) {
+          return { key_value_status_code::subdoc_path_mismatch };
+        }
+        current = existing->second.as<std::int64_t>();
+      }
+      current += delta;
+      object.insert_or_assign(path->back().key, current);
+      return { key_value_status_code::success, std::to_string(current) };
+    }
+
+    default:
+      break;
+  }
+  return { key_value_status_code::subdoc_invalid_combo };
+}
+
+struct request {
+  std::uint8_t opcode{};
+  std::uint8_t datatype{};
+  std::uint16_t partition{};
+  std::uint32_t opaque{};
+  std::uint64_t cas{};
+  std::string_view extras{};
+  std::string_view key{};
+  std::string_view value{};
+};
+
+auto
+parse_request(const char* data) -> request
+{
+  request req{};
+  std::size_t framing_extras_size{ 0 };
+  std::size_t key_size{ 0 };
+  if (static_cast<protocol::magic>(data[0]) == protocol::magic::alt_client_request) {
+    framing_extras_size = static_cast<std::uint8_t>(data[2]);
+    key_size = static_cast<std::uint8_t>(data[3]);
+  } else {
+    key_size = read_number<std::uint16_t>(data + 2);
+  }
+  const std::size_t extras_size = static_cast<std::uint8_t>(data[4]);
+  const std::size_t body_size = read_number<std::uint32_t>(data + 8);
+
+  req.opcode = static_cast<std::uint8_t>(data[1]);
+  req.datatype = static_cast<std::uint8_t>(data[5]);
+  req.partition = read_number<std::uint16_t>(data + 6);
+  req.opaque = read_number<std::uint32_t>(data + 12);
+  req.cas = read_number<std::uint64_t>(data + 16);
+
+  // the frame infos (durability, preserve expiry, impersonation) are accepted and ignored
+  const char* body = data + header_size + framing_extras_size;
+  req.extras = { body, extras_size };
+  req.key = { body + extras_size, key_size };
+  req.value = { body + extras_size + key_size,
+                body_size - framing_extras_size - extras_size - key_size };
+  return req;
+}
+
+class kv_connection : public std::enable_shared_from_this<kv_connection>
+{
+public:
+  kv_connection(asio::ip::tcp::socket socket, cluster_state& state)
+    : socket_(std::move(socket))
+    , state_(state)
+  {
+  }
+
+  void start()
+  {
+    do_read();
+  }
+
+private:
+  void do_read()
+  {
+    socket_.async_read_some(
+      asio::buffer(chunk_),
+      [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
+        if (ec) {
+          return;
+        }
+        self->input_.append(self->chunk_.data(), bytes_transferred);
+        self->process_input();
+        self->flush();
+        self->do_read();
+      });
+  }
+
+  void process_input()
+  {
+    std::size_t offset{ 0 };
+    while (input_.size() - offset >= header_size) {
+      const char* data = input_.data() + offset;
+      const auto packet_size = header_size + read_number<std::uint32_t>(data + 8);
+      if (input_.size() - offset < packet_size) {
+        break;
+      }
+      handle(parse_request(data));
+      offset += packet_size;
+    }
+    input_.erase(0, offset);
+  }
+
+  void flush()
+  {
+    if (writing_ || output_.empty()) {
+      return;
+    }
+    writing_ = true;
+    std::swap(output_, writing_buffer_);
+    asio::async_write(
+      socket_,
+      asio::buffer(writing_buffer_),
+      [self = shared_from_this()](std::error_code ec, std::size_t /* bytes_transferred */) {
+        self->writing_ = false;
+        self->writing_buffer_.clear();
+        if (ec) {
+          return;
+        }
+        self->flush();
+      });
+  }
+
+  void respond(const request& req,
+               key_value_status_code status,
+               std::string_view extras = {},
+               std::string_view value = {},
+               std::uint8_t datatype = 0,
+               std::uint64_t cas = 0)
+  {
+    output_.push_back(static_cast<char>(protocol::magic::client_response));
+    output_.push_back(static_cast<char>(req.opcode));
+    append_number<std::uint16_t>(output_, 0);
+    output_.push_back(static_cast<char>(extras.size()));
+    output_.push_back(static_cast<char>(datatype));
+    append_number(output_, static_cast<std::uint16_t>(status));
+    append_number(output_, static_cast<std::uint32_t>(extras.size() + value.size()));
+    append_number(output_, req.opaque);
+    append_number(output_, cas);
+    output_.append(extras);
+    output_.append(value);
+  }
+
+  auto mutation_token(std::uint16_t partition) -> std::string
+  {
+    std::string extras{};
+    if (mutation_tokens_) {
+      auto& sequence_number = state_.sequence_numbers[partition % state_.sequence_numbers.size()];
+      append_number(extras, partition_uuid);
+      append_number(extras, ++sequence_number);
+    }
+    return extras;
+  }
+
+  void store_document(std::string key, document&& doc)
+  {
+    state_.documents.insert_or_assign(std::move(key), std::move(doc));
+    state_.number_of_documents = state_.documents.size();
+  }
+
+  void erase_document(std::unordered_map<std::string, document>::iterator it)
+  {
+    state_.documents.erase(it);
+    state_.number_of_documents = state_.documents.size();
+  }
+
+  void handle(const request& req)
+  {
+    ++state_.kv_requests;
+    switch (static_cast<protocol::client_opcode>(req.opcode)) {
+      case protocol::client_opcode::hello:
+        return handle_hello(req);
+      case protocol::client_opcode::sasl_list_mechs:
+        return respond(req, key_value_status_code::success, {}, "PLAIN");
+      case protocol::client_opcode::sasl_auth:
+        return handle_sasl_auth(req);
+      case protocol::client_opcode::noop:
+        return respond(req, key_value_status_code::success);
+      default:
+        break;
+    }
+    if (!authenticated_) {
+      return respond(req, key_value_status_code::no_access);
+    }
+    switch (static_cast<protocol::client_opcode>(req.opcode)) {
+      case protocol::client_opcode::select_bucket:
+        return handle_select_bucket(req);
+      case protocol::client_opcode::get_cluster_config:
+        return respond(req,
+                       key_value_status_code::success,
+                       {},
+                       bucket_selected_ ? state_.bucket_configuration
+                                        : state_.cluster_configuration,
+                       static_cast<std::uint8_t>(protocol::datatype::json));
+      default:
+        break;
+    }
+    if (!bucket_selected_) {
+      return respond(req, key_value_status_code::no_bucket);
+    }
+    switch (static_cast<protocol::client_opcode>(req.opcode)) {
+      case protocol::client_opcode::get_collection_id:
+        return handle_get_collection_id(req);
+      case protocol::client_opcode::get:
+        return handle_get(req);
+      case protocol::client_opcode::upsert:
+      case protocol::client_opcode::insert:
+      case protocol::client_opcode::replace:
+        return handle_store(req);
+      case protocol::client_opcode::remove:
+        return handle_remove(req);
+      case protocol::client_opcode::subdoc_multi_lookup:
+        return handle_lookup_in(req);
+      case protocol::client_opcode::subdoc_multi_mutation:
+        return handle_mutate_in(req);
+      default:
+        break;
+    }
+    return respond(req, key_value_status_code::not_supported);
+  }
+
+  void handle_hello(const request& req)
+  {
+    std::string features{};
+    for (std::size_t offset = 0; offset + 2 <= req.value.size(); offset += 2) {
+      const auto code = read_number<std::uint16_t>(req.value.data() + offset);
+      const auto feature = static_cast<protocol::hello_feature>(code);
+      if (supported_features.count(feature) == 0) {
+        continue;
+      }
+      if (feature == protocol::hello_feature::mutation_seqno) {
+        mutation_tokens_ = true;
+      }
+      append_number(features, code);
+    }
+    respond(req, key_value_status_code::success, {}, features);
+  }
+
+  void handle_sasl_auth(const request& req)
+  {
+    // PLAIN payload is "authzid\0username\0password"
+    std::string_view payload = req.value;
+    auto first = payload.find('\0');
+    auto second = payload.find('\0', first == std::string_view::npos ? first : first + 1);
+    if (req.key != "PLAIN" || first == std::string_view::npos ||
+        second == std::string_view::npos ||
+        payload.substr(first + 1, second - first - 1) != state_.options.username ||
+        payload.substr(second + 1) != state_.options.password) {
+      authenticated_ = false;
+      return respond(req, key_value_status_code::auth_error);
+    }
+    authenticated_ = true;
+    respond(req, key_value_status_code::success);
+  }
+
+  void handle_select_bucket(const request& req)
+  {
+    if (req.key != state_.options.bucket) {
+      bucket_selected_ = false;
+      return respond(req, key_value_status_code::no_access);
+    }
+    bucket_selected_ = true;
+    respond(req, key_value_status_code::success);
+  }
+
+  void handle_get_collection_id(const request& req)
+  {
+    const auto path = req.value.empty() ? req.key : req.value;
+    if (path != "_default._default" && path != "_default") {
+      return respond(req, key_value_status_code::unknown_collection);
+    }
+    std::string extras{};
+    append_number<std::uint64_t>(extras, 0);
+    append_number<std::uint32_t>(extras, 0);
+    respond(req, key_value_status_code::success, extras);
+  }
+
+  void handle_get(const request& req)
+  {
+    auto it = state_.documents.find(std::string{ req.key });
+    if (it == state_.documents.end()) {
+      return respond(req, key_value_status_code::not_found);
+    }
+    const auto& doc = it->second;
+    std::string extras{};
+    append_number(extras, doc.flags);
+    respond(req, key_value_status_code::success, extras, doc.value, doc.datatype, doc.cas);
+  }
+
+  void handle_store(const request& req)
+  {
+    const auto opcode = static_cast<protocol::client_opcode>(req.opcode);
+    std::string key{ req.key };
+    auto it = state_.documents.find(key);
+    const bool exists = it != state_.documents.end();
+    if (opcode == protocol::client_opcode::insert && exists) {
+      return respond(req, key_value_status_code::exists);
+    }
+    if ((opcode == protocol::client_opcode::replace || req.cas != 0) && !exists) {
+      return respond(req, key_value_status_code::not_found);
+    }
+    if (req.cas != 0 && it->second.cas != req.cas) {
+      return respond(req, key_value_status_code::exists);
+    }
+
+    document doc{};
+    doc.value = req.value;
+    doc.datatype = req.datatype & static_cast<std::uint8_t>(protocol::datatype::json);
+    if (req.extras.size() >= 8) {
+      doc.flags = read_number<std::uint32_t>(req.extras.data());
+      doc.expiry = read_number<std::uint32_t>(req.extras.data() + 4);
+    }
+    doc.cas = state_.next_cas();
+    const auto cas = doc.cas;
+    store_document(std::move(key), std::move(doc));
+    respond(req, key_value_status_code::success, mutation_token(req.partition), {}, 0, cas);
+  }
+
+  void handle_remove(const request& req)
+  {
+    auto it = state_.documents.find(std::string{ req.key });
+    if (it == state_.documents.end()) {
+      return respond(req, key_value_status_code::not_found);
+    }
+    if (req.cas != 0 && it->second.cas != req.cas) {
+      return respond(req, key_value_status_code::exists);
+    }
+    erase_document(it);
+    respond(
+      req, key_value_status_code::success, mutation_token(req.partition), {}, 0, state_.next_cas());
+  }
+
+  static auto parse_specs(std::string_view payload, bool mutation) -> std::vector<subdoc_spec>
+  {
+    std::vector<subdoc_spec> specs{};
+    std::size_t offset{ 0 };
+    const std::size_t spec_header_size = mutation ? 8 : 4;
+    while (offset + spec_header_size <= payload.size()) {
+      subdoc_spec spec{};
+      spec.opcode = static_cast<std::uint8_t>(payload[offset]);
+      spec.flags = static_cast<std::uint8_t>(payload[offset + 1]);
+      const std::size_t path_size = read_number<std::uint16_t>(payload.data() + offset + 2);
+      const std::size_t value_size =
+        mutation ? read_number<std::uint32_t>(payload.data() + offset + 4) : 0;
+      offset += spec_header_size;
+      spec.path = payload.substr(offset, path_size);
+      offset += path_size;
+      spec.value = payload.substr(offset, value_size);
+      offset += value_size;
+      specs.push_back(spec);
+    }
+    return specs;
+  }
+
+  void handle_lookup_in(const request& req)
+  {
+    auto it = state_.documents.find(std::string{ req.key });
+    if (it == state_.documents.end()) {
+      return respond(req, key_value_status_code::not_found);
+    }
+    const auto& doc = it->second;
+    auto body = parse_value(doc.value);
+
+    auto status = key_value_status_code::success;
+    std::string value{};
+    for (const auto& spec : parse_specs(req.value, false)) {
+      auto result = lookup_path(doc, body, spec);
+      if (result.status != key_value_status_code::success) {
+        status = key_value_status_code::subdoc_multi_path_failure;
+      }
+      append_number(value, static_cast<std::uint16_t>(result.status));
+      append_number(value, static_cast<std::uint32_t>(result.value.size()));
+      value.append(result.value);
+    }
+    respond(req, status, {}, value, 0, doc.cas);
+  }
+
+  void handle_mutate_in(const request& req)
+  {
+    std::uint8_t doc_flags{ 0 };
+    std::optional<std::uint32_t> expiry{};
+    std::optional<std::uint32_t> user_flags{};
+    if (req.extras.size() >= 4) {
+      expiry = read_number<std::uint32_t>(req.extras.data());
+    }
+    if (req.extras.size() >= 8) {
+      user_flags = read_number<std::uint32_t>(req.extras.data() + 4);
+    }
+    if (req.extras.size() % 4 == 1) {
+      doc_flags = static_cast<std::uint8_t>(req.extras.back());
+    }
+
+    std::string key{ req.key };
+    auto it = state_.documents.find(key);
+    const bool exists = it != state_.documents.end();
+    const bool add = has_flag(doc_flags, protocol::mutate_in_request_body::doc_flag_add);
+    const bool mkdoc = has_flag(doc_flags, protocol::mutate_in_request_body::doc_flag_mkdoc);
+    if (add && exists) {
+      return respond(req, key_value_status_code::exists);
+    }
+    if (!exists && !add && !mkdoc) {
+      return respond(req, key_value_status_code::not_found);
+    }
+    if (exists && req.cas != 0 && it->second.cas != req.cas) {
+      return respond(req, key_value_status_code::exists);
+    }
+
+    document doc{};
+    if (exists) {
+      doc = it->second;
+    } else {
+      doc.value = "{}";
+      doc.datatype = static_cast<std::uint8_t>(protocol::datatype::json);
+    }
+    auto body = parse_value(doc.value);
+    bool body_modified{ false };
+    bool remove_document{ false };
+
+    std::string value{};
+    const auto specs = parse_specs(req.value, true);
+    for (std::size_t index = 0; index < specs.size(); ++index) {
+      const auto& spec = specs[index];
+      subdoc_result result{};
+      switch (static_cast<protocol::subdoc_opcode>(spec.opcode)) {
+        case protocol::subdoc_opcode::set_doc:
+          body = parse_value(spec.value);
+          if (!body) {
+            result.status = key_value_status_code::subdoc_value_cannot_insert;
+          }
+          body_modified = true;
+          break;
+        case protocol::subdoc_opcode::remove_doc:
+          remove_document = true;
+          break;
+        default:
+          if (has_flag(spec.flags, subdoc::path_flag_xattr)) {
+            if (!spec.path.empty() && spec.path.front() == '$') {
+              result.status = key_value_status_code::subdoc_xattr_cannot_modify_vattr;
+            } else {
+              result = mutate_path(doc.xattrs, spec);
+            }
+          } else if (!body) {
+            result.status = key_value_status_code::subdoc_doc_not_json;
+          } else {
+            result = mutate_path(body.value(), spec);
+            body_modified = true;
+          }
+          break;
+      }
+      if (result.status != key_value_status_code::success) {
+        // the document is left intact, and only the first failure is reported
+        value.clear();
+        value.push_back(static_cast<char>(index));
+        append_number(value, static_cast<std::uint16_t>(result.status));
+        return respond(req, key_value_status_code::subdoc_multi_path_failure, {}, value);
+      }
+      if (!result.value.empty()) {
+        value.push_back(static_cast<char>(index));
+        append_number(value, static_cast<std::uint16_t>(result.status));
+        append_number(value, static_cast<std::uint32_t>(result.value.size()));
+        value.append(result.value);
+      }
+    }
+
+    const auto cas = state_.next_cas();
+    if (remove_document) {
+      if (exists) {
+        erase_document(it);
+      }
+    } else {
+      if (body_modified) {
+        doc.value = couchbase::core::utils::json::generate(body.value());
+        doc.datatype = static_cast<std::uint8_t>(protocol::datatype::json);
+      }
+      if (expiry) {
+        doc.expiry = expiry.value();
+      }
+      if (user_flags) {
+        doc.flags = user_flags.value();
+      }
+      doc.cas = cas;
+      store_document(std::move(key), std::move(doc));
+    }
+    respond(req, key_value_status_code::success, mutation_token(req.partition), value, 0, cas);
+  }
+
+  asio::ip::tcp::socket socket_;
+  cluster_state& state_;
+  std::array<char, 16 * 1024> chunk_{};
+  std::string input_{};
+  std::string output_{};
+  std::string writing_buffer_{};
+  bool writing_{ false };
+  bool authenticated_{ false };
+  bool bucket_selected_{ false };
+  bool mutation_tokens_{ false };
+};
+
+/**
+ * HTTP/1.1 connection with keep-alive, that serves the management, query and search endpoints.
+ */
+class http_connection : public std::enable_shared_from_this<http_connection>
+{
+public:
+  http_connection(asio::ip::tcp::socket socket, cluster_state& state)
+    : socket_(std::move(socket))
+    , state_(state)
+  {
+  }
+
+  void start()
+  {
+    do_read();
+  }
+
+private:
+  void do_read()
+  {
+    asio::async_read_until(
+      socket_,
+      asio::dynamic_buffer(input_),
+      "\r\n\r\n",
+      [self = shared_from_this()](std::error_code ec, std::size_t headers_size) {
+        if (ec) {
+          return;
+        }
+        const auto body_size = self->content_length(headers_size);
+        if (self->input_.size() >= headers_size + body_size) {
+          return self->handle(headers_size, body_size);
+        }
+        asio::async_read(
+          self->socket_,
+          asio::dynamic_buffer(self->input_),
+          asio::transfer_exactly(headers_size + body_size - self->input_.size()),
+          [self, headers_size, body_size](std::error_code e, std::size_t /* bytes */) {
+            if (e) {
+              return;
+            }
+            self->handle(headers_size, body_size);
+          });
+      });
+  }
+
+  [[nodiscard]] auto content_length(std::size_t headers_size) const -> std::size_t
+  {
+    std::string headers = input_.substr(0, headers_size);
+    std::transform(headers.begin(), headers.end(), headers.begin(), [](unsigned char c) {
+      return static_cast<char>(std::tolower(c));
+    });
+    static const std::string header_name{ "\r\ncontent-length:" };
+    auto position = headers.find(header_name);
+    if (position == std::string::npos) {
+      return 0;
+    }
+    position += header_name.size();
+    while (position < headers.size() && headers[position] == ' ') {
+      ++position;
+    }
+    std::size_t length{ 0 };
+    std::from_chars(headers.data() + position, headers.data() + headers.size(), length);
+    return length;
+  }
+
+  void handle(std::size_t headers_size, std::size_t body_size)
+  {
+    ++state_.http_requests;
+    const std::string_view head{ input_.data(), headers_size };
+    const auto method = head.substr(0, head.find(' '));
+    auto path = head.substr(method.size() + 1);
+    path = path.substr(0, path.find(' '));
+    path = path.substr(0, path.find('?'));
+    const auto body = std::string_view{ input_ }.substr(headers_size, body_size);
+
+    auto [status, payload] = route(method, path, body);
+    input_.erase(0, headers_size + body_size);
+
+    output_ = fmt::format("HTTP/1.1 {}\r\n"
+                          "Content-Type: application/json\r\n"
+                          "Content-Length: {}\r\n"
+                          "Connection: keep-alive\r\n"
+                          "\r\n"
+                          "{}",
+                          status,
+                          payload.size(),
+                          payload);
+    asio::async_write(
+      socket_,
+      asio::buffer(output_),
+      [self = shared_from_this()](std::error_code ec, std::size_t /* bytes_transferred */) {
+        if (ec) {
+          return;
+        }
+        self->do_read();
+      });
+  }
+
+  auto route(std::string_view method, std::string_view path, std::string_view body)
+    -> std::pair<std::string_view, std::string>
+  {
+    static constexpr std::string_view ok{ "200 OK" };
+    static constexpr std::string_view not_found{ "404 Object Not Found" };
+    const auto bucket_path = fmt::format("/pools/default/b/{}", state_.options.bucket);
+
+    if (method == "GET") {
+      if (path == "/pools") {
+        return { ok,
+                 couchbase::core::utils::json::generate(tao::json::value{
+                   { "isAdminCreds", true },
+                   { "isEnterprise", true },
+                   { "implementationVersion", "7.6.0-0000-enterprise" },
+                 }) };
+      }
+      if (path == "/pools/default/nodeServices") {
+        return { ok, state_.cluster_configuration };
+      }
+      if (path == bucket_path) {
+        return { ok, state_.bucket_configuration };
+      }
+    } else if (method == "POST") {
+      if (path == "/query/service") {
+        return { ok, query_response(body) };
+      }
+      static constexpr std::string_view index_prefix{ "/index/" };
+      static constexpr std::string_view query_suffix{ "/query" };
+      if (auto index = path.rfind(index_prefix); index != std::string_view::npos &&
+                                                 path.size() > query_suffix.size() &&
+                                                 path.substr(path.size() - query_suffix.size()) ==
+                                                   query_suffix) {
+        auto index_name = path.substr(index + index_prefix.size());
+        index_name = index_name.substr(0, index_name.size() - query_suffix.size());
+        return { ok, search_response(index_name) };
+      }
+    }
+    return { not_found, R"({"errors":{"_":"not found"}})" };
+  }
+
+  auto query_response(std::string_view body) -> std::string
+  {
+    std::string client_context_id{};
+    if (auto request = parse_value(body); request && request->is_object()) {
+      if (const auto* id = request->find("client_context_id"); id != nullptr && id->is_string()) {
+        client_context_id = id->get_string();
+      }
+    }
+
+    tao::json::value rows = tao::json::empty_array;
+    for (std::size_t i = 0; i < state_.options.number_of_query_rows; ++i) {
+      rows.get_array().emplace_back(tao::json::value{
+        { "id", i },
+        { "name", fmt::format("row_{}", i) },
+      });
+    }
+    tao::json::value response{
+      { "requestID", fmt::format("{:08x}", ++state_.last_request_id) },
+      { "clientContextID", client_context_id },
+      { "status", "success" },
+      { "metrics",
+        {
+          { "elapsedTime", "1ms" },
+          { "executionTime", "1ms" },
+          { "resultCount", state_.options.number_of_query_rows },
+          { "resultSize", 0 },
+        } },
+    };
+    response["signature"] = tao::json::empty_object;
+    response["signature"]["*"] = "*";
+    response["results"] = std::move(rows);
+    return couchbase::core::utils::json::generate(response);
+  }
+
+  auto search_response(std::string_view index_name) -> std::string
+  {
+    tao::json::value hits = tao::json::empty_array;
+    for (std::size_t i = 0; i < state_.options.number_of_search_hits; ++i) {
+      hits.get_array().emplace_back(tao::json::value{
+        { "index", index_name },
+        { "id", fmt::format("doc_{}", i) },
+        { "score", 1.0 },
+      });
+    }
+    tao::json::value response{
+      { "status",
+        {
+          { "total", 1 },
+          { "failed", 0 },
+          { "successful", 1 },
+        } },
+      { "total_hits", state_.options.number_of_search_hits },
+      { "max_score", 1.0 },
+      { "took", 1'000'000 },
+    };
+    response["hits"] = std::move(hits);
+    return couchbase::core::utils::json::generate(response);
+  }
+
+  asio::ip::tcp::socket socket_;
+  cluster_state& state_;
+  std::string input_{};
+  std::string output_{};
+};
+} // namespace
+
+class mock_cluster_impl
+{
+public:
+  explicit mock_cluster_impl(mock_cluster_options options)
+    : state_{ std::move(options) }
+  {
+    state_.sequence_numbers.resize(std::max<std::size_t>(1, state_.options.number_of_vbuckets));
+    state_.cluster_configuration =
+      make_configuration(state_.options, kv_port(), http_port(), false);
+    state_.bucket_configuration = make_configuration(state_.options, kv_port(), http_port(), true);
+    do_accept_kv();
+    do_accept_http();
+    thread_ = std::thread([this]() {
+      if (state_.options.on_thread_start) {
+        state_.options.on_thread_start();
+      }
+      ctx_.run();
+    });
+  }
+
+  mock_cluster_impl(const mock_cluster_impl&) = delete;
+  mock_cluster_impl(mock_cluster_impl&&) = delete;
+  auto operator=(const mock_cluster_impl&) -> mock_cluster_impl& = delete;
+  auto operator=(mock_cluster_impl&&) -> mock_cluster_impl& = delete;
+
+  ~mock_cluster_impl()
+  {
+    ctx_.stop();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  [[nodiscard]] auto kv_port() const -> std::uint16_t
+  {
+    return kv_acceptor_.local_endpoint().port();
+  }
+
+  [[nodiscard]] auto http_port() const -> std::uint16_t
+  {
+    return http_acceptor_.local_endpoint().port();
+  }
+
+  [[nodiscard]] auto options() const -> const mock_cluster_options&
+  {
+    return state_.options;
+  }
+
+  [[nodiscard]] auto stats() const -> mock_cluster_stats
+  {
+    return {
+      state_.kv_connections.load(),
+      state_.kv_requests.load(),
+      state_.http_requests.load(),
+      state_.number_of_documents.load(),
+    };
+  }
+
+private:
+  void do_accept_kv()
+  {
+    kv_acceptor_.async_accept([this](std::error_code ec, asio::ip::tcp::socket socket) {
+      if (ec) {
+        return;
+      }
+      socket.set_option(asio::ip::tcp::no_delay{ true }, ec);
+      ++state_.kv_connections;
+      std::make_shared<kv_connection>(std::move(socket), state_)->start();
+      do_accept_kv();
+    });
+  }
+
+  void do_accept_http()
+  {
+    http_acceptor_.async_accept([this](std::error_code ec, asio::ip::tcp::socket socket) {
+      if (ec) {
+        return;
+      }
+      socket.set_option(asio::ip::tcp::no_delay{ true }, ec);
+      std::make_shared<http_connection>(std::move(socket), state_)->start();
+      do_accept_http();
+    });
+  }
+
+  cluster_state state_;
+  asio::io_context ctx_{ 1 };
+  asio::ip::tcp::acceptor kv_acceptor_{ ctx_, { asio::ip::address_v4::loopback(), 0 } };
+  asio::ip::tcp::acceptor http_acceptor_{ ctx_, { asio::ip::address_v4::loopback(), 0 } };
+  std::thread thread_{};
+};
+
+mock_cluster::mock_cluster(mock_cluster_options options)
+  : impl_{ std::make_shared<mock_cluster_impl>(std::move(options)) }
+{
+}
+
+mock_cluster::~mock_cluster() = default;
+
+auto
+mock_cluster::connection_string() const -> std::string
+{
+  return fmt::format("couchbase://{}:{}", loopback_address, impl_->kv_port());
+}
+
+auto
+mock_cluster::build_options() const -> couchbase::cluster_options
+{
+  return couchbase::cluster_options(couchbase::password_authenticator::ldap_compatible(
+    impl_->options().username, impl_->options().password));
+}
+
+auto
+mock_cluster::bucket_name() const -> const std::string&
+{
+  return impl_->options().bucket;
+}
+
+auto
+mock_cluster::kv_port() const -> std::uint16_t
+{
+  return impl_->kv_port();
+}
+
+auto
+mock_cluster::http_port() const -> std::uint16_t
+{
+  return impl_->http_port();
+}
+
+auto
+mock_cluster::stats() const -> mock_cluster_stats
+{
+  return impl_->stats();
+}
+} // namespace test::utils
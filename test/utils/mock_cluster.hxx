@@ -0,0 +1,83 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/cluster_options.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace test::utils
+{
+struct mock_cluster_options {
+  std::string bucket{ "default" };
+  std::string username{ "Administrator" };
+  std::string password{ "password" };
+  std::size_t number_of_vbuckets{ 1024 };
+  // every query returns this number of rows, and every search this number of hits
+  std::size_t number_of_query_rows{ 1 };
+  std::size_t number_of_search_hits{ 1 };
+  // invoked on the thread of the mock before it starts serving the connections
+  std::function<void()> on_thread_start{};
+};
+
+struct mock_cluster_stats {
+  std::uint64_t kv_connections{ 0 };
+  std::uint64_t kv_requests{ 0 };
+  std::uint64_t http_requests{ 0 };
+  std::size_t number_of_documents{ 0 };
+};
+
+class mock_cluster_impl;
+
+/**
+ * Single-node cluster that runs in the process of the test, and serves its services on the
+ * loopback interface, so that the whole stack of the SDK could be exercised without a server.
+ *
+ * The KV port speaks enough of the MCBP to bootstrap the sessions (HELLO, SASL PLAIN,
+ * SELECT_BUCKET, GET_CLUSTER_CONFIG) and to execute GET, UPSERT, INSERT, REPLACE, REMOVE and
+ * sub-document operations against the documents kept in memory. The HTTP port serves the
+ * configuration, and answers the query and search requests with generated rows and hits.
+ *
+ * Only the PLAIN mechanism is supported, so the SDK has to use an LDAP-compatible authenticator,
+ * see build_options(). The mock does not enforce expiry, durability and document locks.
+ */
+class mock_cluster
+{
+public:
+  explicit mock_cluster(mock_cluster_options options = {});
+  mock_cluster(const mock_cluster&) = delete;
+  mock_cluster(mock_cluster&&) = delete;
+  auto operator=(const mock_cluster&) -> mock_cluster& = delete;
+  auto operator=(mock_cluster&&) -> mock_cluster& = delete;
+  ~mock_cluster();
+
+  [[nodiscard]] auto connection_string() const -> std::string;
+  [[nodiscard]] auto build_options() const -> couchbase::cluster_options;
+  [[nodiscard]] auto bucket_name() const -> const std::string&;
+  [[nodiscard]] auto kv_port() const -> std::uint16_t;
+  [[nodiscard]] auto http_port() const -> std::uint16_t;
+  [[nodiscard]] auto stats() const -> mock_cluster_stats;
+
+private:
+  std::shared_ptr<mock_cluster_impl> impl_;
+};
+} // namespace test::utils
@@ -249,6 +249,11 @@ add_options(CLI::App* app, network_options& options)
                  "Period to wait before calling HTTP connection idle.")
     ->default_val(defaults.network.idle_http_connection_timeout)
     ->type_name("DURATION");
+  group
+    ->add_option("--io-threads",
+                 options.io_threads,
+                 "Number of threads serving network connections to the cluster.")
+    ->default_val(defaults.network.io_threads);
 }
 
 void
@@ -506,6 +511,7 @@ apply_options(couchbase::cluster_options& options, const network_options& networ
   options.network().tcp_keep_alive_interval(network.tcp_keep_alive_interval);
   options.network().config_poll_interval(network.config_poll_interval);
   options.network().idle_http_connection_timeout(network.idle_http_connection_timeout);
+  options.network().io_threads(network.io_threads);
 }
 
 void
@@ -126,6 +126,7 @@ struct network_options {
   std::chrono::milliseconds tcp_keep_alive_interval{};
   std::chrono::milliseconds config_poll_interval{};
   std::chrono::milliseconds idle_http_connection_timeout{};
+  std::size_t io_threads{};
 };
 
 struct transactions_options {